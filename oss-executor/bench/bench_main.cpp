@@ -0,0 +1,47 @@
+#include "harness.hpp"
+#include "utils/logger.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// oss_bench [--warmup N] [--reps N] [--filter SUBSTR] [--json PATH|-]
+//           [--baseline PATH] [--suite memory|lua|ui|crypto]...
+int main(int argc, char** argv) {
+    oss::bench::Options options;
+    std::vector<std::string> suites;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_val = i + 1 < argc;
+        if (arg == "--warmup" && has_val)        options.warmup = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--reps" && has_val)     options.repetitions = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--filter" && has_val)   options.filter = argv[++i];
+        else if (arg == "--json" && has_val)     options.json_path = argv[++i];
+        else if (arg == "--baseline" && has_val) options.baseline_path = argv[++i];
+        else if (arg == "--suite" && has_val)    suites.emplace_back(argv[++i]);
+        else {
+            std::cerr << "usage: oss_bench [--warmup N] [--reps N] [--filter SUBSTR]"
+                         " [--json PATH|-] [--baseline PATH]"
+                         " [--suite memory|lua|ui|crypto]..." << std::endl;
+            return 2;
+        }
+    }
+
+    // Keep the executor's own logging out of the timings
+    spdlog::set_level(spdlog::level::warn);
+
+    auto selected = [&](const char* suite) {
+        return suites.empty() || std::find(suites.begin(), suites.end(), suite) != suites.end();
+    };
+
+    oss::bench::Harness harness(options);
+    if (selected("memory")) oss::bench::run_memory_suite(harness);
+    if (selected("lua"))    oss::bench::run_lua_suite(harness);
+    if (selected("ui"))     oss::bench::run_ui_suite(harness);
+    if (selected("crypto")) oss::bench::run_crypto_suite(harness);
+    return harness.finish();
+}
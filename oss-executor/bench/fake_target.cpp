@@ -0,0 +1,204 @@
+// oss_fake_target — a stand-in game client for end-to-end injection benchmarks.
+//
+// Links Luau.VM/Luau.Compiler and exports them (-rdynamic), so the payload's
+// dlsym/ELF resolution finds the same hook points it hooks in the real client:
+// lua_resume drives every frame, luau_load/luau_compile/lua_newthread are live.
+// Its heap is a configurable set of anonymous regions with Roblox marker strings
+// planted in one of them, so locate_luau_vm() walks a realistic layout.
+//
+// Point the executor at it with "injection.target_process": "oss_fake_target".
+
+#include "lua.h"
+#include "lualib.h"
+#include "luacode.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+struct Options {
+    int    threads       = 32;    // worker coroutines resumed per frame
+    int    hz            = 60;    // frame rate of the scheduler loop
+    size_t heap_mb       = 1024;  // total reserved heap, split across regions
+    int    regions       = 8;
+    size_t fill_mb       = 16;    // bytes actually touched per region
+    int    marker_region = -1;    // -1 = last region
+};
+
+// Same strings injection.cpp's PRIMARY_MARKERS / SECONDARY_MARKERS look for
+const char* const MARKERS[] = {
+    "rbxasset://textures/ui/", "CoreGui", "LocalScript", "ModuleScript",
+    "RenderStepped", "GetService", "HumanoidRootPart", "PlayerAdded",
+    "StarterGui", "ReplicatedStorage", "TweenService", "UserInputService",
+    "Instance", "workspace", "Enum", "Vector3", "CFrame", "game", "Players", "Lighting",
+};
+
+const char WORKER_SCRIPT[] = R"(
+local id = ...
+local pos = { x = 0, y = 0, z = 0 }
+local frame = 0
+local service = game and workspace
+while service do
+    frame += 1
+    pos.x = math.sin(frame * 0.01 + id) * 10
+    pos.z = math.cos(frame * 0.01 + id) * 10
+    coroutine.yield()
+end
+)";
+
+std::atomic<bool> g_running{true};
+
+void on_signal(int) { g_running = false; }
+
+struct Region {
+    uint8_t* base = nullptr;
+    size_t   size = 0;
+};
+
+// Each region is followed by a PROT_NONE guard page so /proc/pid/maps keeps
+// them as separate entries instead of merging adjacent anonymous mappings.
+std::vector<Region> build_heap(const Options& opt) {
+    std::vector<Region> out;
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t per  = (opt.heap_mb << 20) / static_cast<size_t>(opt.regions);
+    per = (per + page - 1) & ~(page - 1);
+    size_t fill = std::min(per, opt.fill_mb << 20);
+
+    uint64_t x = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < opt.regions; i++) {
+        void* p = mmap(nullptr, per + page, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (p == MAP_FAILED) {
+            std::perror("mmap");
+            std::exit(1);
+        }
+        auto* base = static_cast<uint8_t*>(p);
+        mprotect(base + per, page, PROT_NONE);
+
+        auto* words = reinterpret_cast<uint64_t*>(base);
+        for (size_t w = 0; w < fill / sizeof(uint64_t); w++) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            words[w] = x;
+        }
+        out.push_back({base, per});
+    }
+
+    Region& r = out[static_cast<size_t>(opt.marker_region)];
+    size_t window = std::min(r.size, static_cast<size_t>(1) << 20);
+    size_t stride = window / (sizeof(MARKERS) / sizeof(MARKERS[0]) + 1);
+    size_t off = stride;
+    for (const char* m : MARKERS) {
+        std::memcpy(r.base + off, m, std::strlen(m) + 1);
+        off += stride;
+    }
+    return out;
+}
+
+lua_State* spawn_worker(lua_State* L, const char* bytecode, size_t len, int id) {
+    lua_State* th = lua_newthread(L);
+    luaL_sandboxthread(th);
+    if (luau_load(th, "=worker", bytecode, len, 0) != 0) {
+        std::fprintf(stderr, "oss_fake_target: load failed: %s\n", lua_tostring(th, -1));
+        std::exit(1);
+    }
+    lua_pushinteger(th, id);
+    // First resume passes the id; every later one resumes at coroutine.yield
+    lua_resume(th, L, 1);
+    return th;
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const char* v = argv[++i];
+        if (arg == "--threads")            opt.threads = std::max(1, std::atoi(v));
+        else if (arg == "--hz")            opt.hz = std::max(1, std::atoi(v));
+        else if (arg == "--heap-mb")       opt.heap_mb = std::strtoull(v, nullptr, 10);
+        else if (arg == "--regions")       opt.regions = std::max(1, std::atoi(v));
+        else if (arg == "--fill-mb")       opt.fill_mb = std::strtoull(v, nullptr, 10);
+        else if (arg == "--marker-region") opt.marker_region = std::atoi(v);
+        else return false;
+    }
+    if (opt.marker_region < 0 || opt.marker_region >= opt.regions) opt.marker_region = opt.regions - 1;
+    // locate_luau_vm() skips regions of 2GB and up
+    if (opt.heap_mb / static_cast<size_t>(opt.regions) >= 2048) {
+        std::fprintf(stderr, "oss_fake_target: regions must stay below 2048 MB each\n");
+        return false;
+    }
+    return opt.heap_mb > 0;
+}
+
+} // namespace
+
+// oss_fake_target [--threads N] [--hz N] [--heap-mb N] [--regions N]
+//                 [--fill-mb N] [--marker-region I]
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) {
+        std::fprintf(stderr, "usage: oss_fake_target [--threads N] [--hz N] [--heap-mb N]"
+                             " [--regions N] [--fill-mb N] [--marker-region I]\n");
+        return 2;
+    }
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    auto heap = build_heap(opt);
+
+    lua_State* L = luaL_newstate();
+    luaL_openlibs(L);
+    lua_newtable(L);
+    lua_setglobal(L, "game");
+    lua_newtable(L);
+    lua_setglobal(L, "workspace");
+    luaL_sandbox(L);
+
+    size_t bc_len = 0;
+    char* bc = luau_compile(WORKER_SCRIPT, sizeof(WORKER_SCRIPT) - 1, nullptr, &bc_len);
+    // Workers stay referenced from the main stack, like the client's thread table
+    lua_checkstack(L, opt.threads);
+    std::vector<lua_State*> workers;
+    for (int i = 0; i < opt.threads; i++) workers.push_back(spawn_worker(L, bc, bc_len, i));
+    std::free(bc);
+
+    std::printf("{\"pid\":%d,\"threads\":%d,\"hz\":%d,\"heap_mb\":%zu,\"regions\":%d,"
+                "\"fill_mb\":%zu,\"marker_region\":%d,\"marker_base\":\"%p\"}\n",
+                getpid(), opt.threads, opt.hz, opt.heap_mb, opt.regions, opt.fill_mb,
+                opt.marker_region, static_cast<void*>(heap[static_cast<size_t>(opt.marker_region)].base));
+    std::fflush(stdout);
+
+    // Scheduler: one resume per worker per frame, from the main state — the
+    // payload's resume detour captures `from` and drains its queue there.
+    auto frame = std::chrono::nanoseconds(1'000'000'000 / opt.hz);
+    auto next  = std::chrono::steady_clock::now();
+    while (g_running) {
+        for (auto*& th : workers) {
+            if (!th) continue;
+            if (lua_resume(th, L, 0) != LUA_YIELD) {
+                std::fprintf(stderr, "oss_fake_target: worker died: %s\n",
+                             lua_gettop(th) > 0 ? lua_tostring(th, -1) : "?");
+                lua_settop(th, 0);
+                th = nullptr;
+            }
+        }
+        lua_gc(L, LUA_GCSTEP, 0);
+        next += frame;
+        std::this_thread::sleep_until(next);
+    }
+
+    lua_close(L);
+    for (auto& r : heap) munmap(r.base, r.size + static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+    return 0;
+}
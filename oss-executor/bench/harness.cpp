@@ -0,0 +1,147 @@
+#include "harness.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/utsname.h>
+#include <unistd.h>
+
+namespace oss::bench {
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+bool Harness::wants(const std::string& name) const {
+    return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+}
+
+void Harness::run(const std::string& name, const std::function<size_t()>& body) {
+    if (!wants(name)) return;
+
+    CaseResult result;
+    result.name = name;
+    for (int i = 0; i < options_.warmup; i++) body();
+
+    result.samples_ms.reserve(static_cast<size_t>(options_.repetitions));
+    for (int i = 0; i < options_.repetitions; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        result.items = body();
+        auto t1 = std::chrono::steady_clock::now();
+        result.samples_ms.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+    }
+    std::fprintf(stderr, "  %-36s done\n", name.c_str());
+    results_.push_back(std::move(result));
+}
+
+void Harness::skip(const std::string& name, const std::string& reason) {
+    if (!wants(name)) return;
+    CaseResult result;
+    result.name    = name;
+    result.skipped = reason;
+    std::fprintf(stderr, "  %-36s skipped: %s\n", name.c_str(), reason.c_str());
+    results_.push_back(std::move(result));
+}
+
+nlohmann::json Harness::report() const {
+    nlohmann::json cases = nlohmann::json::array();
+    for (const auto& r : results_) {
+        if (!r.skipped.empty()) {
+            cases.push_back({{"name", r.name}, {"skipped", r.skipped}});
+            continue;
+        }
+        std::vector<double> sorted = r.samples_ms;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0;
+        for (double s : sorted) total += s;
+        double mean = total / static_cast<double>(sorted.size());
+        nlohmann::json c = {
+            {"name", r.name},
+            {"repetitions", sorted.size()},
+            {"mean_ms", mean},
+            {"min_ms", sorted.front()},
+            {"p50_ms", percentile(sorted, 0.50)},
+            {"p90_ms", percentile(sorted, 0.90)},
+            {"p99_ms", percentile(sorted, 0.99)},
+            {"max_ms", sorted.back()},
+        };
+        if (r.items > 0) {
+            c["items"] = r.items;
+            double p50 = percentile(sorted, 0.50);
+            if (p50 > 0) c["items_per_sec"] = static_cast<double>(r.items) * 1000.0 / p50;
+        }
+        cases.push_back(std::move(c));
+    }
+
+    struct utsname un{};
+    uname(&un);
+    char host[256] = {};
+    gethostname(host, sizeof(host) - 1);
+    return {
+        {"version", 1},
+        {"host", host},
+        {"kernel", un.release},
+        {"cpus", sysconf(_SC_NPROCESSORS_ONLN)},
+        {"warmup", options_.warmup},
+        {"repetitions", options_.repetitions},
+        {"cases", std::move(cases)},
+    };
+}
+
+int Harness::finish() const {
+    nlohmann::json doc = report();
+
+    nlohmann::json baseline;
+    if (!options_.baseline_path.empty()) {
+        std::ifstream in(options_.baseline_path);
+        baseline = nlohmann::json::parse(in, nullptr, false);
+        if (baseline.is_discarded()) {
+            std::cerr << "oss_bench: cannot parse baseline " << options_.baseline_path << std::endl;
+            baseline = nullptr;
+        }
+    }
+    auto baseline_p50 = [&](const std::string& name) -> double {
+        if (!baseline.is_object() || !baseline.contains("cases")) return 0.0;
+        for (const auto& c : baseline["cases"]) {
+            if (c.value("name", "") == name) return c.value("p50_ms", 0.0);
+        }
+        return 0.0;
+    };
+
+    std::fprintf(stderr, "\n%-36s %10s %10s %10s %14s\n",
+                 "case", "p50 ms", "p99 ms", "max ms", "items/s");
+    for (const auto& c : doc["cases"]) {
+        std::string name = c["name"];
+        if (c.contains("skipped")) {
+            std::fprintf(stderr, "%-36s %10s\n", name.c_str(), "skipped");
+            continue;
+        }
+        double p50 = c["p50_ms"];
+        std::fprintf(stderr, "%-36s %10.3f %10.3f %10.3f %14.0f", name.c_str(), p50,
+                     c["p99_ms"].get<double>(), c["max_ms"].get<double>(),
+                     c.value("items_per_sec", 0.0));
+        if (double base = baseline_p50(name); base > 0)
+            std::fprintf(stderr, "  %+6.1f%%", (p50 - base) * 100.0 / base);
+        std::fputc('\n', stderr);
+    }
+
+    if (options_.json_path.empty()) return 0;
+    if (options_.json_path == "-") {
+        std::cout << doc.dump(2) << std::endl;
+        return 0;
+    }
+    std::ofstream out(options_.json_path, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "oss_bench: cannot write " << options_.json_path << std::endl;
+        return 1;
+    }
+    out << doc.dump(2) << '\n';
+    return 0;
+}
+
+} // namespace oss::bench
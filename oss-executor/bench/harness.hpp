@@ -0,0 +1,55 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace oss::bench {
+
+struct Options {
+    int         warmup      = 3;
+    int         repetitions = 20;
+    std::string filter;         // substring match on case names; empty = all
+    std::string json_path;      // "-" = stdout
+    std::string baseline_path;  // earlier JSON report to diff p50 against
+};
+
+// Runs each case `warmup` times untimed, then `repetitions` timed runs.
+// A case body returns the number of items it processed per run (0 if that
+// is meaningless) so the report can include throughput.
+class Harness {
+public:
+    explicit Harness(Options options) : options_(std::move(options)) {}
+
+    bool wants(const std::string& name) const;
+    void run(const std::string& name, const std::function<size_t()>& body);
+    void skip(const std::string& name, const std::string& reason);
+
+    nlohmann::json report() const;
+    // Prints a table to stderr and writes the JSON report; returns exit code
+    int  finish() const;
+
+private:
+    struct CaseResult {
+        std::string         name;
+        std::vector<double> samples_ms;
+        size_t              items = 0;
+        std::string         skipped;
+    };
+
+    Options                 options_;
+    std::vector<CaseResult> results_;
+};
+
+// Suites; each registers its cases on the harness
+void run_memory_suite(Harness& h);
+void run_lua_suite(Harness& h);
+void run_ui_suite(Harness& h);
+void run_crypto_suite(Harness& h);
+
+// Shared LuaEngine with the script environment installed; false if init fails
+bool ensure_lua();
+
+} // namespace oss::bench
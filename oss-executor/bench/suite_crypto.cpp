@@ -0,0 +1,97 @@
+#include "harness.hpp"
+#include "utils/base64.hpp"
+#include "utils/crypto.hpp"
+
+#include <string>
+#include <vector>
+
+namespace oss::bench {
+
+void run_crypto_suite(Harness& h) {
+    constexpr size_t SIZE = 4 << 20;
+    std::string data(SIZE, '\0');
+    uint32_t x = 2463534242u;
+    for (auto& c : data) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        c = static_cast<char>(x);
+    }
+
+    // Into preallocated output, once per kernel this CPU supports
+    const std::string encoded = Base64::encode(data);
+    std::string          enc_out(encoded.size(), '\0');
+    std::vector<uint8_t> dec_out(Base64::decoded_size(encoded));
+    const Base64::Kernel best = Base64::kernel();
+    for (auto k : {Base64::Kernel::Scalar, Base64::Kernel::SSSE3, Base64::Kernel::AVX2}) {
+        std::string suffix = std::string("_") + Base64::kernel_name(k);
+        if (k > best) {
+            h.skip("crypto.base64_encode_4m" + suffix, "not supported by this CPU");
+            h.skip("crypto.base64_decode_4m" + suffix, "not supported by this CPU");
+            continue;
+        }
+        Base64::set_kernel(k);
+        h.run("crypto.base64_encode_4m" + suffix, [&] {
+            Base64::encode(data, enc_out.data());
+            return SIZE;
+        });
+        h.run("crypto.base64_decode_4m" + suffix, [&] {
+            Base64::decode(encoded, dec_out.data());
+            return SIZE;
+        });
+    }
+    Base64::set_kernel(best);
+
+    // Allocating wrappers, as scripts and the crypto layer call them
+    h.run("crypto.base64_encode_4m", [&] {
+        Crypto::base64_encode(data);
+        return SIZE;
+    });
+
+    h.run("crypto.base64_decode_4m", [&] {
+        Crypto::base64_decode(encoded);
+        return SIZE;
+    });
+
+    h.run("crypto.sha256_4m", [&] {
+        Crypto::sha256(data);
+        return SIZE;
+    });
+
+    const std::string small(64, 'a');
+    h.run("crypto.sha256_64b_x10k", [&] {
+        for (int i = 0; i < 10000; i++) Crypto::sha256(small);
+        return size_t{10000};
+    });
+
+    // 64 KB updates, the way hash_file and crypt.hasher feed it
+    h.run("crypto.sha256_stream_4m", [&] {
+        Hasher hasher(HashAlgorithm::SHA256);
+        for (size_t off = 0; off < SIZE; off += 64 << 10)
+            hasher.update(ByteSpan(data.data() + off, 64 << 10));
+        hasher.final_hex();
+        return SIZE;
+    });
+
+    const auto key = Crypto::generate_key();
+    h.run("crypto.hmac_sha256_64b_x10k", [&] {
+        for (int i = 0; i < 10000; i++) Crypto::hmac(small, key);
+        return size_t{10000};
+    });
+
+    h.run("crypto.aes256_encrypt_4m", [&] {
+        Crypto::encrypt_aes256(data, key);
+        return SIZE;
+    });
+
+    const auto sealed = Crypto::encrypt_aes256(data, key);
+    h.run("crypto.aes256_decrypt_4m", [&] {
+        Crypto::decrypt_aes256(sealed, key);
+        return SIZE;
+    });
+
+    h.run("crypto.hex_encode_4m", [&] {
+        Crypto::bytes_to_hex(data);
+        return SIZE;
+    });
+}
+
+} // namespace oss::bench
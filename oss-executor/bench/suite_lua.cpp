@@ -0,0 +1,125 @@
+#include "harness.hpp"
+#include "core/lua_engine.hpp"
+#include "api/environment.hpp"
+
+#include <string>
+
+namespace oss::bench {
+
+// ~1k lines of typical script code for the compiler
+static std::string compile_corpus() {
+    std::string src;
+    for (int i = 0; i < 100; i++) {
+        std::string n = std::to_string(i);
+        src += "local function f" + n + "(a, b)\n"
+               "    local t = {}\n"
+               "    for i = 1, a do\n"
+               "        t[#t + 1] = string.format('%d:%s', i, tostring(b))\n"
+               "    end\n"
+               "    if #t > 10 then return table.concat(t, ',') end\n"
+               "    return nil\n"
+               "end\n"
+               "_G.r" + n + " = f" + n + "(" + n + ", 'x')\n\n";
+    }
+    return src;
+}
+
+bool ensure_lua() {
+    auto& lua = LuaEngine::instance();
+    if (lua.is_ready()) return true;
+    if (!lua.init()) return false;
+    Environment::instance().setup(lua);
+    return true;
+}
+
+void run_lua_suite(Harness& h) {
+    if (!ensure_lua()) {
+        h.skip("lua.*", "Lua engine failed to initialize");
+        return;
+    }
+    auto& lua = LuaEngine::instance();
+
+    const std::string corpus = compile_corpus();
+    h.run("lua.compile_1k_lines", [&] {
+        std::string error;
+        LuaEngine::compile_source(corpus, error);
+        return size_t{1000};
+    });
+
+    const std::string loop = "local x = 0 for i = 1, 100000 do x = x + i % 7 end";
+    h.run("lua.execute_source", [&] {
+        lua.execute(loop, "=bench");
+        return size_t{100000};
+    });
+
+    std::string error;
+    const std::string bytecode = LuaEngine::compile_source(loop, error);
+    h.run("lua.execute_bytecode", [&] {
+        lua.execute_bytecode(bytecode, "=bench");
+        return size_t{100000};
+    });
+
+    constexpr int TASKS = 10000;
+    const std::string spawn = "for i = 1, " + std::to_string(TASKS) +
+                              " do task.defer(function() end) end";
+    h.run("lua.task_defer_throughput", [&] {
+        lua.execute(spawn, "=bench");
+        for (int guard = 0; guard < 1000 && lua.pending_task_count() > 0; guard++) lua.tick();
+        return static_cast<size_t>(TASKS);
+    });
+
+    const std::string math =
+        "local a, acc = Vector3.new(1, 2, 3), Vector3.zero\n"
+        "for i = 1, 10000 do acc = (acc + a * 0.5):Lerp(a, 0.1) end\n"
+        "local c = CFrame.new(1, 2, 3)\n"
+        "for i = 1, 10000 do c = c * CFrame.new(0, 0, 1) end";
+    h.run("lua.datatype_math", [&] {
+        lua.execute(math, "=bench");
+        return size_t{20000};
+    });
+
+    const std::string drawing =
+        "local d = Drawing.new('Square')\n"
+        "for i = 1, 10000 do\n"
+        "    d.Transparency = (i % 10) / 10\n"
+        "    d.Position = Vector2.new(i, i)\n"
+        "    local _ = d.Transparency, d.Position\n"
+        "end\n"
+        "d:Remove()";
+    h.run("lua.drawing_get_set", [&] {
+        lua.execute(drawing, "=bench");
+        return size_t{40000};
+    });
+
+    // Four CPU-bound scripts back to back on the main VM, then as actors
+    const std::string work = "local x = 0 for i = 1, 3000000 do x = x + i % 7 end";
+    h.run("lua.cpu_scripts_serial_4", [&] {
+        for (int i = 0; i < 4; i++) lua.execute(work, "=bench");
+        return size_t{4};
+    });
+
+    const std::string actors =
+        "local hs = {}\n"
+        "for i = 1, 4 do hs[i] = actor.spawn([[" + work + " actor.send(x)]]) end\n"
+        "for _, h in hs do repeat until (h:receive()) end";
+    h.run("lua.cpu_scripts_actors_4", [&] {
+        lua.execute(actors, "=bench");
+        return size_t{4};
+    });
+
+    const std::string ping =
+        "local echo = actor.spawn([[actor.onmessage(function(t) actor.send(t) end)]])\n"
+        "local msg = { id = 1, name = 'ping', pos = { 1, 2, 3 } }\n"
+        "for i = 1, 1000 do\n"
+        "    echo:send(msg)\n"
+        "    repeat until (echo:receive())\n"
+        "end\n"
+        "echo:kill()";
+    h.run("lua.actor_roundtrip_1k", [&] {
+        lua.execute(ping, "=bench");
+        return size_t{1000};
+    });
+    // Left running: the ui suite renders its overlay scene on this engine
+}
+
+} // namespace oss::bench
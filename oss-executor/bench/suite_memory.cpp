@@ -0,0 +1,148 @@
+#include "harness.hpp"
+#include "core/hooks.hpp"
+#include "core/memory.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace oss::bench {
+
+static constexpr char    PLANTED_IDA[] = "48 8B 05 ?? ?? ?? ?? 48 85 C0 74 ?? 48 8B 40 18";
+static constexpr uint8_t PLANTED_BYTES[] = {
+    0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0, 0x74, 0x09, 0x48, 0x8B, 0x40, 0x18,
+};
+static constexpr char    MARKER[] = "OSS_BENCH_MARKER_v1";
+static constexpr int     PLANTS   = 8;
+
+// Forked child holding a filled heap with the pattern and marker planted at
+// known offsets, the last one near the end so first-match scans cover it all.
+struct ScanTarget {
+    pid_t     pid  = -1;
+    uintptr_t base = 0;
+    size_t    size = 0;
+    int       hold_fd = -1;  // child exits when this closes
+
+    bool spawn(size_t bytes) {
+        int ready[2], hold[2];
+        if (pipe(ready) != 0) return false;
+        if (pipe(hold) != 0) { close(ready[0]); close(ready[1]); return false; }
+
+        pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0) {
+            close(ready[0]);
+            close(hold[1]);
+            void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mem == MAP_FAILED) _exit(1);
+            auto* p = static_cast<uint8_t*>(mem);
+            uint64_t x = 0x9E3779B97F4A7C15ull;
+            for (size_t i = 0; i + 8 <= bytes; i += 8) {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                std::memcpy(p + i, &x, 8);
+            }
+            for (int k = 1; k <= PLANTS; k++) {
+                size_t off = bytes / PLANTS * k - 4096;
+                std::memcpy(p + off, PLANTED_BYTES, sizeof(PLANTED_BYTES));
+                std::memcpy(p + off + 64, MARKER, sizeof(MARKER) - 1);
+            }
+            uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+            if (write(ready[1], &addr, sizeof(addr)) != sizeof(addr)) _exit(1);
+            char c;
+            while (read(hold[0], &c, 1) > 0) {}
+            _exit(0);
+        }
+
+        close(ready[1]);
+        close(hold[0]);
+        hold_fd = hold[1];
+        size = bytes;
+        bool ok = read(ready[0], &base, sizeof(base)) == sizeof(base);
+        close(ready[0]);
+        return ok;
+    }
+
+    ~ScanTarget() {
+        if (hold_fd >= 0) close(hold_fd);
+        if (pid > 0) {
+            kill(pid, SIGKILL);
+            waitpid(pid, nullptr, 0);
+        }
+    }
+};
+
+void run_memory_suite(Harness& h) {
+    const char* env = std::getenv("OSS_BENCH_HEAP_MB");
+    size_t heap_mb = env ? std::strtoull(env, nullptr, 10) : 256;
+    if (heap_mb < 1) heap_mb = 1;
+
+    ScanTarget target;
+    if (!target.spawn(heap_mb << 20)) {
+        h.skip("memory.*", "could not spawn scan target");
+        return;
+    }
+
+    Memory mem(target.pid);
+    if (!mem.attach(target.pid)) {
+        h.skip("memory.*", "cannot open target memory (ptrace_scope?)");
+        return;
+    }
+
+    std::vector<MemoryRegion> heap;
+    for (const auto& r : mem.get_regions(true)) {
+        if (r.start <= target.base && target.base < r.end) heap.push_back(r);
+    }
+
+    h.run("memory.maps_parse", [&] { return mem.get_regions(true).size(); });
+
+    AOBPattern pattern = AOBPattern::from_ida(PLANTED_IDA);
+    h.run("memory.aob_scan_first", [&] {
+        auto hit = mem.aob_scan(pattern, target.base, target.size);
+        return hit ? static_cast<size_t>(*hit - target.base) : size_t{0};
+    });
+    h.run("memory.aob_scan_all", [&] {
+        mem.aob_scan_all(pattern, target.base, target.size);
+        return target.size;
+    });
+    h.run("memory.scan_string", [&] {
+        mem.scan_string(heap, MARKER);
+        return target.size;
+    });
+
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> values(4096);
+    std::vector<Memory::BatchReadEntry> batch;
+    batch.reserve(values.size());
+    for (auto& v : values) {
+        uintptr_t addr = target.base + (rng() % (target.size / 8)) * 8;
+        batch.push_back({addr, &v, sizeof(v)});
+    }
+    h.run("memory.batch_read_4k", [&] {
+        mem.batch_read(batch);
+        return batch.size();
+    });
+
+    // Cold: maps + ELF tables pulled from the target on every iteration
+    auto& hooks = HookManager::instance();
+    const std::vector<std::string> libc_syms = {
+        "malloc", "free", "calloc", "realloc", "mmap", "dlopen",
+        "pthread_mutex_lock", "pthread_mutex_unlock",
+    };
+    h.run("memory.remote_symbols_libc_cold", [&] {
+        hooks.forget_remote_modules(target.pid);
+        return hooks.find_remote_symbols(target.pid, "libc.so", libc_syms).size();
+    });
+    h.run("memory.remote_symbols_libc_cached", [&] {
+        return hooks.find_remote_symbols(target.pid, "libc.so", libc_syms).size();
+    });
+    hooks.forget_remote_modules(target.pid);
+}
+
+} // namespace oss::bench
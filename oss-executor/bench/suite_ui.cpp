@@ -0,0 +1,140 @@
+#include "harness.hpp"
+#include "core/lua_engine.hpp"
+#include "ui/console.hpp"
+#include "ui/editor.hpp"
+#include "ui/overlay.hpp"
+
+#include <gtk/gtk.h>
+#include <string>
+#include <vector>
+
+namespace oss::bench {
+
+static constexpr int FRAME_W = 1920;
+static constexpr int FRAME_H = 1080;
+
+static const char* OVERLAY_SCENE = R"lua(
+for i = 1, 400 do
+    local s = Drawing.new('Square')
+    s.Position = Vector2.new((i * 37) % 1800, (i * 53) % 1000)
+    s.Size = Vector2.new(40, 24)
+    s.Filled = i % 2 == 0
+    s.Visible = true
+    local l = Drawing.new('Line')
+    l.From = Vector2.new((i * 13) % 1900, (i * 7) % 1060)
+    l.To = Vector2.new((i * 29) % 1900, (i * 31) % 1060)
+    l.Visible = true
+end
+for i = 1, 150 do
+    local t = Drawing.new('Text')
+    t.Text = 'Player' .. i .. ' [' .. (i * 3) .. 'm]'
+    t.Position = Vector2.new((i * 71) % 1800, (i * 41) % 1040)
+    t.Size = 14
+    t.Visible = true
+    local c = Drawing.new('Circle')
+    c.Position = Vector2.new((i * 19) % 1900, (i * 23) % 1060)
+    c.Radius = 12
+    c.Visible = true
+end
+)lua";
+
+static std::string editor_corpus() {
+    std::string src;
+    for (int i = 0; i < 250; i++) {
+        std::string n = std::to_string(i);
+        src += "-- handler " + n + "\n"
+               "local function on_" + n + "(player, value)\n"
+               "    if value > 0x1F and player.Name ~= \"guest\" then\n"
+               "        return string.rep('x', " + n + ") .. tostring(value * 1.5e3)\n"
+               "    end\n"
+               "    return nil\n"
+               "end\n\n";
+    }
+    return src;
+}
+
+void run_ui_suite(Harness& h) {
+    auto& lua = LuaEngine::instance();
+    if (h.wants("ui.overlay_render_1080p")) {
+        if (!ensure_lua()) {
+            h.skip("ui.overlay_render_1080p", "Lua engine failed to initialize");
+        } else {
+            auto& overlay = Overlay::instance();
+            overlay.set_screen_size(FRAME_W, FRAME_H);
+            lua.execute(OVERLAY_SCENE, "=bench_scene");
+            cairo_surface_t* surface =
+                cairo_image_surface_create(CAIRO_FORMAT_ARGB32, FRAME_W, FRAME_H);
+            cairo_t* cr = cairo_create(surface);
+            h.run("ui.overlay_render_1080p", [&] {
+                lua.tick();
+                overlay.render(cr, FRAME_W, FRAME_H);
+                cairo_surface_flush(surface);
+                return static_cast<size_t>(overlay.object_count());
+            });
+            cairo_destroy(cr);
+            cairo_surface_destroy(surface);
+            lua.clear_all_drawing_objects();
+        }
+    }
+    if (lua.is_ready()) lua.shutdown();
+
+    // A list-row template (frame, label, icon, corner, stroke) cloned 500
+    // times per iteration, the way scripts populate scrolling lists
+    if (h.wants("ui.gui_clone_rows_500")) {
+        auto& overlay = Overlay::instance();
+        int row   = overlay.create_gui_element("Frame", "Row");
+        int label = overlay.create_gui_element("TextLabel", "Label");
+        int icon  = overlay.create_gui_element("ImageLabel", "Icon");
+        int round = overlay.create_gui_element("UICorner", "UICorner");
+        int edge  = overlay.create_gui_element("UIStroke", "UIStroke");
+        overlay.update_gui_element(row, [](GuiElement& e) {
+            auto& st = e.style.mut();
+            st.bg_r = 0.12f; st.bg_g = 0.12f; st.bg_b = 0.14f;
+        });
+        overlay.update_gui_element(label, [](GuiElement& e) {
+            e.text_style.mut().text = "Player name [120m]";
+        });
+        for (int c : {label, icon, round, edge}) overlay.set_gui_parent(c, row);
+        overlay.drain_gui_commands();
+
+        const std::vector<int> tmpl = {row, label, icon, round, edge};
+        h.run("ui.gui_clone_rows_500", [&] {
+            std::vector<int> roots;
+            for (int i = 0; i < 500; i++) roots.push_back(overlay.clone_gui_tree(tmpl).front());
+            overlay.drain_gui_commands();
+            for (int r : roots) overlay.remove_gui_element(r);
+            overlay.drain_gui_commands();
+            return static_cast<size_t>(500 * tmpl.size());
+        });
+        overlay.clear_gui_elements();
+        overlay.drain_gui_commands();
+    }
+
+    // Widgets need a display; the rest of the suite runs without one
+    if (!gtk_init_check()) {
+        h.skip("ui.editor_highlight_2k", "no display");
+        h.skip("ui.console_append_1k", "no display");
+        return;
+    }
+
+    const std::string corpus = editor_corpus();
+    // Both widgets are leaked on purpose: the editor's debounce timers keep
+    // pointing at it until the process exits
+    auto* editor = new Editor();
+    h.run("ui.editor_highlight_2k", [&] {
+        editor->set_text(corpus);
+        editor->rehighlight();
+        return size_t{2000};
+    });
+
+    auto* console = new Console();
+    console->set_max_lines(5000);
+    h.run("ui.console_append_1k", [&] {
+        for (int i = 0; i < 1000; i++)
+            console->print("line " + std::to_string(i) + ": the quick brown fox",
+                           i % 10 == 0 ? Console::Level::Warn : Console::Level::Output);
+        return size_t{1000};
+    });
+}
+
+} // namespace oss::bench
@@ -1,5 +1,6 @@
 #include "closures.hpp"
 #include "../ui/overlay.hpp"
+#include "environment.hpp"
 #include "../utils/logger.hpp"
 #include "../utils/http.hpp"
 #include "../core/lua_engine.hpp"
@@ -38,7 +39,8 @@ struct InstanceData {
 static std::mutex g_inst_mtx;
 static std::unordered_map<int, InstanceData> g_inst_reg;
 static std::unordered_map<int, std::vector<int>> g_inst_children;
-static int g_next_id = 1;
+// Every actor VM allocates ids from the same registry, so this is atomic.
+static std::atomic<int> g_next_id{1};
 static const std::string WS_DIR = "workspace";
 static std::atomic<bool> g_cancel{false};
 
@@ -96,6 +98,10 @@ static void inst_register(int id, int ov, const std::string& cn,
     if (pid > 0) g_inst_children[pid].push_back(id);
 }
 
+static int inst_next_id() {
+    return g_next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
 static void inst_unregister(int id) {
     std::lock_guard<std::mutex> lk(g_inst_mtx);
     auto it = g_inst_reg.find(id);
@@ -153,6 +159,24 @@ static std::vector<int> inst_get_children(int pid) {
     return cit->second;
 }
 
+// Root first, then every instance before its descendants
+static std::vector<InstanceData> inst_get_subtree(int root) {
+    std::lock_guard<std::mutex> lk(g_inst_mtx);
+    std::vector<InstanceData> out;
+    auto it = g_inst_reg.find(root);
+    if (it == g_inst_reg.end()) return out;
+    out.push_back(it->second);
+    for (size_t i = 0; i < out.size(); i++) {
+        auto cit = g_inst_children.find(out[i].id);
+        if (cit == g_inst_children.end()) continue;
+        for (int c : cit->second) {
+            auto ci = g_inst_reg.find(c);
+            if (ci != g_inst_reg.end()) out.push_back(ci->second);
+        }
+    }
+    return out;
+}
+
 static InstanceData inst_get_data(int id) {
     std::lock_guard<std::mutex> lk(g_inst_mtx);
     auto it = g_inst_reg.find(id);
@@ -199,15 +223,6 @@ static void push_vector2(lua_State* L, double x, double y) {
     lua_pushstring(L, "Vector2"); lua_setfield(L, -2, "__type");
 }
 
-static void read_udim2(lua_State* L, int idx, float& xs, float& xo, float& ys, float& yo) {
-    xs = xo = ys = yo = 0;
-    if (!lua_istable(L, idx)) return;
-    lua_getfield(L, idx, "_xs"); if (lua_isnumber(L, -1)) xs = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-    lua_getfield(L, idx, "_xo"); if (lua_isnumber(L, -1)) xo = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-    lua_getfield(L, idx, "_ys"); if (lua_isnumber(L, -1)) ys = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-    lua_getfield(L, idx, "_yo"); if (lua_isnumber(L, -1)) yo = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-}
-
 static void read_color3(lua_State* L, int idx, float& r, float& g, float& b) {
     r = g = b = 0;
     if (!lua_istable(L, idx)) return;
@@ -216,22 +231,87 @@ static void read_color3(lua_State* L, int idx, float& r, float& g, float& b) {
     lua_getfield(L, idx, "B"); if (lua_isnumber(L, -1)) b = (float)lua_tonumber(L, -1); lua_pop(L, 1);
 }
 
-static void push_instance(lua_State* L, int instance_id, const std::string& class_name) {
+// ── Instance wrappers ──
+// Each VM keeps one wrapper table per live instance in a weak-valued cache,
+// so repeated Parent/FindFirstChild/GetChildren hops hand back the same
+// table (and == works) instead of allocating. Methods and metatables are
+// shared: one method table per VM, one metatable per class.
+
+static const char* INSTANCE_CACHE_KEY   = "__oss_instance_cache";
+static const char* INSTANCE_MT_KEY      = "__oss_instance_mt";
+static const char* INSTANCE_METHODS_KEY = "__oss_instance_methods";
+
+// Pushes registry[key], creating it on first use; `mode` makes it weak
+static void push_registry_table(lua_State* L, const char* key, const char* mode = nullptr) {
+    lua_getfield(L, LUA_REGISTRYINDEX, key);
+    if (!lua_isnil(L, -1)) return;
+    lua_pop(L, 1);
     lua_newtable(L);
-    lua_pushinteger(L, instance_id);       lua_setfield(L, -2, "__id");
-    lua_pushstring(L, class_name.c_str()); lua_setfield(L, -2, "ClassName");
-    lua_pushstring(L, class_name.c_str()); lua_setfield(L, -2, "Name");
+    if (mode) {
+        lua_createtable(L, 0, 1);
+        lua_pushstring(L, mode); lua_setfield(L, -2, "__mode");
+        lua_setmetatable(L, -2);
+    }
+    lua_pushvalue(L, -1);
+    lua_setfield(L, LUA_REGISTRYINDEX, key);
+}
+
+static void push_instance_methods(lua_State* L) {
+    lua_getfield(L, LUA_REGISTRYINDEX, INSTANCE_METHODS_KEY);
+    if (!lua_isnil(L, -1)) return;
+    lua_pop(L, 1);
+    lua_createtable(L, 0, 6);
     lua_pushcfunction(L, Closures::l_instance_destroy,       "Destroy");        lua_setfield(L, -2, "Destroy");
     lua_pushcfunction(L, Closures::l_instance_getchildren,   "GetChildren");    lua_setfield(L, -2, "GetChildren");
     lua_pushcfunction(L, Closures::l_instance_findfirstchild,"FindFirstChild"); lua_setfield(L, -2, "FindFirstChild");
     lua_pushcfunction(L, Closures::l_instance_waitforchild,  "WaitForChild");   lua_setfield(L, -2, "WaitForChild");
     lua_pushcfunction(L, Closures::l_instance_isA,           "IsA");            lua_setfield(L, -2, "IsA");
     lua_pushcfunction(L, Closures::l_instance_clone,         "Clone");          lua_setfield(L, -2, "Clone");
-    lua_newtable(L);
-    lua_pushcfunction(L, Closures::l_instance_index,   "__index");    lua_setfield(L, -2, "__index");
-    lua_pushcfunction(L, Closures::l_instance_newindex, "__newindex"); lua_setfield(L, -2, "__newindex");
-    lua_pushstring(L, class_name.c_str()); lua_setfield(L, -2, "__type");
+    lua_pushvalue(L, -1);
+    lua_setfield(L, LUA_REGISTRYINDEX, INSTANCE_METHODS_KEY);
+}
+
+static void push_instance_metatable(lua_State* L, const std::string& class_name) {
+    push_registry_table(L, INSTANCE_MT_KEY);
+    lua_getfield(L, -1, class_name.c_str());
+    if (lua_isnil(L, -1)) {
+        lua_pop(L, 1);
+        lua_createtable(L, 0, 3);
+        lua_pushcfunction(L, Closures::l_instance_index,   "__index");    lua_setfield(L, -2, "__index");
+        lua_pushcfunction(L, Closures::l_instance_newindex, "__newindex"); lua_setfield(L, -2, "__newindex");
+        lua_pushstring(L, class_name.c_str()); lua_setfield(L, -2, "__type");
+        lua_pushvalue(L, -1);
+        lua_setfield(L, -3, class_name.c_str());
+    }
+    lua_remove(L, -2);
+}
+
+// Pushes the wrapper for `id` using the cache table at absolute index
+// `cache`; false (nothing pushed) if the instance no longer exists
+static bool push_instance_at(lua_State* L, int cache, int id) {
+    lua_rawgeti(L, cache, id);
+    if (!lua_isnil(L, -1)) return true;
+    lua_pop(L, 1);
+
+    auto data = inst_get_data(id);
+    if (data.id == 0) return false;
+    lua_createtable(L, 0, 3);
+    lua_pushinteger(L, id);                     lua_setfield(L, -2, "__id");
+    lua_pushstring(L, data.class_name.c_str()); lua_setfield(L, -2, "ClassName");
+    lua_pushstring(L, data.name.c_str());       lua_setfield(L, -2, "Name");
+    push_instance_metatable(L, data.class_name);
     lua_setmetatable(L, -2);
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, cache, id);
+    return true;
+}
+
+// Pushes the wrapper for a registered instance, or nil
+static void push_instance(lua_State* L, int instance_id) {
+    push_registry_table(L, INSTANCE_CACHE_KEY, "v");
+    int cache = lua_gettop(L);
+    if (!push_instance_at(L, cache, instance_id)) lua_pushnil(L);
+    lua_remove(L, cache);
 }
 
 static bool compile_and_load(lua_State* L, const char* src, const char* chunkname) {
@@ -430,7 +510,7 @@ int Closures::l_instance_new(lua_State* L) {
     const char* cn = luaL_checkstring(L, 1);
     auto& overlay = Overlay::instance();
     int ov_id = overlay.create_gui_element(cn, cn);
-    int inst_id = g_next_id++;
+    int inst_id = inst_next_id();
     int parent_inst = 0;
 
     if (lua_gettop(L) >= 2 && lua_istable(L, 2)) {
@@ -445,8 +525,8 @@ int Closures::l_instance_new(lua_State* L) {
     }
 
     inst_register(inst_id, ov_id, cn, cn, parent_inst);
-    push_instance(L, inst_id, cn);
-    spdlog::debug("Instance.new('{}') id={} ov={}", cn, inst_id, ov_id);
+    push_instance(L, inst_id);
+    LOG_SUB_DEBUG("script", "Instance.new('{}') id={} ov={}", cn, inst_id, ov_id);
     return 1;
 }
 
@@ -463,21 +543,23 @@ int Closures::l_instance_index(lua_State* L) {
     int inst_id = (int)lua_tointeger(L, -1);
     lua_pop(L, 1);
 
+    push_instance_methods(L);
+    lua_pushvalue(L, 2);
+    lua_rawget(L, -2);
+    if (!lua_isnil(L, -1)) return 1;
+    lua_pop(L, 2);
+
     std::string k(key);
     if (k == "Parent") {
         auto data = inst_get_data(inst_id);
-        if (data.parent_id > 0) {
-            auto pdata = inst_get_data(data.parent_id);
-            if (pdata.id > 0) { push_instance(L, pdata.id, pdata.class_name); return 1; }
-        }
-        lua_pushnil(L);
+        if (data.parent_id > 0) push_instance(L, data.parent_id);
+        else lua_pushnil(L);
         return 1;
     }
 
     int child = inst_find_child(inst_id, k);
     if (child > 0) {
-        auto cd = inst_get_data(child);
-        push_instance(L, cd.id, cd.class_name);
+        push_instance(L, child);
         return 1;
     }
 
@@ -539,78 +621,10 @@ int Closures::l_instance_newindex(lua_State* L) {
         return 0;
     }
 
-    overlay.update_gui_element(overlay_id, [&](GuiElement& e) {
-        if      (prop == "Visible")    { e.visible = lua_toboolean(L, 3); }
-        else if (prop == "Text")       { if (lua_isstring(L, 3)) e.text = lua_tostring(L, 3); }
-        else if (prop == "TextColor3") { read_color3(L, 3, e.text_r, e.text_g, e.text_b); }
-        else if (prop == "TextSize")   { if (lua_isnumber(L, 3)) e.text_size = (float)lua_tonumber(L, 3); }
-        else if (prop == "TextTransparency")       { if (lua_isnumber(L, 3)) e.text_transparency = (float)lua_tonumber(L, 3); }
-        else if (prop == "TextStrokeTransparency")  { if (lua_isnumber(L, 3)) e.text_stroke_transparency = (float)lua_tonumber(L, 3); }
-        else if (prop == "TextStrokeColor3")        { read_color3(L, 3, e.text_stroke_r, e.text_stroke_g, e.text_stroke_b); }
-        else if (prop == "TextXAlignment")  { if (lua_isnumber(L, 3)) e.text_x_alignment = (int)lua_tointeger(L, 3); }
-        else if (prop == "TextYAlignment")  { if (lua_isnumber(L, 3)) e.text_y_alignment = (int)lua_tointeger(L, 3); }
-        else if (prop == "TextWrapped")     { e.text_wrapped = lua_toboolean(L, 3); }
-        else if (prop == "TextScaled")      { e.text_scaled = lua_toboolean(L, 3); }
-        else if (prop == "RichText")        { e.rich_text = lua_toboolean(L, 3); }
-        else if (prop == "BackgroundColor3")       { read_color3(L, 3, e.bg_r, e.bg_g, e.bg_b); }
-        else if (prop == "BackgroundTransparency") { if (lua_isnumber(L, 3)) e.bg_transparency = (float)lua_tonumber(L, 3); }
-        else if (prop == "BorderColor3")    { read_color3(L, 3, e.border_r, e.border_g, e.border_b); }
-        else if (prop == "BorderSizePixel") { if (lua_isnumber(L, 3)) e.border_size = (int)lua_tointeger(L, 3); }
-        else if (prop == "Size") {
-            read_udim2(L, 3, e.size_x_scale, e.size_x_offset, e.size_y_scale, e.size_y_offset);
-        }
-        else if (prop == "Position") {
-            read_udim2(L, 3, e.pos_x_scale, e.pos_x_offset, e.pos_y_scale, e.pos_y_offset);
-        }
-        else if (prop == "AnchorPoint") {
-            if (lua_istable(L, 3)) {
-                lua_getfield(L, 3, "X"); if (lua_isnumber(L, -1)) e.anchor_x = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-                lua_getfield(L, 3, "Y"); if (lua_isnumber(L, -1)) e.anchor_y = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-            }
-        }
-        else if (prop == "Rotation")         { if (lua_isnumber(L, 3)) e.rotation = (float)lua_tonumber(L, 3); }
-        else if (prop == "ClipsDescendants") { e.clips_descendants = lua_toboolean(L, 3); }
-        else if (prop == "ZIndex")           { if (lua_isnumber(L, 3)) e.z_index = (int)lua_tointeger(L, 3); }
-        else if (prop == "LayoutOrder")      { if (lua_isnumber(L, 3)) e.layout_order = (int)lua_tointeger(L, 3); }
-        else if (prop == "Enabled")          { e.enabled = lua_toboolean(L, 3); }
-        else if (prop == "DisplayOrder")     { if (lua_isnumber(L, 3)) e.display_order = (int)lua_tointeger(L, 3); }
-        else if (prop == "IgnoreGuiInset")   { e.ignore_gui_inset = lua_toboolean(L, 3); }
-        else if (prop == "ResetOnSpawn")     { }
-        else if (prop == "CornerRadius") {
-            if (lua_istable(L, 3)) {
-                lua_getfield(L, 3, "Offset"); if (lua_isnumber(L, -1)) e.corner_radius = (float)lua_tonumber(L, -1); lua_pop(L, 1);
-            } else if (lua_isnumber(L, 3)) e.corner_radius = (float)lua_tonumber(L, 3);
-        }
-        else if (prop == "Thickness")   { if (lua_isnumber(L, 3)) e.stroke_thickness = (float)lua_tonumber(L, 3); }
-        else if (prop == "Color")       { read_color3(L, 3, e.stroke_r, e.stroke_g, e.stroke_b); }
-        else if (prop == "Transparency"){ if (lua_isnumber(L, 3)) e.stroke_transparency = (float)lua_tonumber(L, 3); }
-        else if (prop == "PaddingTop") {
-            if (lua_istable(L, 3)) { lua_getfield(L, 3, "Offset"); if (lua_isnumber(L, -1)) e.pad_top = (float)lua_tonumber(L, -1); lua_pop(L, 1); }
-        }
-        else if (prop == "PaddingBottom") {
-            if (lua_istable(L, 3)) { lua_getfield(L, 3, "Offset"); if (lua_isnumber(L, -1)) e.pad_bottom = (float)lua_tonumber(L, -1); lua_pop(L, 1); }
-        }
-        else if (prop == "PaddingLeft") {
-            if (lua_istable(L, 3)) { lua_getfield(L, 3, "Offset"); if (lua_isnumber(L, -1)) e.pad_left = (float)lua_tonumber(L, -1); lua_pop(L, 1); }
-        }
-        else if (prop == "PaddingRight") {
-            if (lua_istable(L, 3)) { lua_getfield(L, 3, "Offset"); if (lua_isnumber(L, -1)) e.pad_right = (float)lua_tonumber(L, -1); lua_pop(L, 1); }
-        }
-        else if (prop == "Image")             { if (lua_isstring(L, 3)) e.image = lua_tostring(L, 3); }
-        else if (prop == "ImageColor3")       { read_color3(L, 3, e.image_r, e.image_g, e.image_b); }
-        else if (prop == "ImageTransparency") { if (lua_isnumber(L, 3)) e.image_transparency = (float)lua_tonumber(L, 3); }
-        else if (prop == "ScrollingEnabled")  { e.scrolling_enabled = lua_toboolean(L, 3); }
-        else if (prop == "CanvasSize") {
-            if (lua_istable(L, 3)) {
-                float xs2, xo2, ys2, yo2;
-                read_udim2(L, 3, xs2, xo2, ys2, yo2);
-                e.canvas_size_y = ys2 * 1000 + yo2;
-            }
-        }
-        else if (prop == "Padding") {
-            if (lua_istable(L, 3)) { lua_getfield(L, 3, "Offset"); if (lua_isnumber(L, -1)) e.pad_top = (float)lua_tonumber(L, -1); lua_pop(L, 1); }
-        }
-    });
+    GuiCommand cmd;
+    cmd.id = overlay_id;
+    if (Environment::parse_gui_property(L, prop, 3, cmd, Environment::GuiPropSource::Instance))
+        overlay.push_gui_command(std::move(cmd));
 
     lua_rawset(L, 1);
     return 0;
@@ -641,24 +655,33 @@ int Closures::l_instance_clone(lua_State* L) {
     int src_id = lua_isnumber(L, -1) ? (int)lua_tointeger(L, -1) : 0;
     lua_pop(L, 1);
 
-    auto src = inst_get_data(src_id);
-    std::string cn = src.id > 0 ? src.class_name : "Frame";
-    std::string nm = src.id > 0 ? src.name : cn;
-
     auto& overlay = Overlay::instance();
-    int new_ov = overlay.create_gui_element(cn.c_str(), nm.c_str());
-    int new_id = g_next_id++;
-    inst_register(new_id, new_ov, cn, nm, 0);
-
-    if (src.id > 0) {
-        overlay.update_gui_element(new_ov, [&](GuiElement& dst) {
-            overlay.update_gui_element(src.overlay_id, [&](GuiElement& s) {
-                dst = s;
-            });
-        });
+    auto tree = inst_get_subtree(src_id);
+    if (tree.empty()) {
+        int new_id = inst_next_id();
+        inst_register(new_id, overlay.create_gui_element("Frame", "Frame"), "Frame", "Frame", 0);
+        push_instance(L, new_id);
+        return 1;
     }
 
-    push_instance(L, new_id, cn);
+    // One overlay command copies the whole subtree; style blocks stay shared
+    // with the source until either side changes them.
+    std::vector<int> src_ov;
+    src_ov.reserve(tree.size());
+    for (const auto& d : tree) src_ov.push_back(d.overlay_id);
+    std::vector<int> new_ov = overlay.clone_gui_tree(src_ov);
+
+    std::unordered_map<int, int> remap;
+    remap.reserve(tree.size());
+    for (size_t i = 0; i < tree.size(); i++) {
+        int new_id = inst_next_id();
+        auto pit = remap.find(tree[i].parent_id);
+        int pid = (i > 0 && pit != remap.end()) ? pit->second : 0;
+        inst_register(new_id, new_ov[i], tree[i].class_name, tree[i].name, pid);
+        remap[tree[i].id] = new_id;
+    }
+
+    push_instance(L, remap[src_id]);
     return 1;
 }
 
@@ -668,14 +691,13 @@ int Closures::l_instance_getchildren(lua_State* L) {
     lua_pop(L, 1);
 
     auto children = inst_get_children(inst_id);
+    push_registry_table(L, INSTANCE_CACHE_KEY, "v");
+    int cache = lua_gettop(L);
     lua_createtable(L, (int)children.size(), 0);
     int idx = 1;
     for (int cid : children) {
-        auto cd = inst_get_data(cid);
-        if (cd.id > 0) {
-            push_instance(L, cd.id, cd.class_name);
+        if (push_instance_at(L, cache, cid))
             lua_rawseti(L, -2, idx++);
-        }
     }
     return 1;
 }
@@ -687,12 +709,8 @@ int Closures::l_instance_findfirstchild(lua_State* L) {
     lua_pop(L, 1);
 
     int child = inst_find_child(inst_id, name);
-    if (child > 0) {
-        auto cd = inst_get_data(child);
-        push_instance(L, cd.id, cd.class_name);
-    } else {
-        lua_pushnil(L);
-    }
+    if (child > 0) push_instance(L, child);
+    else lua_pushnil(L);
     return 1;
 }
 
@@ -711,8 +729,7 @@ int Closures::l_instance_waitforchild(lua_State* L) {
         chk(L);
         int child = inst_find_child(inst_id, name);
         if (child > 0) {
-            auto cd = inst_get_data(child);
-            push_instance(L, cd.id, cd.class_name);
+            push_instance(L, child);
             return 1;
         }
         double elapsed = std::chrono::duration<double>(
@@ -1030,11 +1047,11 @@ int Closures::l_game_getservice(lua_State* L) {
         lua_pushinteger(L, 1);            lua_setfield(L, -2, "UserId");
         lua_pushstring(L, "Player1");     lua_setfield(L, -2, "DisplayName");
 
-        int pg_inst = g_next_id++;
+        int pg_inst = inst_next_id();
         auto& ov = Overlay::instance();
         int pg_ov = ov.create_gui_element("PlayerGui", "PlayerGui");
         inst_register(pg_inst, pg_ov, "PlayerGui", "PlayerGui");
-        push_instance(L, pg_inst, "PlayerGui");
+        push_instance(L, pg_inst);
         lua_setfield(L, -2, "PlayerGui");
 
         lua_newtable(L);
@@ -1058,7 +1075,7 @@ int Closures::l_game_getservice(lua_State* L) {
         lua_setfield(L, -2, "GetPlayers");
     }
     else if (sn == "CoreGui") {
-        int cg_inst = g_next_id++;
+        int cg_inst = inst_next_id();
         auto& ov = Overlay::instance();
         int cg_ov = ov.create_gui_element("CoreGui", "CoreGui");
         inst_register(cg_inst, cg_ov, "CoreGui", "CoreGui");
@@ -1335,31 +1352,31 @@ int Closures::l_getnamecallmethod(lua_State* L) {
 }
 
 int Closures::l_fireclickdetector(lua_State* L) {
-    spdlog::warn("[Script] fireclickdetector: requires injection into target process");
+    LOG_WARN_EVERY(10000, "[Script] fireclickdetector: requires injection into target process");
     return 0;
 }
 
 int Closures::l_firetouchinterest(lua_State* L) {
-    spdlog::warn("[Script] firetouchinterest: requires injection into target process");
+    LOG_WARN_EVERY(10000, "[Script] firetouchinterest: requires injection into target process");
     return 0;
 }
 
 int Closures::l_fireproximityprompt(lua_State* L) {
-    spdlog::warn("[Script] fireproximityprompt: requires injection into target process");
+    LOG_WARN_EVERY(10000, "[Script] fireproximityprompt: requires injection into target process");
     return 0;
 }
 
 int Closures::l_gethui(lua_State* L) {
+    static std::once_flag hui_once;
     static int hui_inst = 0;
-    static int hui_ov   = 0;
-    if (hui_inst == 0) {
-        auto& overlay = Overlay::instance();
-        hui_ov   = overlay.create_gui_element("Folder", "HiddenUI");
-        hui_inst = g_next_id++;
-        inst_register(hui_inst, hui_ov, "Folder", "HiddenUI");
-    }
-    push_instance(L, hui_inst, "Folder");
-    lua_pushstring(L, "CoreGui"); lua_setfield(L, -2, "ClassName");
+    std::call_once(hui_once, [] {
+        int hui_ov = Overlay::instance().create_gui_element("Folder", "HiddenUI");
+        hui_inst = inst_next_id();
+        // Renders as a plain folder but reports itself as CoreGui. The
+        // wrapper is cached and shared, so the class lives in the registry.
+        inst_register(hui_inst, hui_ov, "CoreGui", "HiddenUI");
+    });
+    push_instance(L, hui_inst);
     return 1;
 }
 
@@ -1764,7 +1781,7 @@ int Closures::l_writefile(lua_State* L) {
     if (!f.is_open()) { luaL_error(L, "Cannot write file: %s", fn); return 0; }
     f.write(data, (std::streamsize)len);
     f.close();
-    spdlog::debug("[Script] writefile: {} ({} bytes)", fn, len);
+    LOG_SUB_DEBUG("script", "writefile: {} ({} bytes)", fn, len);
     return 0;
 }
 
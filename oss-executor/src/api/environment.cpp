@@ -8,6 +8,7 @@
 #include <cstring>
 #include <sstream>
 #include <map>
+#include <unordered_map>
 #include "Luau/Compiler.h"
 
 // Luau compat: lua_pushcfunction requires 3 args; accept 2 or 3
@@ -126,50 +127,170 @@ static int lua_drawing_new_bridge(lua_State* L) {
     return 1;
 }
 
-static int lua_drawing_set_bridge(lua_State* L) {
-    int id = static_cast<int>(luaL_checkinteger(L, 1));
-    const char* key = luaL_checkstring(L, 2);
-    std::string k(key);
+static void drawing_read_vec2(lua_State* L, int idx, double& x, double& y) {
+    if (lua_istable(L, idx)) {
+        lua_getfield(L, idx, "X"); x = lua_tonumber(L, -1); lua_pop(L, 1);
+        lua_getfield(L, idx, "Y"); y = lua_tonumber(L, -1); lua_pop(L, 1);
+    }
+}
 
-    auto read_vec2 = [L](int idx, double& x, double& y) {
-        if (lua_istable(L, idx)) {
-            lua_getfield(L, idx, "X"); x = lua_tonumber(L, -1); lua_pop(L, 1);
-            lua_getfield(L, idx, "Y"); y = lua_tonumber(L, -1); lua_pop(L, 1);
-        }
-    };
-    auto read_color = [L](int idx, double& r, double& g, double& b) {
-        if (lua_istable(L, idx)) {
-            lua_getfield(L, idx, "R"); r = lua_tonumber(L, -1); lua_pop(L, 1);
-            lua_getfield(L, idx, "G"); g = lua_tonumber(L, -1); lua_pop(L, 1);
-            lua_getfield(L, idx, "B"); b = lua_tonumber(L, -1); lua_pop(L, 1);
-        }
+static void drawing_read_color(lua_State* L, int idx, double& r, double& g, double& b) {
+    if (lua_istable(L, idx)) {
+        lua_getfield(L, idx, "R"); r = lua_tonumber(L, -1); lua_pop(L, 1);
+        lua_getfield(L, idx, "G"); g = lua_tonumber(L, -1); lua_pop(L, 1);
+        lua_getfield(L, idx, "B"); b = lua_tonumber(L, -1); lua_pop(L, 1);
+    }
+}
+
+// One property write decoded from Lua. Decoding may raise or run
+// metamethods, so it happens before the overlay lock is taken.
+enum class DrawingProp : uint8_t {
+    Visible, Thickness, Transparency, ZIndex, Color, OutlineColor, From, To,
+    Position, PointA, PointB, PointC, Text, TextSize, Size, Center, Outline,
+    Filled, Radius, NumSides, Font, Rounding, Closed, Points, Ignore
+};
+
+struct DrawingWrite {
+    int         id   = 0;
+    DrawingProp prop = DrawingProp::Ignore;
+    double      x = 0, y = 0, z = 0;  // number, vec2 or color components
+    bool        flag = false;
+    std::string text;
+    std::shared_ptr<const std::vector<float>> points;
+};
+
+static const std::unordered_map<std::string, DrawingProp>& drawing_prop_table() {
+    static const std::unordered_map<std::string, DrawingProp> table = {
+        {"Visible", DrawingProp::Visible},       {"Thickness", DrawingProp::Thickness},
+        {"Transparency", DrawingProp::Transparency}, {"ZIndex", DrawingProp::ZIndex},
+        {"Color", DrawingProp::Color},           {"OutlineColor", DrawingProp::OutlineColor},
+        {"From", DrawingProp::From},             {"To", DrawingProp::To},
+        {"Position", DrawingProp::Position},     {"PointA", DrawingProp::PointA},
+        {"PointB", DrawingProp::PointB},         {"PointC", DrawingProp::PointC},
+        {"Text", DrawingProp::Text},             {"Size", DrawingProp::Size},
+        {"Center", DrawingProp::Center},         {"Outline", DrawingProp::Outline},
+        {"Filled", DrawingProp::Filled},         {"Radius", DrawingProp::Radius},
+        {"NumSides", DrawingProp::NumSides},     {"Font", DrawingProp::Font},
+        {"Rounding", DrawingProp::Rounding},     {"Closed", DrawingProp::Closed},
+        {"Points", DrawingProp::Points},
     };
+    return table;
+}
+
+// Decodes the value at absolute index v. Vectors, colors and text that have
+// the wrong type are ignored; Points raises, as it does for Drawing:Set.
+static void decode_drawing_prop(lua_State* L, const char* key, int v, DrawingWrite& w) {
+    auto it = drawing_prop_table().find(key);
+    w.prop = it != drawing_prop_table().end() ? it->second : DrawingProp::Ignore;
+
+    switch (w.prop) {
+    case DrawingProp::Visible: case DrawingProp::Center: case DrawingProp::Outline:
+    case DrawingProp::Filled:  case DrawingProp::Closed:
+        w.flag = lua_toboolean(L, v);
+        break;
+    case DrawingProp::Thickness: case DrawingProp::Transparency: case DrawingProp::Radius:
+    case DrawingProp::Rounding:
+        w.x = lua_tonumber(L, v);
+        break;
+    case DrawingProp::ZIndex: case DrawingProp::NumSides: case DrawingProp::Font:
+        w.x = static_cast<double>(lua_tointeger(L, v));
+        break;
+    case DrawingProp::Color: case DrawingProp::OutlineColor:
+        if (!lua_istable(L, v)) { w.prop = DrawingProp::Ignore; break; }
+        drawing_read_color(L, v, w.x, w.y, w.z);
+        break;
+    case DrawingProp::From: case DrawingProp::To: case DrawingProp::Position:
+    case DrawingProp::PointA: case DrawingProp::PointB: case DrawingProp::PointC:
+        if (!lua_istable(L, v)) { w.prop = DrawingProp::Ignore; break; }
+        drawing_read_vec2(L, v, w.x, w.y);
+        break;
+    case DrawingProp::Text:
+        if (lua_isstring(L, v)) w.text = lua_tostring(L, v);
+        else w.prop = DrawingProp::Ignore;
+        break;
+    case DrawingProp::Size:
+        if (lua_isnumber(L, v)) { w.prop = DrawingProp::TextSize; w.x = lua_tonumber(L, v); }
+        else if (lua_istable(L, v)) drawing_read_vec2(L, v, w.x, w.y);
+        else w.prop = DrawingProp::Ignore;
+        break;
+    case DrawingProp::Points:
+        w.points = LuaEngine::read_point_array(L, v);
+        if (!w.points) luaL_error(L, "Points: expected table or buffer");
+        break;
+    default:
+        break;
+    }
+}
 
-    Overlay::instance().update_object(id, [&](DrawingObject& obj) {
-        if (k == "Visible") obj.visible = lua_toboolean(L, 3);
-        else if (k == "Thickness") obj.thickness = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "Transparency") obj.transparency = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "ZIndex") obj.z_index = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "Color") read_color(3, obj.color_r, obj.color_g, obj.color_b);
-        else if (k == "OutlineColor") read_color(3, obj.outline_r, obj.outline_g, obj.outline_b);
-        else if (k == "From") read_vec2(3, obj.from_x, obj.from_y);
-        else if (k == "To") read_vec2(3, obj.to_x, obj.to_y);
-        else if (k == "Position") read_vec2(3, obj.pos_x, obj.pos_y);
-        else if (k == "PointA") read_vec2(3, obj.pa_x, obj.pa_y);
-        else if (k == "PointB") read_vec2(3, obj.pb_x, obj.pb_y);
-        else if (k == "PointC") read_vec2(3, obj.pc_x, obj.pc_y);
-        else if (k == "Text") { if (lua_isstring(L, 3)) obj.text = lua_tostring(L, 3); }
-        else if (k == "Size") {
-            if (lua_isnumber(L, 3)) obj.text_size = static_cast<float>(lua_tonumber(L, 3));
-            else if (lua_istable(L, 3)) read_vec2(3, obj.size_x, obj.size_y);
+static void apply_drawing_write(DrawingObject& obj, const DrawingWrite& w) {
+    switch (w.prop) {
+    case DrawingProp::Visible:      obj.visible = w.flag; break;
+    case DrawingProp::Thickness:    obj.thickness = static_cast<float>(w.x); break;
+    case DrawingProp::Transparency: obj.transparency = static_cast<float>(w.x); break;
+    case DrawingProp::ZIndex:       obj.z_index = static_cast<int>(w.x); break;
+    case DrawingProp::Color:        obj.color_r = w.x; obj.color_g = w.y; obj.color_b = w.z; break;
+    case DrawingProp::OutlineColor: obj.outline_r = w.x; obj.outline_g = w.y; obj.outline_b = w.z; break;
+    case DrawingProp::From:         obj.from_x = w.x; obj.from_y = w.y; break;
+    case DrawingProp::To:           obj.to_x = w.x; obj.to_y = w.y; break;
+    case DrawingProp::Position:     obj.pos_x = w.x; obj.pos_y = w.y; break;
+    case DrawingProp::PointA:       obj.pa_x = w.x; obj.pa_y = w.y; break;
+    case DrawingProp::PointB:       obj.pb_x = w.x; obj.pb_y = w.y; break;
+    case DrawingProp::PointC:       obj.pc_x = w.x; obj.pc_y = w.y; break;
+    case DrawingProp::Text:         obj.text = w.text; break;
+    case DrawingProp::TextSize:     obj.text_size = static_cast<float>(w.x); break;
+    case DrawingProp::Size:         obj.size_x = w.x; obj.size_y = w.y; break;
+    case DrawingProp::Center:       obj.center = w.flag; break;
+    case DrawingProp::Outline:      obj.outline = w.flag; break;
+    case DrawingProp::Filled:       obj.filled = w.flag; break;
+    case DrawingProp::Radius:       obj.radius = static_cast<float>(w.x); break;
+    case DrawingProp::NumSides:     obj.num_sides = static_cast<int>(w.x); break;
+    case DrawingProp::Font:         obj.font = static_cast<int>(w.x); break;
+    case DrawingProp::Rounding:     obj.rounding = static_cast<float>(w.x); break;
+    case DrawingProp::Closed:       obj.closed = w.flag; break;
+    case DrawingProp::Points:       obj.points = w.points; break;
+    case DrawingProp::Ignore:       break;
+    }
+}
+
+static int lua_drawing_set_bridge(lua_State* L) {
+    DrawingWrite w;
+    w.id = static_cast<int>(luaL_checkinteger(L, 1));
+    decode_drawing_prop(L, luaL_checkstring(L, 2), 3, w);
+    if (w.prop == DrawingProp::Ignore) return 0;
+
+    Overlay::instance().update_object(w.id, [&](DrawingObject& obj) {
+        apply_drawing_write(obj, w);
+    });
+    return 0;
+}
+
+// Flushes a Drawing.batch command buffer: a flat {id, key, value, ...} array,
+// decoded first and then applied under one overlay lock with a single dirty
+// notification.
+static int lua_drawing_apply_bridge(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    int n = lua_objlen(L, 1);
+
+    std::vector<DrawingWrite> writes;
+    writes.reserve(static_cast<size_t>(n / 3));
+    for (int i = 1; i + 2 <= n; i += 3) {
+        lua_rawgeti(L, 1, i);
+        lua_rawgeti(L, 1, i + 1);
+        lua_rawgeti(L, 1, i + 2);
+        int top = lua_gettop(L);
+        if (lua_isstring(L, top - 1)) {
+            DrawingWrite w;
+            w.id = static_cast<int>(lua_tointeger(L, top - 2));
+            decode_drawing_prop(L, lua_tostring(L, top - 1), top, w);
+            if (w.prop != DrawingProp::Ignore) writes.push_back(std::move(w));
         }
-        else if (k == "Center") obj.center = lua_toboolean(L, 3);
-        else if (k == "Outline") obj.outline = lua_toboolean(L, 3);
-        else if (k == "Filled") obj.filled = lua_toboolean(L, 3);
-        else if (k == "Radius") obj.radius = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "NumSides") obj.num_sides = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "Font") obj.font = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "Rounding") obj.rounding = static_cast<float>(lua_tonumber(L, 3));
+        lua_pop(L, 3);
+    }
+    if (writes.empty()) return 0;
+
+    Overlay::instance().update_objects([&](auto&& find) {
+        for (const auto& w : writes)
+            if (DrawingObject* obj = find(w.id)) apply_drawing_write(*obj, w);
     });
     return 0;
 }
@@ -190,160 +311,248 @@ static int lua_gui_create(lua_State* L) {
     return 1;
 }
 
-static int lua_gui_set(lua_State* L) {
-    int id = static_cast<int>(luaL_checkinteger(L, 1));
-    const char* key = luaL_checkstring(L, 2);
-    std::string k(key);
-
-    auto read_color3 = [L](int idx, float& r, float& g, float& b) {
-        if (lua_istable(L, idx)) {
-            lua_getfield(L, idx, "R"); r = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-            lua_getfield(L, idx, "G"); g = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-            lua_getfield(L, idx, "B"); b = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-        }
-    };
+// ── GUI property decoding ──
+// Values are decoded here on the script thread into a GuiCommand; the
+// matching setter runs later on the renderer when the queue is drained.
 
-    auto read_udim2 = [L](int idx, float& xs, float& xo, float& ys, float& yo) {
-        if (lua_istable(L, idx)) {
-            lua_getfield(L, idx, "X");
-            if (lua_istable(L, -1)) {
-                lua_getfield(L, -1, "Scale"); xs = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-                lua_getfield(L, -1, "Offset"); xo = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-            }
-            lua_pop(L, 1);
-            lua_getfield(L, idx, "Y");
-            if (lua_istable(L, -1)) {
-                lua_getfield(L, -1, "Scale"); ys = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-                lua_getfield(L, -1, "Offset"); yo = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-            }
-            lua_pop(L, 1);
-        }
-    };
+enum class GuiValueKind : uint8_t {
+    Bool, Int, Float, Color3, UDim2, UDim, Vec2, String, AlignX, AlignY, Ignore
+};
 
-    auto read_udim = [L](int idx) -> float {
-        if (lua_istable(L, idx)) {
-            lua_getfield(L, idx, "Offset");
-            float v = static_cast<float>(lua_tonumber(L, -1));
-            lua_pop(L, 1);
-            return v;
+using GuiSetter = void (*)(GuiElement&, const GuiCommand&);
+
+struct GuiPropSpec {
+    GuiValueKind kind;
+    GuiSetter    set;
+};
+
+static float gui_field(lua_State* L, int idx, const char* name) {
+    lua_getfield(L, idx, name);
+    float v = static_cast<float>(lua_tonumber(L, -1));
+    lua_pop(L, 1);
+    return v;
+}
+
+static bool gui_read_color3(lua_State* L, int idx, float* out) {
+    if (!lua_istable(L, idx)) return false;
+    out[0] = gui_field(L, idx, "R");
+    out[1] = gui_field(L, idx, "G");
+    out[2] = gui_field(L, idx, "B");
+    return true;
+}
+
+// Accepts both the mock's {X={Scale,Offset},Y={...}} and the instance
+// library's flat {_xs,_xo,_ys,_yo} layout.
+static bool gui_read_udim2(lua_State* L, int idx, float* out) {
+    if (!lua_istable(L, idx)) return false;
+    lua_getfield(L, idx, "X");
+    bool nested = lua_istable(L, -1);
+    lua_pop(L, 1);
+    if (!nested) {
+        out[0] = gui_field(L, idx, "_xs");
+        out[1] = gui_field(L, idx, "_xo");
+        out[2] = gui_field(L, idx, "_ys");
+        out[3] = gui_field(L, idx, "_yo");
+        return true;
+    }
+    const char* axes[2] = {"X", "Y"};
+    for (int a = 0; a < 2; a++) {
+        lua_getfield(L, idx, axes[a]);
+        if (lua_istable(L, -1)) {
+            int t = lua_gettop(L);
+            out[a * 2]     = gui_field(L, t, "Scale");
+            out[a * 2 + 1] = gui_field(L, t, "Offset");
         }
-        return 0;
+        lua_pop(L, 1);
+    }
+    return true;
+}
+
+static float gui_read_udim(lua_State* L, int idx) {
+    if (lua_istable(L, idx)) return gui_field(L, idx, "Offset");
+    if (lua_isnumber(L, idx)) return static_cast<float>(lua_tonumber(L, idx));
+    return 0;
+}
+
+static bool gui_read_vec2(lua_State* L, int idx, float* out) {
+    if (!lua_istable(L, idx)) return false;
+    out[0] = gui_field(L, idx, "X");
+    out[1] = gui_field(L, idx, "Y");
+    return true;
+}
+
+// Enum items arrive as tables carrying Name (and sometimes Value) or as a
+// raw number.
+static bool gui_read_alignment(lua_State* L, int idx, const char* const names[3], int& out) {
+    if (lua_isnumber(L, idx)) {
+        out = static_cast<int>(lua_tointeger(L, idx));
+        return true;
+    }
+    if (!lua_istable(L, idx)) return false;
+    bool found = false;
+    lua_getfield(L, idx, "Value");
+    if (lua_isnumber(L, -1)) { out = static_cast<int>(lua_tointeger(L, -1)); found = true; }
+    lua_pop(L, 1);
+    lua_getfield(L, idx, "Name");
+    if (lua_isstring(L, -1)) {
+        const char* n = lua_tostring(L, -1);
+        for (int a = 0; a < 3; a++)
+            if (std::strcmp(n, names[a]) == 0) { out = a; found = true; }
+    }
+    lua_pop(L, 1);
+    return found;
+}
+
+#define GUI_SET(body) [](GuiElement& e, const GuiCommand& c) { (void)c; body; }
+
+static const std::unordered_map<std::string, GuiPropSpec>& gui_prop_table() {
+    using K = GuiValueKind;
+    static const std::unordered_map<std::string, GuiPropSpec> table = {
+        {"Visible",                {K::Bool,   GUI_SET(e.visible = c.b)}},
+        {"Name",                   {K::String, GUI_SET(e.name = c.s)}},
+        {"BackgroundColor3",       {K::Color3, GUI_SET(auto& st = e.style.mut(); st.bg_r = c.f[0]; st.bg_g = c.f[1]; st.bg_b = c.f[2])}},
+        {"BackgroundTransparency", {K::Float,  GUI_SET(e.style.mut().bg_transparency = c.f[0])}},
+        {"BorderColor3",           {K::Color3, GUI_SET(auto& st = e.style.mut(); st.border_r = c.f[0]; st.border_g = c.f[1]; st.border_b = c.f[2])}},
+        {"BorderSizePixel",        {K::Int,    GUI_SET(e.style.mut().border_size = c.i)}},
+        {"Size",                   {K::UDim2,  GUI_SET(e.size_x_scale = c.f[0]; e.size_x_offset = c.f[1];
+                                                       e.size_y_scale = c.f[2]; e.size_y_offset = c.f[3])}},
+        {"Position",               {K::UDim2,  GUI_SET(e.pos_x_scale = c.f[0]; e.pos_x_offset = c.f[1];
+                                                       e.pos_y_scale = c.f[2]; e.pos_y_offset = c.f[3])}},
+        {"AnchorPoint",            {K::Vec2,   GUI_SET(e.anchor_x = c.f[0]; e.anchor_y = c.f[1])}},
+        {"Rotation",               {K::Float,  GUI_SET(e.rotation = c.f[0])}},
+        {"ClipsDescendants",       {K::Bool,   GUI_SET(e.clips_descendants = c.b)}},
+        {"ZIndex",                 {K::Int,    GUI_SET(e.z_index = c.i)}},
+        {"LayoutOrder",            {K::Int,    GUI_SET(e.layout_order = c.i)}},
+        {"Text",                   {K::String, GUI_SET(e.text_style.mut().text = c.s)}},
+        {"TextColor3",             {K::Color3, GUI_SET(auto& ts = e.text_style.mut(); ts.text_r = c.f[0]; ts.text_g = c.f[1]; ts.text_b = c.f[2])}},
+        {"TextSize",               {K::Float,  GUI_SET(e.text_style.mut().text_size = c.f[0])}},
+        {"TextTransparency",       {K::Float,  GUI_SET(e.text_style.mut().text_transparency = c.f[0])}},
+        {"TextStrokeTransparency", {K::Float,  GUI_SET(e.text_style.mut().text_stroke_transparency = c.f[0])}},
+        {"TextStrokeColor3",       {K::Color3, GUI_SET(auto& ts = e.text_style.mut(); ts.text_stroke_r = c.f[0]; ts.text_stroke_g = c.f[1]; ts.text_stroke_b = c.f[2])}},
+        {"TextWrapped",            {K::Bool,   GUI_SET(e.text_style.mut().text_wrapped = c.b)}},
+        {"TextScaled",             {K::Bool,   GUI_SET(e.text_style.mut().text_scaled = c.b)}},
+        {"RichText",               {K::Bool,   GUI_SET(e.text_style.mut().rich_text = c.b)}},
+        {"TextXAlignment",         {K::AlignX, GUI_SET(e.text_style.mut().text_x_alignment = c.i)}},
+        {"TextYAlignment",         {K::AlignY, GUI_SET(e.text_style.mut().text_y_alignment = c.i)}},
+        {"Image",                  {K::String, GUI_SET(e.image_style.mut().image = c.s)}},
+        {"ImageColor3",            {K::Color3, GUI_SET(auto& im = e.image_style.mut(); im.image_r = c.f[0]; im.image_g = c.f[1]; im.image_b = c.f[2])}},
+        {"ImageTransparency",      {K::Float,  GUI_SET(e.image_style.mut().image_transparency = c.f[0])}},
+        {"Enabled",                {K::Bool,   GUI_SET(e.enabled = c.b)}},
+        {"DisplayOrder",           {K::Int,    GUI_SET(e.display_order = c.i)}},
+        {"IgnoreGuiInset",         {K::Bool,   GUI_SET(e.ignore_gui_inset = c.b)}},
+        {"ResetOnSpawn",           {K::Ignore, nullptr}},
+        {"Active",                 {K::Ignore, nullptr}},
+        {"Selectable",             {K::Ignore, nullptr}},
+        {"Font",                   {K::Ignore, nullptr}},
+        {"AutomaticSize",          {K::Ignore, nullptr}},
+        {"CornerRadius",           {K::UDim,   GUI_SET(e.style.mut().corner_radius = c.f[0])}},
+        {"Thickness",              {K::Float,  GUI_SET(auto& st = e.style.mut(); st.stroke_thickness = c.f[0]; st.has_stroke = true)}},
+        {"Color",                  {K::Color3, GUI_SET(if (e.class_name == "UIStroke") {
+                                                           auto& st = e.style.mut(); st.stroke_r = c.f[0]; st.stroke_g = c.f[1]; st.stroke_b = c.f[2];
+                                                       })}},
+        {"Transparency",           {K::Float,  GUI_SET(if (e.class_name == "UIStroke") e.style.mut().stroke_transparency = c.f[0])}},
+        {"PaddingTop",             {K::UDim,   GUI_SET(e.pad_top = c.f[0])}},
+        {"PaddingBottom",          {K::UDim,   GUI_SET(e.pad_bottom = c.f[0])}},
+        {"PaddingLeft",            {K::UDim,   GUI_SET(e.pad_left = c.f[0])}},
+        {"PaddingRight",           {K::UDim,   GUI_SET(e.pad_right = c.f[0])}},
+        {"Padding",                {K::UDim,   GUI_SET(e.pad_top = c.f[0])}},
+        {"CanvasSize",             {K::UDim2,  GUI_SET(e.canvas_size_y = c.f[3])}},
+        {"CanvasPosition",         {K::Vec2,   GUI_SET(e.scroll_position = c.f[1])}},
+        {"ScrollingEnabled",       {K::Bool,   GUI_SET(e.scrolling_enabled = c.b)}},
     };
+    return table;
+}
 
-    auto read_vec2 = [L](int idx, float& x, float& y) {
-        if (lua_istable(L, idx)) {
-            lua_getfield(L, idx, "X"); x = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-            lua_getfield(L, idx, "Y"); y = static_cast<float>(lua_tonumber(L, -1)); lua_pop(L, 1);
-        }
+// Instance __newindex rules where they differ from the bridge's
+static const std::unordered_map<std::string, GuiPropSpec>& gui_instance_overrides() {
+    using K = GuiValueKind;
+    static const std::unordered_map<std::string, GuiPropSpec> table = {
+        {"Thickness",    {K::Float,  GUI_SET(e.style.mut().stroke_thickness = c.f[0])}},
+        {"Color",        {K::Color3, GUI_SET(auto& st = e.style.mut(); st.stroke_r = c.f[0]; st.stroke_g = c.f[1]; st.stroke_b = c.f[2])}},
+        {"Transparency", {K::Float,  GUI_SET(e.style.mut().stroke_transparency = c.f[0])}},
+        {"CanvasSize",   {K::UDim2,  GUI_SET(e.canvas_size_y = c.f[2] * 1000 + c.f[3])}},
     };
+    return table;
+}
 
-    Overlay::instance().update_gui_element(id, [&](GuiElement& elem) {
-        if (k == "Visible") elem.visible = lua_toboolean(L, 3);
-        else if (k == "Name") { if (lua_isstring(L, 3)) elem.name = lua_tostring(L, 3); }
-        else if (k == "BackgroundColor3") read_color3(3, elem.bg_r, elem.bg_g, elem.bg_b);
-        else if (k == "BackgroundTransparency") elem.bg_transparency = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "BorderColor3") read_color3(3, elem.border_r, elem.border_g, elem.border_b);
-        else if (k == "BorderSizePixel") elem.border_size = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "Size") read_udim2(3, elem.size_x_scale, elem.size_x_offset, elem.size_y_scale, elem.size_y_offset);
-        else if (k == "Position") read_udim2(3, elem.pos_x_scale, elem.pos_x_offset, elem.pos_y_scale, elem.pos_y_offset);
-        else if (k == "AnchorPoint") read_vec2(3, elem.anchor_x, elem.anchor_y);
-        else if (k == "Rotation") elem.rotation = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "ClipsDescendants") elem.clips_descendants = lua_toboolean(L, 3);
-        else if (k == "ZIndex") elem.z_index = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "LayoutOrder") elem.layout_order = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "Text") { if (lua_isstring(L, 3)) elem.text = lua_tostring(L, 3); }
-        else if (k == "TextColor3") read_color3(3, elem.text_r, elem.text_g, elem.text_b);
-        else if (k == "TextSize") elem.text_size = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "TextTransparency") elem.text_transparency = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "TextStrokeTransparency") elem.text_stroke_transparency = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "TextStrokeColor3") read_color3(3, elem.text_stroke_r, elem.text_stroke_g, elem.text_stroke_b);
-        else if (k == "TextWrapped") elem.text_wrapped = lua_toboolean(L, 3);
-        else if (k == "TextScaled") elem.text_scaled = lua_toboolean(L, 3);
-        else if (k == "RichText") elem.rich_text = lua_toboolean(L, 3);
-        else if (k == "TextXAlignment") {
-            // Handle Enum value
-            if (lua_istable(L, 3)) {
-                lua_getfield(L, 3, "Value");
-                if (lua_isnumber(L, -1)) elem.text_x_alignment = static_cast<int>(lua_tointeger(L, -1));
-                lua_pop(L, 1);
-                lua_getfield(L, 3, "Name");
-                if (lua_isstring(L, -1)) {
-                    std::string n = lua_tostring(L, -1);
-                    if (n == "Left") elem.text_x_alignment = 0;
-                    else if (n == "Center") elem.text_x_alignment = 1;
-                    else if (n == "Right") elem.text_x_alignment = 2;
-                }
-                lua_pop(L, 1);
-            } else if (lua_isnumber(L, 3)) {
-                elem.text_x_alignment = static_cast<int>(lua_tointeger(L, 3));
-            }
-        }
-        else if (k == "TextYAlignment") {
-            if (lua_istable(L, 3)) {
-                lua_getfield(L, 3, "Name");
-                if (lua_isstring(L, -1)) {
-                    std::string n = lua_tostring(L, -1);
-                    if (n == "Top") elem.text_y_alignment = 0;
-                    else if (n == "Center") elem.text_y_alignment = 1;
-                    else if (n == "Bottom") elem.text_y_alignment = 2;
-                }
-                lua_pop(L, 1);
-            } else if (lua_isnumber(L, 3)) {
-                elem.text_y_alignment = static_cast<int>(lua_tointeger(L, 3));
-            }
-        }
-        else if (k == "Image") { if (lua_isstring(L, 3)) elem.image = lua_tostring(L, 3); }
-        else if (k == "ImageColor3") read_color3(3, elem.image_r, elem.image_g, elem.image_b);
-        else if (k == "ImageTransparency") elem.image_transparency = static_cast<float>(lua_tonumber(L, 3));
-        else if (k == "Enabled") elem.enabled = lua_toboolean(L, 3);
-        else if (k == "DisplayOrder") elem.display_order = static_cast<int>(lua_tointeger(L, 3));
-        else if (k == "IgnoreGuiInset") elem.ignore_gui_inset = lua_toboolean(L, 3);
-        else if (k == "ResetOnSpawn") { /* accepted, no effect */ }
-        else if (k == "Active") { /* accepted, no effect in overlay */ }
-        else if (k == "Selectable") { /* accepted, no effect in overlay */ }
-        else if (k == "Font") { /* accepted, future: map font enum */ }
-        else if (k == "AutomaticSize") { /* accepted, future: auto sizing */ }
-        else if (k == "CornerRadius") {
-            // UICorner's CornerRadius is a UDim
-            elem.corner_radius = read_udim(3);
-        }
-        else if (k == "Thickness") {
-            // UIStroke
-            elem.stroke_thickness = static_cast<float>(lua_tonumber(L, 3));
-            elem.has_stroke = true;
-        }
-        else if (k == "Color") {
-            // UIStroke Color or UIGradient - context dependent
-            // For UIStroke applied to parent:
-            if (elem.class_name == "UIStroke") {
-                read_color3(3, elem.stroke_r, elem.stroke_g, elem.stroke_b);
-            }
-        }
-        else if (k == "Transparency" && elem.class_name == "UIStroke") {
-            elem.stroke_transparency = static_cast<float>(lua_tonumber(L, 3));
-        }
-        else if (k == "PaddingTop") elem.pad_top = read_udim(3);
-        else if (k == "PaddingBottom") elem.pad_bottom = read_udim(3);
-        else if (k == "PaddingLeft") elem.pad_left = read_udim(3);
-        else if (k == "PaddingRight") elem.pad_right = read_udim(3);
-        else if (k == "Padding") {
-            // UIListLayout Padding (UDim)
-            float p = read_udim(3);
-            elem.pad_top = p;
-        }
-        else if (k == "CanvasSize") {
-            float dummy_xs = 0, dummy_xo = 0, ys = 0, yo = 0;  // ← initialized
-            read_udim2(3, dummy_xs, dummy_xo, ys, yo);
-            elem.canvas_size_y = yo;
-        }
-        else if (k == "CanvasPosition") {
-            float sx = 0, sy = 0;  // ← initialized
-            read_vec2(3, sx, sy);
-            elem.scroll_position = sy;
+#undef GUI_SET
+
+bool Environment::parse_gui_property(lua_State* L, const std::string& key, int idx, GuiCommand& out,
+                                     GuiPropSource source) {
+    static const char* const x_names[3] = {"Left", "Center", "Right"};
+    static const char* const y_names[3] = {"Top", "Center", "Bottom"};
+
+    const GuiPropSpec* found = nullptr;
+    bool instance = source == GuiPropSource::Instance;
+    if (instance) {
+        auto ov = gui_instance_overrides().find(key);
+        if (ov != gui_instance_overrides().end()) found = &ov->second;
+    }
+    if (!found) {
+        auto it = gui_prop_table().find(key);
+        if (it == gui_prop_table().end()) return false;  // silently accept unknown properties
+        found = &it->second;
+    }
+
+    const GuiPropSpec& spec = *found;
+    // The Instance API leaves the property alone when handed a non-number
+    // (a UDim may also be a table)
+    if (instance) {
+        bool number = lua_isnumber(L, idx);
+        if ((spec.kind == GuiValueKind::Int || spec.kind == GuiValueKind::Float) && !number)
+            return false;
+        if (spec.kind == GuiValueKind::UDim && !number && !lua_istable(L, idx))
+            return false;
+    }
+
+    switch (spec.kind) {
+        case GuiValueKind::Bool:   out.b = lua_toboolean(L, idx); break;
+        case GuiValueKind::Int:    out.i = static_cast<int>(lua_tointeger(L, idx)); break;
+        case GuiValueKind::Float:  out.f[0] = static_cast<float>(lua_tonumber(L, idx)); break;
+        case GuiValueKind::UDim:   out.f[0] = gui_read_udim(L, idx); break;
+        case GuiValueKind::Color3: if (!gui_read_color3(L, idx, out.f)) return false; break;
+        case GuiValueKind::UDim2:  if (!gui_read_udim2(L, idx, out.f)) return false; break;
+        case GuiValueKind::Vec2:   if (!gui_read_vec2(L, idx, out.f)) return false; break;
+        case GuiValueKind::AlignX: if (!gui_read_alignment(L, idx, x_names, out.i)) return false; break;
+        case GuiValueKind::AlignY: if (!gui_read_alignment(L, idx, y_names, out.i)) return false; break;
+        case GuiValueKind::String:
+            if (!lua_isstring(L, idx)) return false;
+            out.s = lua_tostring(L, idx);
+            break;
+        case GuiValueKind::Ignore: return false;
+    }
+    out.op = GuiCommand::Op::Set;
+    out.set = spec.set;
+    return true;
+}
+
+static int lua_gui_set(lua_State* L) {
+    GuiCommand cmd;
+    cmd.id = static_cast<int>(luaL_checkinteger(L, 1));
+    std::string k = luaL_checkstring(L, 2);
+    if (Environment::parse_gui_property(L, k, 3, cmd))
+        Overlay::instance().push_gui_command(std::move(cmd));
+    return 0;
+}
+
+// GUI half of the Drawing.batch / Instance:SetProperties command buffer.
+static int lua_gui_apply(lua_State* L) {
+    luaL_checktype(L, 1, LUA_TTABLE);
+    int n = lua_objlen(L, 1);
+    auto& overlay = Overlay::instance();
+    for (int i = 1; i + 2 <= n; i += 3) {
+        lua_rawgeti(L, 1, i);
+        lua_rawgeti(L, 1, i + 1);
+        lua_rawgeti(L, 1, i + 2);
+        int top = lua_gettop(L);
+        if (lua_isstring(L, top - 1)) {
+            GuiCommand cmd;
+            cmd.id = static_cast<int>(lua_tointeger(L, top - 2));
+            if (Environment::parse_gui_property(L, lua_tostring(L, top - 1), top, cmd))
+                overlay.push_gui_command(std::move(cmd));
         }
-        else if (k == "ScrollingEnabled") elem.scrolling_enabled = lua_toboolean(L, 3);
-        // Silently accept other properties without error
-    });
+        lua_pop(L, 3);
+    }
     return 0;
 }
 
@@ -1040,6 +1249,57 @@ local _gui_bridge_props={
     HorizontalAlignment=true,VerticalAlignment=true,
 }
 
+-- Drawing.batch / :Set / :SetProperties queue bridge writes here as flat
+-- {id,key,value,...} lists and flush each list with one call (one lock).
+-- Batches belong to the coroutine that opened them, so a batch that yields
+-- doesn't collect another coroutine's writes.
+local _bridge_batches=setmetatable({},{__mode="k"})
+local function _bridge_current()
+    return _bridge_batches[coroutine.running()]
+end
+-- Applies both lists; returns the first setter error, if any
+local function _bridge_flush(b)
+    local err
+    if #b.draw>0 and _oss_drawing_apply then
+        local ok,e=pcall(_oss_drawing_apply,b.draw)
+        if not ok then err=e end
+    end
+    if #b.gui>0 and _oss_gui_apply then
+        local ok,e=pcall(_oss_gui_apply,b.gui)
+        if not ok and not err then err=e end
+    end
+    return err
+end
+local function _bridge_sync()
+    local co=coroutine.running()
+    local b=_bridge_batches[co]
+    if b then
+        _bridge_batches[co]={draw={},gui={}}
+        local err=_bridge_flush(b)
+        if err then error(err,0) end
+    end
+end
+local function _bridge_batched(fn,...)
+    local co=coroutine.running()
+    if _bridge_batches[co] then return fn(...) end
+    _bridge_batches[co]={draw={},gui={}}
+    local ok,err=pcall(fn,...)
+    local b=_bridge_batches[co]
+    _bridge_batches[co]=nil
+    local flush_err=_bridge_flush(b)
+    if not ok then error(err,0) end
+    if flush_err then error(flush_err,0) end
+end
+local function _gui_forward(gid,key,value)
+    local b=_bridge_current()
+    if b then
+        local q=b.gui
+        q[#q+1]=gid;q[#q+1]=key;q[#q+1]=value
+    elseif _oss_gui_set then
+        pcall(_oss_gui_set,gid,key,value)
+    end
+end
+
 local function make_instance(class_name,name,parent)
     local children={}
     local properties={}
@@ -1130,6 +1390,13 @@ local function make_instance(class_name,name,parent)
             end
         end
         if key=="Clone" then return function() return make_instance(class_name,name,nil) end end
+        if key=="SetProperties" then
+            return function(_,props)
+                _bridge_batched(function()
+                    for k,v in pairs(props) do mt.__newindex(inst,k,v) end
+                end)
+            end
+        end
         if key=="Destroy" or key=="Remove" then
             return function()
                 if is_gui and gui_id>0 and _oss_gui_remove then
@@ -1210,7 +1477,7 @@ local function make_instance(class_name,name,parent)
         if key=="Name" then
             name=value
             if is_gui and gui_id>0 and _oss_gui_set then
-                pcall(_oss_gui_set, gui_id, "Name", value)
+                _gui_forward(gui_id, "Name", value)
             end
         elseif key=="Parent" then
             -- Remove from old parent's children list
@@ -1234,13 +1501,14 @@ local function make_instance(class_name,name,parent)
                     local pgid=value._gui_id
                     if pgid and pgid>0 then parent_gui_id=pgid end
                 end
+                _bridge_sync()
                 pcall(_oss_gui_set_parent, gui_id, parent_gui_id)
             end
         else
             properties[key]=value
             -- Bridge: forward GUI property changes to overlay
             if is_gui and gui_id>0 and _oss_gui_set and _gui_bridge_props[key] then
-                pcall(_oss_gui_set, gui_id, key, value)
+                _gui_forward(gui_id, key, value)
             end
             -- If this is a UICorner/UIStroke/UIPadding being modified,
             -- also update the parent in the overlay
@@ -1248,14 +1516,14 @@ local function make_instance(class_name,name,parent)
                 local pgid=parent._gui_id
                 if pgid and pgid>0 and _oss_gui_set then
                     if class_name=="UICorner" and key=="CornerRadius" then
-                        pcall(_oss_gui_set, pgid, "CornerRadius", value)
+                        _gui_forward(pgid, "CornerRadius", value)
                     elseif class_name=="UIStroke" then
                         if key=="Thickness" or key=="Color" or key=="Transparency" then
-                            pcall(_oss_gui_set, pgid, key, value)
+                            _gui_forward(pgid, key, value)
                         end
                     elseif class_name=="UIPadding" then
                         if key=="PaddingTop" or key=="PaddingBottom" or key=="PaddingLeft" or key=="PaddingRight" then
-                            pcall(_oss_gui_set, pgid, key, value)
+                            _gui_forward(pgid, key, value)
                         end
                     end
                 end
@@ -1445,7 +1713,8 @@ function InstanceModule.new(class_name,parent)
 end
 
 Drawing={Fonts={UI=0,System=1,Plex=2,Monospace=3}}
-local _drawing_type_map={Line=0,Text=1,Circle=2,Square=3,Triangle=4,Quad=5,Image=6}
+local _drawing_type_map={Line=0,Text=1,Circle=2,Square=3,Triangle=4,Quad=5,Image=6,
+    LineList=7,Polyline=8,PointCloud=9,RectList=10}
 
 function Drawing.new(class_name)
     class_name=class_name or "Line"
@@ -1465,11 +1734,19 @@ function Drawing.new(class_name)
         PointA=Vector2.new(0,0),PointB=Vector2.new(0,0),
         PointC=Vector2.new(0,0),PointD=Vector2.new(0,0),
         Data="",Rounding=0,
+        Points={},Closed=false,
     }
     local mt={
         __type="Drawing",
         __tostring=function() return "Drawing" end,
-        __index=function(_,key)
+        __index=function(self,key)
+            if key=="Set" then
+                return function(_,props)
+                    _bridge_batched(function()
+                        for k,v in pairs(props) do self[k]=v end
+                    end)
+                end
+            end
             if key=="Remove" or key=="Destroy" then
                 return function()
                     if data._removed then return end
@@ -1484,11 +1761,21 @@ function Drawing.new(class_name)
         __newindex=function(_,key,value)
             if data._removed then return end
             data[key]=value
-            if _oss_drawing_set and id>0 then pcall(_oss_drawing_set,id,key,value) end
+            if id<=0 then return end
+            local b=_bridge_current()
+            if b then
+                local q=b.draw
+                q[#q+1]=id;q[#q+1]=key;q[#q+1]=value
+            elseif _oss_drawing_set then
+                pcall(_oss_drawing_set,id,key,value)
+            end
         end,
     }
     return setmetatable({},mt)
 end
+function Drawing.batch(fn)
+    _bridge_batched(fn)
+end
 function Drawing.clear()
     if _oss_drawing_clear then _oss_drawing_clear() end
 end
@@ -2286,10 +2573,12 @@ void Environment::setup(lua_State* L) {
     lua_pushcfunction(L, lua_drawing_new_bridge);    lua_setglobal(L, "_oss_drawing_new");
     lua_pushcfunction(L, lua_drawing_set_bridge);    lua_setglobal(L, "_oss_drawing_set");
     lua_pushcfunction(L, lua_drawing_remove_bridge); lua_setglobal(L, "_oss_drawing_remove");
+    lua_pushcfunction(L, lua_drawing_apply_bridge);  lua_setglobal(L, "_oss_drawing_apply");
 
     // GUI bridge
     lua_pushcfunction(L, lua_gui_create);          lua_setglobal(L, "_oss_gui_create");
     lua_pushcfunction(L, lua_gui_set);             lua_setglobal(L, "_oss_gui_set");
+    lua_pushcfunction(L, lua_gui_apply);           lua_setglobal(L, "_oss_gui_apply");
     lua_pushcfunction(L, lua_gui_set_parent);      lua_setglobal(L, "_oss_gui_set_parent");
     lua_pushcfunction(L, lua_gui_remove);          lua_setglobal(L, "_oss_gui_remove");
     lua_pushcfunction(L, lua_gui_clear);           lua_setglobal(L, "_oss_gui_clear");
@@ -7,6 +7,7 @@ struct lua_State;
 namespace oss {
 
 class LuaEngine;
+struct GuiCommand;
 
 class Environment {
 public:
@@ -16,6 +17,21 @@ public:
     void setup(LuaEngine& engine);
     void setup(lua_State* L);
 
+    // Which API a GUI write came from. The two had different rules before
+    // they shared a decoder, and scripts rely on both:
+    //  Bridge   - _oss_gui_set/_oss_gui_apply: non-numbers write 0, Color and
+    //             Transparency only touch UIStroke elements, CanvasSize keeps
+    //             the Y offset.
+    //  Instance - Closures' Instance __newindex: non-numbers are ignored,
+    //             Color/Transparency/Thickness set the stroke of any element,
+    //             CanvasSize is Y scale * 1000 + Y offset.
+    enum class GuiPropSource { Bridge, Instance };
+
+    // Decodes a GUI property write at stack index idx into cmd (op = Set).
+    // Returns false for unknown/ignored keys or values of the wrong type.
+    static bool parse_gui_property(lua_State* L, const std::string& key, int idx, GuiCommand& cmd,
+                                   GuiPropSource source = GuiPropSource::Bridge);
+
 private:
     Environment() = default;
 
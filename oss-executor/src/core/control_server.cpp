@@ -0,0 +1,473 @@
+#include "control_server.hpp"
+#include "executor.hpp"
+#include "injection.hpp"
+#include "utils/logger.hpp"
+#include "utils/config.hpp"
+#include "utils/metrics.hpp"
+
+#include <nlohmann/json.hpp>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace oss {
+
+struct ControlClient {
+    int               fd = -1;
+    std::mutex        write_mutex;
+    std::atomic<bool> watching{false};
+    std::atomic<bool> open{true};
+    std::thread       thread;
+
+    // Jobs this client submitted, for "cancel" by id
+    std::mutex                                           jobs_mutex;
+    std::unordered_map<uint64_t, std::weak_ptr<ExecutionJob>> jobs;
+};
+
+using Client = ControlClient;
+
+static bool read_exact(int fd, void* buf, size_t len) {
+    auto* p = static_cast<char*>(buf);
+    while (len > 0) {
+        ssize_t n = ::read(fd, p, len);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool write_exact(int fd, const char* p, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static bool send_frame(Client& client, const nlohmann::json& msg) {
+    std::string body = msg.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    uint32_t len = static_cast<uint32_t>(body.size());
+    unsigned char hdr[4] = {
+        static_cast<unsigned char>(len >> 24), static_cast<unsigned char>(len >> 16),
+        static_cast<unsigned char>(len >> 8),  static_cast<unsigned char>(len),
+    };
+
+    std::lock_guard<std::mutex> lock(client.write_mutex);
+    if (!client.open.load(std::memory_order_acquire)) return false;
+    return write_exact(client.fd, reinterpret_cast<const char*>(hdr), sizeof(hdr)) &&
+           write_exact(client.fd, body.data(), body.size());
+}
+
+// Hex string: JSON clients can't hold 64-bit integers exactly
+static std::string trace_hex(uint64_t trace_id) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(trace_id));
+    return buf;
+}
+
+static nlohmann::json result_json(const ExecutionResult& r) {
+    return {
+        {"name", r.script_name},
+        {"success", r.success},
+        {"cancelled", r.cancelled},
+        {"error", r.error},
+        {"execution_ms", r.execution_time_ms},
+        {"queue_ms", r.queue_ms},
+        {"compile_ms", r.compile_ms},
+        {"transfer_ms", r.transfer_ms},
+        {"run_ms", r.run_ms},
+        {"run_reported", r.run_reported},
+        {"trace_id", trace_hex(r.trace_id)},
+        {"trace_path", r.trace_path},
+    };
+}
+
+static nlohmann::json summary_json(const LatencySummary& s) {
+    return {{"p50_ms", s.p50_ms}, {"p99_ms", s.p99_ms}};
+}
+
+// Builds the request for one script and wires its events back to the client
+static ScriptRequest make_request(const std::shared_ptr<Client>& client,
+                                  const nlohmann::json& req, const nlohmann::json& tag) {
+    ScriptRequest request;
+    request.source       = req.value("source", "");
+    request.name         = req.value("name", "control");
+    request.priority     = req.value("priority", 0);
+    request.compile_only = req.value("compile_only", false);
+
+    std::weak_ptr<Client> weak = client;
+    request.on_stage = [weak, tag](ExecutionStage stage) {
+        if (stage == ExecutionStage::Done) return;
+        if (auto c = weak.lock())
+            send_frame(*c, {{"event", "stage"}, {"id", tag}, {"stage", execution_stage_name(stage)}});
+    };
+    request.on_done = [weak, tag](const ExecutionResult& result) {
+        if (auto c = weak.lock()) {
+            nlohmann::json msg = result_json(result);
+            msg["event"] = "done";
+            msg["id"] = tag;
+            send_frame(*c, msg);
+        }
+    };
+    return request;
+}
+
+static void track_job(Client& client, const ExecutionHandle& job) {
+    std::lock_guard<std::mutex> lock(client.jobs_mutex);
+    for (auto it = client.jobs.begin(); it != client.jobs.end();) {
+        if (it->second.expired()) it = client.jobs.erase(it);
+        else ++it;
+    }
+    client.jobs.emplace(job->id, job);
+}
+
+static nlohmann::json handle_request(const std::shared_ptr<Client>& client,
+                                     const nlohmann::json& req) {
+    auto& exec = Executor::instance();
+    auto& inj  = Injection::instance();
+    nlohmann::json tag = req.contains("id") ? req["id"] : nlohmann::json();
+    std::string op = req.value("op", "");
+    nlohmann::json reply = {{"id", tag}, {"ok", true}};
+
+    if (op == "submit" || op == "submit_file") {
+        ScriptRequest request = make_request(client, req, tag);
+        if (op == "submit_file") {
+            std::string path = req.value("path", "");
+            std::ifstream in(path, std::ios::binary);
+            if (!in.is_open()) return {{"id", tag}, {"ok", false}, {"error", "cannot open " + path}};
+            request.source.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            if (!req.contains("name")) request.name = std::filesystem::path(path).filename().string();
+        }
+        if (request.source.empty()) return {{"id", tag}, {"ok", false}, {"error", "empty script"}};
+
+        auto job = exec.submit(std::move(request));
+        track_job(*client, job);
+        reply["job"]  = job->id;
+        reply["lane"] = execution_lane_name(job->lane);
+    } else if (op == "submit_batch") {
+        const auto& scripts = req.contains("scripts") ? req["scripts"] : nlohmann::json::array();
+        if (!scripts.is_array()) return {{"id", tag}, {"ok", false}, {"error", "scripts must be an array"}};
+
+        std::vector<ScriptRequest> batch;
+        batch.reserve(scripts.size());
+        for (size_t i = 0; i < scripts.size(); i++) {
+            // Events carry [id, index] so the client can match them up
+            batch.push_back(make_request(client, scripts[i], nlohmann::json::array({tag, i})));
+        }
+        nlohmann::json ids = nlohmann::json::array();
+        for (auto& job : exec.enqueue_batch(std::move(batch))) {
+            track_job(*client, job);
+            ids.push_back(job->id);
+        }
+        reply["jobs"] = std::move(ids);
+    } else if (op == "cancel") {
+        if (req.contains("job")) {
+            ExecutionHandle job;
+            {
+                std::lock_guard<std::mutex> lock(client->jobs_mutex);
+                auto it = client->jobs.find(req["job"].get<uint64_t>());
+                if (it != client->jobs.end()) job = it->second.lock();
+            }
+            if (!job) return {{"id", tag}, {"ok", false}, {"error", "unknown job"}};
+            exec.cancel(job);
+        } else {
+            exec.cancel_execution();
+        }
+    } else if (op == "status") {
+        reply["initialized"]    = exec.is_initialized();
+        reply["executing"]      = exec.is_executing();
+        reply["attached"]       = inj.is_attached();
+        reply["payload_loaded"] = inj.is_payload_loaded();
+        reply["pid"]            = inj.target_pid();
+        nlohmann::json lanes;
+        for (size_t i = 0; i < EXECUTION_LANE_COUNT; i++) {
+            auto lane = static_cast<ExecutionLane>(i);
+            lanes[execution_lane_name(lane)] = exec.lane_depth(lane);
+        }
+        reply["lanes"] = std::move(lanes);
+    } else if (op == "history") {
+        nlohmann::json items = nlohmann::json::array();
+        for (const auto& r : exec.get_history()) items.push_back(result_json(r));
+        reply["history"] = std::move(items);
+    } else if (op == "latency") {
+        auto lat = exec.latency();
+        reply["samples"]  = lat.samples;
+        reply["queue"]    = summary_json(lat.queue);
+        reply["compile"]  = summary_json(lat.compile);
+        reply["transfer"] = summary_json(lat.transfer);
+        reply["run"]      = summary_json(lat.run);
+        reply["total"]    = summary_json(lat.total);
+    } else if (op == "trace") {
+        auto id = std::strtoull(req.value("trace_id", std::string()).c_str(), nullptr, 16);
+        std::string text = id ? exec.execution_trace(id) : std::string();
+        if (text.empty())
+            return {{"id", tag}, {"ok", false}, {"error", "unknown or evicted trace"}};
+        reply["trace"] = nlohmann::json::parse(text);
+    } else if (op == "metrics") {
+        reply["text"] = Metrics::instance().prometheus_text();
+    } else if (op == "log_level") {
+        auto level = spdlog::level::from_str(req.value("level", std::string()));
+        if (level == spdlog::level::off && req.value("level", std::string()) != "off")
+            return {{"id", tag}, {"ok", false}, {"error", "unknown level"}};
+        Logger::set_level(req.value("subsystem", std::string()), level);
+    } else if (op == "attach") {
+        // Blocks this client only; scanning can take several seconds
+        reply["ok"]       = inj.inject();
+        reply["vm_found"] = inj.vm_found();
+        reply["pid"]      = inj.target_pid();
+    } else if (op == "detach") {
+        reply["ok"] = inj.detach();
+    } else if (op == "watch") {
+        client->watching.store(req.value("enable", true), std::memory_order_release);
+    } else if (op == "shutdown") {
+        LOG_INFO("Shutdown requested over control socket");
+        ::kill(::getpid(), SIGTERM);
+    } else {
+        return {{"id", tag}, {"ok", false}, {"error", "unknown op '" + op + "'"}};
+    }
+    return reply;
+}
+
+ControlServer& ControlServer::instance() {
+    static ControlServer inst;
+    return inst;
+}
+
+ControlServer::~ControlServer() {
+    stop();
+}
+
+bool ControlServer::start(const std::string& socket_path) {
+    if (running_.load(std::memory_order_acquire)) return true;
+
+    struct sockaddr_un addr{};
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        LOG_ERROR("Control socket path too long: {}", socket_path);
+        return false;
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        LOG_ERROR("Control socket: {}", strerror(errno));
+        return false;
+    }
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    ::unlink(socket_path.c_str());
+    mode_t old_mask = ::umask(0077);
+    int rc = ::bind(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    ::umask(old_mask);
+    if (rc != 0 || ::listen(fd, 64) != 0) {
+        LOG_ERROR("Control socket bind/listen on {} failed: {}", socket_path, strerror(errno));
+        ::close(fd);
+        return false;
+    }
+    if (::pipe2(wake_pipe_, O_CLOEXEC) != 0) {
+        ::close(fd);
+        ::unlink(socket_path.c_str());
+        return false;
+    }
+
+    listen_fd_   = fd;
+    socket_path_ = socket_path;
+    running_.store(true, std::memory_order_release);
+    accept_thread_ = std::thread(&ControlServer::accept_loop, this);
+    LOG_INFO("Control socket listening on {}", socket_path);
+    return true;
+}
+
+void ControlServer::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+
+    char b = 0;
+    ssize_t unused = ::write(wake_pipe_[1], &b, 1);
+    (void)unused;
+    if (accept_thread_.joinable()) accept_thread_.join();
+
+    std::list<std::shared_ptr<Client>> clients;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        clients.swap(clients_);
+    }
+    // serve() closes its fd under write_mutex; once !open the number may
+    // already belong to some other file
+    for (auto& c : clients) {
+        std::lock_guard<std::mutex> lock(c->write_mutex);
+        if (c->open.load(std::memory_order_acquire)) ::shutdown(c->fd, SHUT_RDWR);
+    }
+    for (auto& c : clients) {
+        if (c->thread.joinable()) c->thread.join();
+    }
+
+    ::close(listen_fd_);
+    ::close(wake_pipe_[0]);
+    ::close(wake_pipe_[1]);
+    listen_fd_ = wake_pipe_[0] = wake_pipe_[1] = -1;
+    ::unlink(socket_path_.c_str());
+    LOG_INFO("Control socket closed");
+}
+
+void ControlServer::broadcast(const char* event, const std::string& text) {
+    std::vector<std::shared_ptr<Client>> targets;
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto& c : clients_) {
+            if (c->watching.load(std::memory_order_acquire)) targets.push_back(c);
+        }
+    }
+    if (targets.empty()) return;
+
+    nlohmann::json msg = {{"event", event}, {"text", text}};
+    for (auto& c : targets) send_frame(*c, msg);
+}
+
+void ControlServer::accept_loop() {
+    struct pollfd fds[2] = {
+        {listen_fd_, POLLIN, 0},
+        {wake_pipe_[0], POLLIN, 0},
+    };
+
+    while (running_.load(std::memory_order_acquire)) {
+        int n = ::poll(fds, 2, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("Control socket poll failed: {}", strerror(errno));
+            break;
+        }
+        if (fds[1].revents) break;
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        int cfd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (cfd < 0) continue;
+
+        // A stalled reader must not wedge the lane worker delivering its events
+        struct timeval tv{};
+        tv.tv_sec = 2;
+        setsockopt(cfd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+        auto client = std::make_shared<Client>();
+        client->fd = cfd;
+
+        std::lock_guard<std::mutex> lock(clients_mutex_);
+        for (auto it = clients_.begin(); it != clients_.end();) {
+            if (!(*it)->open.load(std::memory_order_acquire)) {
+                if ((*it)->thread.joinable()) (*it)->thread.join();
+                it = clients_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        client->thread = std::thread(&ControlServer::serve, this, client);
+        clients_.push_back(std::move(client));
+    }
+}
+
+void ControlServer::serve(std::shared_ptr<Client> client) {
+    LOG_DEBUG("Control client connected (fd {})", client->fd);
+    std::string body;
+
+    while (running_.load(std::memory_order_acquire)) {
+        unsigned char hdr[4];
+        if (!read_exact(client->fd, hdr, sizeof(hdr))) break;
+        uint32_t len = (uint32_t(hdr[0]) << 24) | (uint32_t(hdr[1]) << 16) |
+                       (uint32_t(hdr[2]) << 8)  |  uint32_t(hdr[3]);
+        if (len > MAX_FRAME_BYTES) {
+            send_frame(*client, {{"ok", false}, {"error", "frame too large"}});
+            break;
+        }
+        body.resize(len);
+        if (len > 0 && !read_exact(client->fd, body.data(), len)) break;
+
+        nlohmann::json req = nlohmann::json::parse(body, nullptr, false);
+        nlohmann::json reply;
+        if (req.is_discarded() || !req.is_object()) {
+            reply = {{"ok", false}, {"error", "malformed request"}};
+        } else {
+            try {
+                reply = handle_request(client, req);
+            } catch (const std::exception& e) {
+                reply = {{"id", req.contains("id") ? req["id"] : nlohmann::json()},
+                         {"ok", false}, {"error", e.what()}};
+            }
+        }
+        if (!send_frame(*client, reply)) break;
+    }
+
+    client->watching.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(client->write_mutex);
+        client->open.store(false, std::memory_order_release);
+        ::close(client->fd);
+    }
+    LOG_DEBUG("Control client disconnected");
+}
+
+// ── Headless mode ──
+
+int run_headless(const std::string& socket_path) {
+    auto& exec   = Executor::instance();
+    auto& server = ControlServer::instance();
+
+    exec.set_output_callback([](const std::string& msg) {
+        LOG_INFO("[output] {}", msg);
+        ControlServer::instance().broadcast("output", msg);
+    });
+    exec.set_error_callback([](const std::string& msg) {
+        LOG_ERROR("[script] {}", msg);
+        ControlServer::instance().broadcast("error", msg);
+    });
+    exec.set_status_callback([](const std::string& msg) {
+        LOG_INFO("[status] {}", msg);
+        ControlServer::instance().broadcast("status", msg);
+    });
+
+    if (!server.start(socket_path)) return 1;
+
+    // Optional node_exporter textfile, refreshed while we wait for a signal;
+    // re-read each period so a config reload can switch it on or off
+    static const auto kTextfile = Config::key<std::string>("metrics.textfile");
+
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    struct timespec period{};
+    period.tv_sec = 5;
+    int sig;
+    for (;;) {
+        sig = sigtimedwait(&set, nullptr, &period);
+        if (sig > 0) break;
+        if (sig < 0 && errno != EAGAIN && errno != EINTR) break;
+        if (const std::string& textfile = kTextfile.get(); !textfile.empty())
+            Metrics::instance().write_textfile(textfile);
+    }
+    LOG_INFO("Headless mode stopping (signal {})", sig);
+
+    server.stop();
+    return 0;
+}
+
+} // namespace oss
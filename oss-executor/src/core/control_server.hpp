@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace oss {
+
+struct ControlClient;
+
+// Local control API for headless mode. Every message in either direction is
+// a 4-byte big-endian length followed by that many bytes of UTF-8 JSON.
+//
+// Requests carry an "op" and an optional client-chosen "id" that is echoed
+// on the reply and on any events the request produces:
+//   submit        {source, name?, priority?, compile_only?}  -> {job, lane}
+//   submit_file   {path, priority?}                          -> {job, lane}
+//   submit_batch  {scripts: [{source, name?, priority?}...]} -> {jobs}
+//   cancel        {job?}   (no job: cancel everything)
+//   status | history | latency
+//   trace         {trace_id} -> {trace} Chrome trace JSON of one execution
+//   metrics       -> {text} in Prometheus exposition format
+//   log_level     {level, subsystem?}  runtime log level, root when no subsystem
+//   attach | detach
+//   watch         {enable?}  stream output/error/status events
+//   shutdown
+// A submitted job later produces {"event":"stage"} and {"event":"done"}.
+class ControlServer {
+public:
+    static ControlServer& instance();
+
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    bool start(const std::string& socket_path);
+    void stop();
+    bool running() const { return running_.load(std::memory_order_acquire); }
+    const std::string& socket_path() const { return socket_path_; }
+
+    // Sends {"event": event, "text": text} to every watching client
+    void broadcast(const char* event, const std::string& text);
+
+    static constexpr uint32_t MAX_FRAME_BYTES = 16 * 1024 * 1024;
+
+private:
+    ControlServer() = default;
+    ~ControlServer();
+
+    void accept_loop();
+    void serve(std::shared_ptr<ControlClient> client);
+
+    std::atomic<bool> running_{false};
+    std::string       socket_path_;
+    int               listen_fd_ = -1;
+    int               wake_pipe_[2] = {-1, -1};
+    std::thread       accept_thread_;
+
+    std::mutex                                clients_mutex_;
+    std::list<std::shared_ptr<ControlClient>> clients_;
+};
+
+// Runs Executor + Injection without GTK, serving the control socket until
+// SIGINT/SIGTERM or a "shutdown" request. The caller blocks both signals
+// before starting any threads.
+int run_headless(const std::string& socket_path);
+
+} // namespace oss
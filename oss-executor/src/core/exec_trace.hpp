@@ -0,0 +1,71 @@
+#pragma once
+
+// Shared between the executor and the payload (built -fno-exceptions, no
+// libstdc++ beyond what it already links), so keep this header POD-only.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace oss {
+
+// A traced source script starts with one comment line carrying its id:
+//   --#oss-trace:0123456789abcdef\n
+// Payloads that predate tracing run it as an ordinary comment.
+constexpr char   TRACE_TAG[]    = "--#oss-trace:";
+constexpr size_t TRACE_TAG_LEN  = sizeof(TRACE_TAG) - 1;
+constexpr size_t TRACE_LINE_LEN = TRACE_TAG_LEN + 16 + 1;
+
+// The payload keeps its most recent spans in a ring and rewrites this file
+// (inside its own mount namespace) after every drain that saw a traced script.
+// It lives in a 0700 directory of the target's user, so nobody else can read
+// the spans or plant a symlink in its place.
+constexpr const char* PAYLOAD_TRACE_DIR_FMT = "/tmp/oss-%u";
+constexpr const char* PAYLOAD_TRACE_FILE    = "payload_trace";
+constexpr size_t      PAYLOAD_SPAN_CAP      = 256;
+
+// Socket clients that sent a traced script keep the connection open; the
+// payload writes this line once the script ran and its spans were flushed.
+constexpr char   PAYLOAD_DONE_LINE[]  = "done\n";
+constexpr size_t PAYLOAD_DONE_LEN     = sizeof(PAYLOAD_DONE_LINE) - 1;
+
+inline void format_trace_dir(unsigned uid, char (&out)[32]) {
+    snprintf(out, sizeof(out), PAYLOAD_TRACE_DIR_FMT, uid);
+}
+
+// Timestamps are CLOCK_MONOTONIC nanoseconds. std::chrono::steady_clock reads
+// the same clock on Linux, so both sides line up without an offset.
+struct PayloadSpan {
+    uint64_t trace_id;
+    uint64_t begin_ns;
+    uint64_t end_ns;
+    char     name[24];
+};
+
+inline void format_trace_line(uint64_t trace_id, char (&out)[TRACE_LINE_LEN]) {
+    static constexpr char hex[] = "0123456789abcdef";
+    memcpy(out, TRACE_TAG, TRACE_TAG_LEN);
+    for (size_t i = 0; i < 16; i++)
+        out[TRACE_TAG_LEN + i] = hex[(trace_id >> (60 - 4 * i)) & 0xf];
+    out[TRACE_LINE_LEN - 1] = '\n';
+}
+
+// Trace id from a leading tag line, or 0 when the script carries none
+inline uint64_t parse_trace_line(const char* data, size_t len) {
+    if (len < TRACE_LINE_LEN || memcmp(data, TRACE_TAG, TRACE_TAG_LEN) != 0 ||
+        data[TRACE_LINE_LEN - 1] != '\n')
+        return 0;
+    uint64_t id = 0;
+    for (size_t i = 0; i < 16; i++) {
+        char c = data[TRACE_TAG_LEN + i];
+        uint64_t v;
+        if (c >= '0' && c <= '9')      v = static_cast<uint64_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') v = static_cast<uint64_t>(c - 'a' + 10);
+        else return 0;
+        id = (id << 4) | v;
+    }
+    return id;
+}
+
+} // namespace oss
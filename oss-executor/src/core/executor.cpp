@@ -1,7 +1,13 @@
 #include "executor.hpp"
+#include "api/environment.hpp"
+#include "api/closures.hpp"
 #include "utils/logger.hpp"
 #include "utils/config.hpp"
+#include "utils/trace.hpp"
+#include "utils/metrics.hpp"
+#include "scripting/script_manager.hpp"
 
+#include <nlohmann/json.hpp>
 #include <filesystem>
 #include <fstream>
 #include <chrono>
@@ -15,15 +21,214 @@
 #include <cstring>
 #include <sys/socket.h>
 #include <sys/un.h>
+#include <poll.h>
 #include <unistd.h>
 #include <luacode.h>
 #include <cstdlib>
+#include <random>
 
 static constexpr const char  ABSTRACT_SOCK_NAME[] = "oss_executor_v2";
 static constexpr const char* PAYLOAD_SOCK_PATH    = "/tmp/oss_executor.sock";
 
 namespace oss {
 
+static const auto kAutoInject = Config::key<bool>("executor.auto_inject", false);
+static const auto kTraceDir   = Config::key<std::string>("trace.executions_dir");
+
+const char* execution_stage_name(ExecutionStage stage) {
+    switch (stage) {
+        case ExecutionStage::Queued:  return "queued";
+        case ExecutionStage::Compile: return "compile";
+        case ExecutionStage::Deliver: return "deliver";
+        case ExecutionStage::Ack:     return "ack";
+        case ExecutionStage::Run:     return "run";
+        case ExecutionStage::Done:    return "done";
+    }
+    return "unknown";
+}
+
+const char* execution_lane_name(ExecutionLane lane) {
+    switch (lane) {
+        case ExecutionLane::Local:   return "local";
+        case ExecutionLane::Remote:  return "remote";
+        case ExecutionLane::Compile: return "compile";
+    }
+    return "unknown";
+}
+
+static void set_stage(ExecutionJob* job, ExecutionStage stage) {
+    if (!job || job->stage.exchange(stage, std::memory_order_acq_rel) == stage) return;
+    job->stage_at[static_cast<size_t>(stage)] = ExecutionJob::Clock::now();
+    if (job->on_stage) job->on_stage(stage);
+}
+
+static double ms_between(ExecutionJob::Clock::time_point a, ExecutionJob::Clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+static ExecutionResult cancelled_result(const ExecutionJob& job) {
+    ExecutionResult result;
+    result.script_name = job.name;
+    result.cancelled   = true;
+    result.queue_ms    = ms_between(job.queued_at, ExecutionJob::Clock::now());
+    return result;
+}
+
+// Each recorded stage lasts until the next recorded one (or until end)
+template<typename Func>
+static void for_each_stage(const ExecutionJob& job, ExecutionJob::Clock::time_point end,
+                           Func&& fn) {
+    constexpr size_t first = static_cast<size_t>(ExecutionStage::Compile);
+    constexpr size_t last  = static_cast<size_t>(ExecutionStage::Run);
+    for (size_t s = first; s <= last; s++) {
+        auto begin = job.stage_at[s];
+        if (begin == ExecutionJob::Clock::time_point{}) continue;
+        auto finish = end;
+        for (size_t n = s + 1; n <= last; n++) {
+            if (job.stage_at[n] != ExecutionJob::Clock::time_point{}) {
+                finish = job.stage_at[n];
+                break;
+            }
+        }
+        fn(static_cast<ExecutionStage>(s), begin, finish);
+    }
+}
+
+static void fill_phase_times(ExecutionResult& result, const ExecutionJob& job,
+                             ExecutionJob::Clock::time_point start,
+                             ExecutionJob::Clock::time_point end) {
+    if (job.queued_at != ExecutionJob::Clock::time_point{})
+        result.queue_ms = ms_between(job.queued_at, start);
+
+    for_each_stage(job, end, [&](ExecutionStage stage, auto begin, auto finish) {
+        double ms = ms_between(begin, finish);
+        switch (stage) {
+            case ExecutionStage::Compile: result.compile_ms  += ms; break;
+            case ExecutionStage::Deliver:
+            case ExecutionStage::Ack:     result.transfer_ms += ms; break;
+            case ExecutionStage::Run:     result.run_ms      += ms; break;
+            default: break;
+        }
+    });
+}
+
+static Counter&   g_executions  = Metrics::instance().counter(
+    "oss_executions_total", "Scripts executed locally or sent to the payload");
+static Counter&   g_exec_failed = Metrics::instance().counter(
+    "oss_execution_failures_total", "Executions that failed to compile, run or deliver");
+static Counter&   g_cache_hits  = Metrics::instance().counter(
+    "oss_bytecode_cache_hits_total", "Compiles served from the bytecode cache");
+static Histogram& g_compile_us  = Metrics::instance().histogram(
+    "oss_compile_time_us", "Luau compile time on bytecode cache misses (microseconds)");
+static Histogram& g_ipc_us      = Metrics::instance().histogram(
+    "oss_ipc_latency_us", "Payload delivery + ack time per remote execution (microseconds)");
+static Histogram& g_queue_us    = Metrics::instance().histogram(
+    "oss_queue_wait_us", "Time jobs spent queued before a lane picked them up (microseconds)");
+
+// Random base: the payload's span ring outlives executor restarts, so ids
+// from an earlier run must not be mistaken for ours.
+static uint64_t new_trace_id() {
+    static std::atomic<uint64_t> next{[] {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) | rd();
+    }()};
+    uint64_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id ? id : next.fetch_add(1, std::memory_order_relaxed);
+}
+
+static std::string trace_hex(uint64_t trace_id) {
+    char buf[17];
+    snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(trace_id));
+    return buf;
+}
+
+static int64_t trace_us(ExecutionJob::Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count();
+}
+
+static std::vector<PayloadSpan> read_payload_spans(const std::string& path, uint64_t trace_id) {
+    std::vector<PayloadSpan> spans;
+    std::ifstream in(path, std::ios::binary);
+    PayloadSpan span{};
+    while (in.read(reinterpret_cast<char*>(&span), sizeof(span))) {
+        if (span.trace_id != trace_id) continue;
+        span.name[sizeof(span.name) - 1] = '\0';
+        spans.push_back(span);
+    }
+    return spans;
+}
+
+// Mirrors the payload's per-user trace directory; the target may run as
+// another uid than we do
+static std::string payload_trace_path(const std::string& prefix, pid_t pid) {
+    uid_t uid = getuid();
+    struct stat st{};
+    if (pid > 0 && ::stat(("/proc/" + std::to_string(pid)).c_str(), &st) == 0)
+        uid = st.st_uid;
+    char dir[32];
+    format_trace_dir(static_cast<unsigned>(uid), dir);
+    return prefix + dir + "/" + PAYLOAD_TRACE_FILE;
+}
+
+// The payload's span for actually running the script, if it reported one
+static const PayloadSpan* find_run_span(const std::vector<PayloadSpan>& spans) {
+    for (const auto& s : spans) {
+        if (strcmp(s.name, "payload_run") == 0 || strcmp(s.name, "payload_run_error") == 0)
+            return &s;
+    }
+    return nullptr;
+}
+
+static ExecutionJob::Clock::time_point payload_time(uint64_t ns) {
+    return ExecutionJob::Clock::time_point(
+        std::chrono::duration_cast<ExecutionJob::Clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+static double percentile(std::vector<float>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
+
+static bool job_cancelled(const ExecutionJob* job) {
+    return job && job->cancelled.load(std::memory_order_acquire);
+}
+
+// Waits for the payload to report a traced script drained and its spans
+// flushed. Payloads that predate the reply just close the connection.
+static bool wait_for_done(int fd, const ExecutionJob* job) {
+    constexpr int TIMEOUT_MS = 2000;
+    constexpr int SLICE_MS   = 50;
+    char   buf[16];
+    size_t got = 0;
+    for (int waited = 0; waited < TIMEOUT_MS && !job_cancelled(job); waited += SLICE_MS) {
+        struct pollfd pfd{fd, POLLIN, 0};
+        int r = ::poll(&pfd, 1, SLICE_MS);
+        if (r < 0 && errno != EINTR) return false;
+        if (r <= 0) continue;
+        ssize_t n = ::read(fd, buf + got, sizeof(buf) - got);
+        if (n <= 0) return false;
+        got += static_cast<size_t>(n);
+        if (got >= PAYLOAD_DONE_LEN)
+            return memcmp(buf, PAYLOAD_DONE_LINE, PAYLOAD_DONE_LEN) == 0;
+    }
+    return false;
+}
+
+// Full script API on top of what LuaEngine::init set up; the same for the
+// UI and headless mode
+static void register_script_api(lua_State* L) {
+    Environment::instance().setup(L);
+    Closures::register_all(L);
+    int count = 0;
+    lua_pushvalue(L, LUA_GLOBALSINDEX);
+    lua_pushnil(L);
+    while (lua_next(L, -2) != 0) { ++count; lua_pop(L, 1); }
+    lua_pop(L, 1);
+    LOG_INFO("Lua API registered ({} globals)", count);
+}
+
 Executor& Executor::instance() {
     static Executor inst;
     return inst;
@@ -31,6 +236,21 @@ Executor& Executor::instance() {
 
 Executor::Executor() = default;
 
+template<typename Fn, typename... Args>
+void Executor::notify(const std::shared_ptr<const Fn>& slot, Args&&... args) const {
+    std::shared_ptr<const Fn> cb;
+    {
+        std::lock_guard<std::mutex> lock(cb_mutex_);
+        cb = slot;
+    }
+    if (cb && *cb) (*cb)(std::forward<Args>(args)...);
+}
+
+template<typename Fn>
+static std::shared_ptr<const Fn> make_callback(Fn cb) {
+    return cb ? std::make_shared<const Fn>(std::move(cb)) : nullptr;
+}
+
 Executor::~Executor() {
     shutdown();
 }
@@ -40,14 +260,14 @@ void Executor::init() {
     if (initialized_.load(std::memory_order_relaxed)) return;
 
     LOG_INFO("Initializing OSS Executor...");
-    if (status_cb_) status_cb_("Initializing...");
+    notify(status_cb_, "Initializing...");
 
     auto t0 = std::chrono::steady_clock::now();
 
     if (!lua_.init()) {
         LOG_ERROR("Failed to initialize Lua engine");
-        if (error_cb_) error_cb_("Lua engine initialization failed");
-        if (status_cb_) status_cb_("Init failed");
+        notify(error_cb_, "Lua engine initialization failed");
+        notify(status_cb_, "Init failed");
         return;
     }
 
@@ -56,19 +276,19 @@ void Executor::init() {
     LOG_INFO("Lua engine initialized in {}ms", ms);
 
     lua_.set_output_callback([this](const std::string& msg) {
-        if (output_cb_) output_cb_(msg);
+        notify(output_cb_, msg);
     });
 
     lua_.set_error_callback([this](const LuaError& err) {
         std::string msg = err.message;
         if (err.line > 0)
             msg = "[" + err.source + ":" + std::to_string(err.line) + "] " + msg;
-        if (error_cb_) error_cb_(msg);
+        notify(error_cb_, msg);
     });
 
     Injection::instance().set_status_callback(
         [this](InjectionState, const std::string& msg) {
-            if (status_cb_) status_cb_(msg);
+            notify(status_cb_, msg);
         });
 
     try {
@@ -79,14 +299,24 @@ void Executor::init() {
         LOG_WARN("Could not create directories: {}", e.what());
     }
 
-    if (Config::instance().get<bool>("executor.auto_inject", false))
+    if (kAutoInject.get())
         Injection::instance().start_auto_scan();
+    auto_inject_sub_ = kAutoInject.on_change([](bool enabled) {
+        if (enabled) Injection::instance().start_auto_scan();
+        else         Injection::instance().stop_auto_scan();
+    });
+
+    // Applied on the local lane's thread, off the caller's startup path;
+    // jobs submitted before then wait behind it
+    set_lua_setup(register_script_api);
+    start_queue_processor();
 
-    if (Config::instance().get<bool>("executor.queue_autostart", true))
-        start_queue_processor();
+    Metrics::instance().gauge_fn("oss_executor_queue_depth",
+        "Jobs waiting across all execution lanes",
+        [this] { return static_cast<double>(queue_size()); });
 
     initialized_.store(true, std::memory_order_release);
-    if (status_cb_) status_cb_("Ready");
+    notify(status_cb_, "Ready");
     LOG_INFO("OSS Executor initialized successfully");
 }
 
@@ -97,20 +327,26 @@ void Executor::shutdown() {
     LOG_INFO("Shutting down OSS Executor...");
 
     lua_.stop();
+    for (auto& lane : lanes_) {
+        std::lock_guard<std::mutex> llock(lane.mutex);
+        if (lane.current) lane.current->cancelled.store(true, std::memory_order_release);
+    }
+    if (autoexec_thread_.joinable()) autoexec_thread_.join();
     stop_queue_processor();
-    clear_queue();
+    auto_inject_sub_.reset();
     Injection::instance().stop_auto_scan();
     lua_.shutdown();
     initialized_.store(false, std::memory_order_release);
     LOG_INFO("OSS Executor shut down");
 }
 
-bool Executor::send_to_payload(const std::string& source) {
+bool Executor::send_to_payload(const std::string& source, ExecutionJob* job) {
     auto& inj = Injection::instance();
     const auto& pinfo = inj.process_info();
     pid_t pid = inj.target_pid();
 
     if (inj.is_direct_hook()) {
+        set_stage(job, ExecutionStage::Compile);
         size_t bc_len = 0;
         char* bc = luau_compile(source.c_str(), source.size(), nullptr, &bc_len);
         bool syntax_ok = bc && bc_len > 0 && static_cast<uint8_t>(bc[0]) != 0;
@@ -127,6 +363,7 @@ bool Executor::send_to_payload(const std::string& source) {
             LOG_WARN("Bytecode version {} outside expected range [3..6]", static_cast<int>(bc_ver));
         }
 
+        set_stage(job, ExecutionStage::Deliver);
         uint64_t armed_seq = inj.send_via_mailbox(bc, bc_len, 1);
         free(bc);
         bool ok = (armed_seq != 0);
@@ -134,7 +371,9 @@ bool Executor::send_to_payload(const std::string& source) {
         if (ok) {
             // FIX 4: Wait for the payload to consume/acknowledge the mailbox
             // data instead of returning immediately.
-            bool ack = inj.wait_for_mailbox_ack(armed_seq, bc_len, bc_ver);
+            set_stage(job, ExecutionStage::Ack);
+            bool ack = inj.wait_for_mailbox_ack(armed_seq, bc_len, bc_ver,
+                                                job ? &job->cancelled : nullptr);
             if (!ack) {
                 LOG_WARN("Mailbox send succeeded but execution was not "
                          "confirmed within timeout ({} bytes, v{})",
@@ -148,10 +387,22 @@ bool Executor::send_to_payload(const std::string& source) {
         LOG_WARN("Direct hook mailbox failed, trying IPC fallback");
     }
 
+    set_stage(job, ExecutionStage::Deliver);
+
     std::string prefix;
     if ((pinfo.via_flatpak || pinfo.via_sober) && pid > 0)
         prefix = "/proc/" + std::to_string(pid) + "/root";
 
+    // Source channels carry the trace id as a leading comment line
+    std::string wire;
+    if (job && job->trace_id) {
+        char tag[TRACE_LINE_LEN];
+        format_trace_line(job->trace_id, tag);
+        wire.reserve(TRACE_LINE_LEN + source.size());
+        wire.append(tag, TRACE_LINE_LEN).append(source);
+    }
+    const std::string& payload = wire.empty() ? source : wire;
+
     auto write_all = [](int fd, const char* d, size_t rem) -> bool {
         while (rem > 0) {
             ssize_t n = ::write(fd, d, rem);
@@ -183,22 +434,27 @@ bool Executor::send_to_payload(const std::string& source) {
             setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 
             if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), alen) == 0) {
-                if (write_all(fd, source.data(), source.size())) {
+                if (write_all(fd, payload.data(), payload.size())) {
                     ::shutdown(fd, SHUT_WR);
+                    set_stage(job, ExecutionStage::Ack);
+                    bool done = wire.empty() || wait_for_done(fd, job);
                     ::close(fd);
-                    LOG_INFO("Sent {} bytes to payload via abstract socket @{}",
-                             source.size(), ABSTRACT_SOCK_NAME);
+                    LOG_INFO("Sent {} bytes to payload via abstract socket @{}{}",
+                             source.size(), ABSTRACT_SOCK_NAME,
+                             done ? "" : " (completion not reported)");
                     return true;
                 }
                 LOG_WARN("Abstract socket: write failed: {}", strerror(errno));
             } else {
-                LOG_DEBUG("Abstract socket @{} not reachable: {}",
+                LOG_SUB_DEBUG("ipc", "Abstract socket @{} not reachable: {}",
                           ABSTRACT_SOCK_NAME, strerror(errno));
             }
             ::close(fd);
         }
     }
 
+    if (job_cancelled(job)) return false;
+
     // ── 2. Filesystem socket ────────────────────────────────────────────────
     {
         std::string sock_path = prefix + PAYLOAD_SOCK_PATH;
@@ -214,39 +470,44 @@ bool Executor::send_to_payload(const std::string& source) {
 
             if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr),
                           sizeof(addr)) == 0) {
-                if (write_all(fd, source.data(), source.size())) {
+                if (write_all(fd, payload.data(), payload.size())) {
                     ::shutdown(fd, SHUT_WR);
+                    set_stage(job, ExecutionStage::Ack);
+                    bool done = wire.empty() || wait_for_done(fd, job);
                     ::close(fd);
-                    LOG_INFO("Sent {} bytes to payload via socket ({})",
-                             source.size(), sock_path);
+                    LOG_INFO("Sent {} bytes to payload via socket ({}){}",
+                             source.size(), sock_path,
+                             done ? "" : " (completion not reported)");
                     return true;
                 }
                 LOG_WARN("Filesystem socket write failed: {}", strerror(errno));
             } else {
-                LOG_DEBUG("Filesystem socket {} not reachable: {}",
+                LOG_SUB_DEBUG("ipc", "Filesystem socket {} not reachable: {}",
                           sock_path, strerror(errno));
             }
             ::close(fd);
         }
     }
 
+    if (job_cancelled(job)) return false;
+
     // ── 3. File IPC (atomic write via tmp + rename) ─────────────────────────
     {
         std::string cmd_path = prefix + "/tmp/oss_payload_cmd";
         std::string tmp_path = cmd_path + ".tmp";
         int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
         if (fd >= 0) {
-            bool ok = write_all(fd, source.data(), source.size());
+            bool ok = write_all(fd, payload.data(), payload.size());
             ::close(fd);
             if (ok && ::rename(tmp_path.c_str(), cmd_path.c_str()) == 0) {
                 LOG_INFO("Sent {} bytes to payload via file IPC ({})",
                          source.size(), cmd_path);
                 return true;
             }
-            LOG_WARN("File IPC write/rename failed: {}", strerror(errno));
+            LOG_WARN_EVERY(5000, "File IPC write/rename failed: {}", strerror(errno));
             ::unlink(tmp_path.c_str());
         } else {
-            LOG_WARN("File IPC open failed ({}): {}", tmp_path, strerror(errno));
+            LOG_WARN_EVERY(5000, "File IPC open failed ({}): {}", tmp_path, strerror(errno));
         }
     }
 
@@ -255,7 +516,8 @@ bool Executor::send_to_payload(const std::string& source) {
 }
 
 ExecutionResult Executor::execute_internal(const std::string& script,
-                                           const std::string& name) {
+                                           const std::string& name,
+                                           ExecutionJob& job) {
     ExecutionResult result;
     result.script_name = name;
 
@@ -264,28 +526,41 @@ ExecutionResult Executor::execute_internal(const std::string& script,
         return result;
     }
 
-    std::lock_guard<std::mutex> exec_lock(exec_mutex_);
+    // Routed by the attach state captured at submit, so the job runs on the
+    // path its lane was picked for even if the payload came or went since
+    auto& inj = Injection::instance();
+    bool attached = job.lane == ExecutionLane::Remote;
+    if (attached && !(inj.is_attached() && inj.is_payload_loaded())) {
+        result.error = "Payload detached before the script ran";
+        LOG_WARN("Dropping '{}': payload detached since submit", name);
+        return result;
+    }
 
-    executing_.store(true, std::memory_order_release);
+    // Local VM and payload IPC are independent; only same-kind work serializes
+    std::unique_lock<std::mutex> exec_lock(attached ? payload_mutex_ : exec_mutex_);
+    if (!attached) apply_lua_setup();
 
-    auto t0 = std::chrono::steady_clock::now();
+    executing_.fetch_add(1, std::memory_order_acq_rel);
 
-    auto& inj = Injection::instance();
-    bool attached = inj.is_attached() && inj.is_payload_loaded();
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<PayloadSpan> payload_spans;
+    const PayloadSpan* run_span = nullptr;
 
     if (attached) {
-        LOG_INFO("Sending '{}' ({} bytes) to payload", name, script.size());
-        result.success = send_to_payload(script);
+        LOG_SUB_DEBUG("exec", "Sending '{}' ({} bytes) to payload", name, script.size());
+        result.success = send_to_payload(script, &job);
         if (!result.success) {
             result.error = "Failed to deliver script to payload";
             LOG_WARN("Payload send failed for '{}'", name);
         } else {
-            LOG_INFO("Script '{}' dispatched to Roblox payload", name);
+            LOG_SUB_INFO("exec", "Script '{}' dispatched to Roblox payload", name);
         }
 
-        // Read payload status/log after delivery
+        // Socket deliveries of traced scripts return once the payload has
+        // drained them, so status, log and spans are current by now. File IPC
+        // has no reply channel, so its runs usually come back unreported.
         if (result.success) {
-            usleep(500000);
+            set_stage(&job, ExecutionStage::Ack);
             std::string prefix;
             const auto& pinfo = inj.process_info();
             if (pinfo.via_flatpak || pinfo.via_sober) {
@@ -296,36 +571,192 @@ ExecutionResult Executor::execute_internal(const std::string& script,
             if (sf.is_open()) {
                 std::string status;
                 std::getline(sf, status);
-                LOG_INFO("Payload status: {}", status);
+                LOG_SUB_INFO("payload", "status: {}", status);
             }
             std::ifstream lf(prefix + "/tmp/oss_payload.log");
             if (lf.is_open()) {
                 std::string line;
                 while (std::getline(lf, line))
-                    LOG_DEBUG("[payload-log] {}", line);
+                    LOG_SUB_DEBUG("payload", "{}", line);
+            }
+            payload_spans = read_payload_spans(payload_trace_path(prefix, inj.target_pid()),
+                                               job.trace_id);
+
+            // The script runs on the payload's side; Run starts where its span
+            // does (never before our own Ack, the clocks are only that exact)
+            run_span = find_run_span(payload_spans);
+            if (run_span) {
+                set_stage(&job, ExecutionStage::Run);
+                auto& ack = job.stage_at[static_cast<size_t>(ExecutionStage::Ack)];
+                job.stage_at[static_cast<size_t>(ExecutionStage::Run)] =
+                    std::max(payload_time(run_span->begin_ns), ack);
+            } else {
+                result.run_reported = false;
             }
         }
     } else {
-        result.success = lua_.execute(script, "=" + name);
+        set_stage(&job, ExecutionStage::Compile);
+        std::string bytecode = compile_cached(script, result.error);
+        if (!bytecode.empty()) {
+            set_stage(&job, ExecutionStage::Run);
+            result.success = lua_.execute_bytecode(bytecode, "=" + name);
+        }
     }
 
     auto t1 = std::chrono::steady_clock::now();
 
-    result.execution_time_ms =
-        std::chrono::duration<double, std::milli>(t1 - t0).count();
+    result.execution_time_ms = ms_between(t0, t1);
+    fill_phase_times(result, job, t0, t1);
+    if (run_span) result.run_ms = ms_between(payload_time(run_span->begin_ns),
+                                             payload_time(run_span->end_ns));
+    record_trace(result, job, t0, t1, payload_spans);
 
-    executing_.store(false, std::memory_order_release);
+    g_executions.add();
+    if (!result.success) g_exec_failed.add();
+    if (attached) g_ipc_us.record(static_cast<uint64_t>(result.transfer_ms * 1000.0));
+
+    executing_.fetch_sub(1, std::memory_order_acq_rel);
+    exec_lock.unlock();
+    // The script may have left tasks behind for the local lane to resume
+    if (!attached) request_tick();
+
+    record_result(result, true);
+    notify(result_cb_, result);
+
+    return result;
+}
+
+ExecutionResult Executor::compile_only(ExecutionJob& job) {
+    ExecutionResult result;
+    result.script_name = job.name;
+
+    auto t0 = ExecutionJob::Clock::now();
+    set_stage(&job, ExecutionStage::Compile);
+    result.success = !compile_cached(job.source, result.error).empty();
+    auto t1 = ExecutionJob::Clock::now();
+
+    result.execution_time_ms = ms_between(t0, t1);
+    fill_phase_times(result, job, t0, t1);
+    record_trace(result, job, t0, t1, {});
+    record_result(result, false);
+    return result;
+}
+
+void Executor::record_result(const ExecutionResult& result, bool keep_history) {
+    g_queue_us.record(static_cast<uint64_t>(result.queue_ms * 1000.0));
+
+    PhaseSample sample{
+        static_cast<float>(result.queue_ms),
+        static_cast<float>(result.compile_ms),
+        static_cast<float>(result.transfer_ms),
+        static_cast<float>(result.run_ms),
+        static_cast<float>(result.queue_ms + result.execution_time_ms),
+    };
 
+    std::lock_guard<std::mutex> hlk(history_mutex_);
+    if (latency_samples_.size() < LATENCY_WINDOW) latency_samples_.push_back(sample);
+    else latency_samples_[latency_next_] = sample;
+    latency_next_ = (latency_next_ + 1) % LATENCY_WINDOW;
+
+    if (!keep_history) return;
+    execution_history_.push_back(result);
+    while (execution_history_.size() > max_history_)
+        execution_history_.pop_front();
+}
+
+void Executor::record_trace(ExecutionResult& result, const ExecutionJob& job,
+                            ExecutionJob::Clock::time_point start,
+                            ExecutionJob::Clock::time_point end,
+                            const std::vector<PayloadSpan>& payload_spans) {
+    result.trace_id = job.trace_id;
+    if (!job.trace_id) return;
+
+    const int self_pid = static_cast<int>(getpid());
+    const int lane_tid = static_cast<int>(job.lane);
+    nlohmann::json events = nlohmann::json::array();
+    auto span = [&](const std::string& name, int pid, int tid, int64_t ts, int64_t dur) {
+        events.push_back({{"name", name}, {"cat", "execution"}, {"ph", "X"},
+                          {"ts", ts}, {"dur", dur}, {"pid", pid}, {"tid", tid}});
+    };
+    auto process_name = [&](int pid, const char* name) {
+        events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", pid},
+                          {"args", {{"name", name}}}});
+    };
+
+    process_name(self_pid, "executor");
+    if (job.queued_at != ExecutionJob::Clock::time_point{})
+        span("queue", self_pid, lane_tid, trace_us(job.queued_at),
+             trace_us(start) - trace_us(job.queued_at));
+    span(result.script_name, self_pid, lane_tid, trace_us(start),
+         trace_us(end) - trace_us(start));
+
+    for_each_stage(job, end, [&](ExecutionStage stage, auto begin, auto finish) {
+        span(execution_stage_name(stage), self_pid, lane_tid,
+             trace_us(begin), trace_us(finish) - trace_us(begin));
+    });
+
+    if (!payload_spans.empty()) {
+        int target = static_cast<int>(Injection::instance().target_pid());
+        process_name(target, "payload");
+        for (const auto& ps : payload_spans) {
+            auto ts = static_cast<int64_t>(ps.begin_ns / 1000);
+            span(ps.name, target, 0, ts, static_cast<int64_t>(ps.end_ns / 1000) - ts);
+        }
+    }
+
+    const std::string id = trace_hex(job.trace_id);
+    nlohmann::json doc = {
+        {"traceEvents", std::move(events)},
+        {"displayTimeUnit", "ms"},
+        {"otherData", {{"trace_id", id}, {"script", result.script_name},
+                       {"success", result.success}}},
+    };
+    std::string text = doc.dump();
+
+    const std::string& dir = kTraceDir.get();
+    if (!dir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        std::string path = dir + "/" + id + ".json";
+        std::ofstream out(path, std::ios::trunc);
+        if (out.is_open() && (out << text)) result.trace_path = path;
+        else LOG_WARN("Cannot write execution trace to {}", path);
+    }
+
+    std::lock_guard<std::mutex> hlk(history_mutex_);
+    traces_.emplace_back(job.trace_id, std::move(text));
+    while (traces_.size() > MAX_TRACES) traces_.pop_front();
+}
+
+std::string Executor::execution_trace(uint64_t trace_id) const {
+    std::lock_guard<std::mutex> hlk(history_mutex_);
+    for (auto it = traces_.rbegin(); it != traces_.rend(); ++it) {
+        if (it->first == trace_id) return it->second;
+    }
+    return {};
+}
+
+ExecutionLatency Executor::latency() const {
+    std::vector<PhaseSample> samples;
     {
         std::lock_guard<std::mutex> hlk(history_mutex_);
-        execution_history_.push_back(result);
-        while (execution_history_.size() > max_history_)
-            execution_history_.pop_front();
+        samples = latency_samples_;
     }
 
-    if (result_cb_) result_cb_(result);
-
-    return result;
+    ExecutionLatency out;
+    out.samples = samples.size();
+    std::vector<float> values(samples.size());
+    auto summarize = [&](float PhaseSample::* field, LatencySummary& dst) {
+        for (size_t i = 0; i < samples.size(); i++) values[i] = samples[i].*field;
+        dst.p50_ms = percentile(values, 0.50);
+        dst.p99_ms = percentile(values, 0.99);
+    };
+    summarize(&PhaseSample::queue,    out.queue);
+    summarize(&PhaseSample::compile,  out.compile);
+    summarize(&PhaseSample::transfer, out.transfer);
+    summarize(&PhaseSample::run,      out.run);
+    summarize(&PhaseSample::total,    out.total);
+    return out;
 }
 
 void Executor::execute_script(const std::string& script) {
@@ -335,33 +766,262 @@ void Executor::execute_script(const std::string& script) {
 void Executor::execute_script(const std::string& script,
                               const std::string& name) {
     if (!initialized_.load(std::memory_order_acquire)) {
-        if (error_cb_) error_cb_("Executor not initialized");
+        notify(error_cb_, "Executor not initialized");
         return;
     }
     if (script.empty()) {
-        if (error_cb_) error_cb_("Empty script");
+        notify(error_cb_, "Empty script");
         return;
     }
 
-    bool attached = Injection::instance().is_attached();
+    auto& inj = Injection::instance();
+    bool attached = inj.is_attached() && inj.is_payload_loaded();
 
-    if (status_cb_)
-        status_cb_(attached ? "Sending to Roblox..." : "Executing locally...");
+    notify(status_cb_, attached ? "Sending to Roblox..." : "Executing locally...");
 
-    auto result = execute_internal(script, name);
+    ExecutionJob job;
+    job.name     = name;
+    job.trace_id = new_trace_id();
+    job.lane     = attached ? ExecutionLane::Remote : ExecutionLane::Local;
+    report_result(execute_internal(script, name, job), attached);
+}
 
+void Executor::report_result(const ExecutionResult& result, bool attached) {
     if (result.success) {
-        if (status_cb_)
-            status_cb_(attached ? "Sent to Roblox \u2713" : "Executed \u2713");
+        notify(status_cb_, attached ? "Sent to Roblox \u2713" : "Executed \u2713");
+    } else {
+        notify(status_cb_, "Execution failed \u2717");
+        if (!result.error.empty()) notify(error_cb_, result.error);
+    }
+}
+
+// ── Execution lanes ──
+
+ExecutionHandle Executor::make_job(ScriptRequest&& request) {
+    auto job = std::make_shared<ExecutionJob>();
+    job->id        = next_job_id_.fetch_add(1, std::memory_order_relaxed);
+    job->trace_id  = new_trace_id();
+    job->source    = std::move(request.source);
+    job->name      = std::move(request.name);
+    job->priority  = request.priority;
+    job->on_stage  = std::move(request.on_stage);
+    job->on_done   = std::move(request.on_done);
+    job->queued_at = ExecutionJob::Clock::now();
+
+    if (request.compile_only) {
+        job->lane = ExecutionLane::Compile;
     } else {
-        if (status_cb_) status_cb_("Execution failed \u2717");
-        if (error_cb_ && !result.error.empty()) error_cb_(result.error);
+        auto& inj = Injection::instance();
+        job->lane = inj.is_attached() && inj.is_payload_loaded()
+                        ? ExecutionLane::Remote : ExecutionLane::Local;
+    }
+    return job;
+}
+
+// Caller holds lane.mutex
+void Executor::push_job(Lane& lane, ExecutionHandle job) {
+    auto pos = std::find_if(lane.jobs.begin(), lane.jobs.end(),
+        [&](const ExecutionHandle& queued) { return queued->priority < job->priority; });
+    lane.jobs.insert(pos, std::move(job));
+}
+
+ExecutionHandle Executor::submit(const std::string& script, const std::string& name,
+                                 std::function<void(ExecutionStage)> on_stage,
+                                 std::function<void(const ExecutionResult&)> on_done) {
+    ScriptRequest request;
+    request.source   = script;
+    request.name     = name;
+    request.on_stage = std::move(on_stage);
+    request.on_done  = std::move(on_done);
+    return submit(std::move(request));
+}
+
+ExecutionHandle Executor::submit(ScriptRequest request) {
+    auto job = make_job(std::move(request));
+    Lane& lane = lanes_[static_cast<size_t>(job->lane)];
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        push_job(lane, job);
+    }
+    lane.cv.notify_one();
+    LOG_SUB_DEBUG("exec", "Submitted job #{} ({}) to {} lane", job->id, job->name,
+                  execution_lane_name(job->lane));
+    return job;
+}
+
+std::vector<ExecutionHandle> Executor::enqueue_batch(std::vector<ScriptRequest> batch) {
+    std::vector<ExecutionHandle> handles;
+    handles.reserve(batch.size());
+    std::array<std::vector<ExecutionHandle>, EXECUTION_LANE_COUNT> per_lane;
+    for (auto& request : batch) {
+        auto job = make_job(std::move(request));
+        per_lane[static_cast<size_t>(job->lane)].push_back(job);
+        handles.push_back(std::move(job));
+    }
+
+    for (size_t i = 0; i < EXECUTION_LANE_COUNT; i++) {
+        if (per_lane[i].empty()) continue;
+        {
+            std::lock_guard<std::mutex> lock(lanes_[i].mutex);
+            for (auto& job : per_lane[i]) push_job(lanes_[i], std::move(job));
+        }
+        lanes_[i].cv.notify_one();
+    }
+    LOG_SUB_DEBUG("exec", "Submitted batch of {} jobs", handles.size());
+    return handles;
+}
+
+void Executor::cancel(const ExecutionHandle& job) {
+    if (!job) return;
+    job->cancelled.store(true, std::memory_order_release);
+
+    Lane& lane = lanes_[static_cast<size_t>(job->lane)];
+    bool running;
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        running = lane.current == job;
+    }
+    // The lane was fixed at submit; attach state may have changed since
+    if (running && job->lane == ExecutionLane::Local)
+        lua_.stop();
+}
+
+void Executor::set_lua_setup(std::function<void(lua_State*)> setup) {
+    Lane& lane = lanes_[static_cast<size_t>(ExecutionLane::Local)];
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        lua_setup_ = std::move(setup);
+    }
+    lane.cv.notify_one();
+}
+
+// Caller holds exec_mutex_
+void Executor::apply_lua_setup() {
+    std::function<void(lua_State*)> setup;
+    {
+        std::lock_guard<std::mutex> lock(lanes_[static_cast<size_t>(ExecutionLane::Local)].mutex);
+        setup.swap(lua_setup_);
+    }
+    if (!setup) return;
+
+    lua_State* L = lua_.state();
+    if (!L) {
+        LOG_ERROR("Lua state is null — skipping API registration");
+        return;
+    }
+    TRACE_SPAN("vm_environment");
+    setup(L);
+}
+
+void Executor::start_queue_processor() {
+    if (lanes_running_.exchange(true, std::memory_order_acq_rel)) return;
+    for (size_t i = 0; i < EXECUTION_LANE_COUNT; i++)
+        lanes_[i].worker = std::thread(&Executor::process_lane, this, static_cast<ExecutionLane>(i));
+    LOG_INFO("Execution lanes started");
+}
+
+void Executor::stop_queue_processor() {
+    if (!lanes_running_.exchange(false, std::memory_order_acq_rel)) return;
+    for (auto& lane : lanes_) {
+        // Taking the lock orders the flag store before a worker's wait
+        { std::lock_guard<std::mutex> lock(lane.mutex); }
+        lane.cv.notify_all();
+    }
+    for (auto& lane : lanes_) {
+        if (lane.worker.joinable()) lane.worker.join();
+        std::deque<ExecutionHandle> dropped;
+        {
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            dropped.swap(lane.jobs);
+        }
+        // Settle what never ran, so handles and control clients waiting on
+        // these jobs get a cancelled result instead of hanging
+        for (auto& job : dropped) {
+            job->cancelled.store(true, std::memory_order_release);
+            ExecutionResult result = cancelled_result(*job);
+            set_stage(job.get(), ExecutionStage::Done);
+            if (job->on_done) job->on_done(result);
+        }
+    }
+    LOG_INFO("Execution lanes stopped");
+}
+
+void Executor::request_tick() {
+    Lane& lane = lanes_[static_cast<size_t>(ExecutionLane::Local)];
+    {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        tick_requested_ = true;
+    }
+    lane.cv.notify_one();
+}
+
+void Executor::kill_script(int script_id) {
+    lua_.kill_script(script_id);
+    request_tick();
+}
+
+// The local lane also owns the VM's scheduler: between jobs it sleeps until
+// the next task.wait/delay is due (or a tick is requested) and ticks the VM.
+void Executor::process_lane(ExecutionLane kind) {
+    Lane& lane = lanes_[static_cast<size_t>(kind)];
+    bool local = kind == ExecutionLane::Local;
+
+    while (lanes_running_.load(std::memory_order_acquire)) {
+        ExecutionHandle job;
+        // Read before taking lane.mutex; the VM lock is never nested inside it
+        int next_task_ms = local ? lua_.ms_until_next_task() : -1;
+        {
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            auto ready = [&] {
+                return !lane.jobs.empty() || (local && (lua_setup_ || tick_requested_)) ||
+                       !lanes_running_.load(std::memory_order_acquire);
+            };
+            if (next_task_ms < 0) lane.cv.wait(lock, ready);
+            else lane.cv.wait_for(lock, std::chrono::milliseconds(next_task_ms), ready);
+            if (!lanes_running_.load(std::memory_order_acquire)) break;
+            if (local && lua_setup_) {
+                lock.unlock();
+                std::lock_guard<std::mutex> exec_lock(exec_mutex_);
+                apply_lua_setup();
+                continue;
+            }
+            // Due tasks go before the next job so a busy queue can't starve them
+            if (local && (lane.jobs.empty() || tick_requested_ || next_task_ms == 0)) {
+                tick_requested_ = false;
+                lock.unlock();
+                std::lock_guard<std::mutex> exec_lock(exec_mutex_);
+                lua_.tick();
+                continue;
+            }
+            job = std::move(lane.jobs.front());
+            lane.jobs.pop_front();
+            lane.current = job;
+        }
+
+        ExecutionResult result;
+        if (job_cancelled(job.get())) {
+            result = cancelled_result(*job);
+        } else if (kind == ExecutionLane::Compile) {
+            result = compile_only(*job);
+        } else {
+            bool attached = kind == ExecutionLane::Remote;
+            notify(status_cb_, attached ? "Sending to Roblox..." : "Executing locally...");
+            result = execute_internal(job->source, job->name, *job);
+            report_result(result, attached);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(lane.mutex);
+            lane.current.reset();
+        }
+        set_stage(job.get(), ExecutionStage::Done);
+        if (job->on_done) job->on_done(result);
     }
 }
 
 void Executor::execute_file(const std::string& path) {
     if (!initialized_.load(std::memory_order_acquire)) {
-        if (error_cb_) error_cb_("Executor not initialized");
+        notify(error_cb_, "Executor not initialized");
         return;
     }
 
@@ -375,7 +1035,7 @@ void Executor::execute_file(const std::string& path) {
 std::string Executor::read_file(const std::string& path) {
     std::ifstream file(path);
     if (!file.is_open()) {
-        if (error_cb_) error_cb_("Cannot open file: " + path);
+        notify(error_cb_, "Cannot open file: " + path);
         return "";
     }
     return std::string((std::istreambuf_iterator<char>(file)),
@@ -383,31 +1043,39 @@ std::string Executor::read_file(const std::string& path) {
 }
 
 void Executor::cancel_execution() {
+    for (auto& lane : lanes_) {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        for (auto& job : lane.jobs) job->cancelled.store(true, std::memory_order_release);
+        if (lane.current) lane.current->cancelled.store(true, std::memory_order_release);
+    }
+
     if (Injection::instance().is_attached()) {
-        if (status_cb_) status_cb_("Cannot cancel remote execution");
+        // Pending jobs are dropped and the ack wait is abandoned, but a
+        // script the payload already picked up keeps running in Roblox.
+        notify(status_cb_, "Cannot cancel remote execution");
         LOG_WARN("Cancel requested but script is running inside Roblox");
         return;
     }
     lua_.stop();
-    executing_.store(false, std::memory_order_release);
-    if (status_cb_) status_cb_("Cancelled");
+    notify(status_cb_, "Cancelled");
     LOG_INFO("Execution cancelled by user");
 }
 
 void Executor::enqueue_script(const std::string& script,
                               const std::string& name, int priority) {
-    QueuedScript qs;
-    qs.source    = script;
-    qs.name      = name;
-    qs.is_file   = false;
-    qs.priority  = priority;
-    qs.queued_at = std::chrono::steady_clock::now();
-
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        script_queue_.push(std::move(qs));
-    }
-    queue_cv_.notify_one();
+    ScriptRequest request;
+    request.source   = script;
+    request.name     = name;
+    request.priority = priority;
+    request.on_done  = [this](const ExecutionResult& result) {
+        if (result.cancelled) return;
+        if (result.success) {
+            notify(output_cb_, "[queue] " + result.script_name + " completed");
+        } else {
+            notify(error_cb_, "[queue] " + result.script_name + " failed");
+        }
+    };
+    submit(std::move(request));
     LOG_INFO("Enqueued script: {} (priority {})", name, priority);
 }
 
@@ -419,105 +1087,122 @@ void Executor::enqueue_file(const std::string& path, int priority) {
     enqueue_script(content, name, priority);
 }
 
+// Queued jobs are cancelled rather than dropped so their on_done still fires
 void Executor::clear_queue() {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    std::priority_queue<QueuedScript> empty;
-    script_queue_.swap(empty);
+    for (auto& lane : lanes_) {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        for (auto& job : lane.jobs) job->cancelled.store(true, std::memory_order_release);
+    }
     LOG_INFO("Script queue cleared");
 }
 
 size_t Executor::queue_size() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return script_queue_.size();
+    size_t total = 0;
+    for (const auto& lane : lanes_) {
+        std::lock_guard<std::mutex> lock(lane.mutex);
+        total += lane.jobs.size();
+    }
+    return total;
 }
 
-bool Executor::is_executing() const {
-    return executing_.load(std::memory_order_acquire);
+size_t Executor::lane_depth(ExecutionLane kind) const {
+    const Lane& lane = lanes_[static_cast<size_t>(kind)];
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    return lane.jobs.size();
 }
 
-void Executor::start_queue_processor() {
-    if (queue_running_.load(std::memory_order_acquire)) return;
-
-    queue_running_.store(true, std::memory_order_release);
-    queue_thread_ = std::thread(&Executor::process_queue, this);
-    LOG_INFO("Queue processor started");
+bool Executor::is_executing() const {
+    return executing_.load(std::memory_order_acquire) > 0;
 }
 
-void Executor::stop_queue_processor() {
-    if (!queue_running_.load(std::memory_order_acquire)) return;
-
-    queue_running_.store(false, std::memory_order_release);
-    queue_cv_.notify_all();
-
-    if (queue_thread_.joinable())
-        queue_thread_.join();
-
-    LOG_INFO("Queue processor stopped");
+void Executor::auto_execute() {
+    if (!initialized_.load(std::memory_order_acquire) || autoexec_thread_.joinable()) return;
+    autoexec_thread_ = std::thread(&Executor::warm_autoexec, this);
 }
 
-void Executor::process_queue() {
-    while (queue_running_.load(std::memory_order_acquire)) {
-        QueuedScript script;
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this] {
-                return !script_queue_.empty() ||
-                       !queue_running_.load(std::memory_order_acquire);
-            });
-
-            if (!queue_running_.load(std::memory_order_acquire)) break;
-            if (script_queue_.empty()) continue;
-
-            script = std::move(const_cast<QueuedScript&>(script_queue_.top()));
-            script_queue_.pop();
-        }
-
-        if (status_cb_) status_cb_("Queue: executing " + script.name);
-
-        auto wait_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - script.queued_at).count();
-        LOG_INFO("Dequeued {} after {}ms wait", script.name, wait_ms);
+void Executor::warm_autoexec() {
+    // Listed from ScriptManager's live index (sorted by name) rather than disk
+    std::vector<std::filesystem::path> scripts;
+    for (const auto& entry : ScriptManager::instance().list_autoexec()) {
+        std::filesystem::path path = entry.path;
+        auto ext = path.extension().string();
+        if (ext == ".lua" || ext == ".luau")
+            scripts.push_back(std::move(path));
+    }
+    if (scripts.empty()) return;
 
-        auto result = execute_internal(script.source, script.name);
+    // Fan reading + compilation out; results land in the bytecode cache so
+    // the engine thread only has to load and run them.
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::string> sources(scripts.size());
+    std::atomic<size_t> next{0};
+    size_t workers = std::min<size_t>(
+        std::max(1u, std::thread::hardware_concurrency()), scripts.size());
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (size_t w = 0; w < workers; w++) {
+        pool.emplace_back([&] {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < scripts.size();) {
+                sources[i] = read_file(scripts[i].string());
+                if (sources[i].empty()) continue;
+                std::string err;
+                compile_cached(sources[i], err);
+            }
+        });
+    }
+    for (auto& t : pool) t.join();
 
-        if (result.success) {
-            if (output_cb_) output_cb_("[queue] " + script.name + " completed");
-        } else {
-            if (error_cb_) error_cb_("[queue] " + script.name + " failed");
-        }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() - t0).count();
+    LOG_INFO("Autoexec warm-up: {} scripts read and compiled in {}ms on {} threads",
+             scripts.size(), ms, workers);
+
+    if (!lanes_running_.load(std::memory_order_acquire)) return;
+
+    std::vector<ScriptRequest> batch;
+    batch.reserve(scripts.size());
+    for (size_t i = 0; i < scripts.size(); i++) {
+        if (sources[i].empty()) continue;
+        ScriptRequest request;
+        request.source = std::move(sources[i]);
+        request.name   = scripts[i].filename().string();
+        LOG_INFO("Auto-executing: {}", request.name);
+        notify(output_cb_, "[autoexec] Running " + request.name);
+        batch.push_back(std::move(request));
     }
+
+    if (!batch.empty())
+        LOG_INFO("Auto-executed {} scripts", enqueue_batch(std::move(batch)).size());
 }
 
-void Executor::auto_execute() {
-    std::string dir = Config::instance().home_dir() + "/scripts/autoexec";
-    try {
-        if (!std::filesystem::exists(dir) ||
-            !std::filesystem::is_directory(dir))
-            return;
-
-        std::vector<std::filesystem::path> scripts;
-        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
-            if (!entry.is_regular_file()) continue;
-            auto ext = entry.path().extension().string();
-            if (ext == ".lua" || ext == ".luau")
-                scripts.push_back(entry.path());
+std::string Executor::compile_cached(const std::string& source, std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = bytecode_cache_.find(source);
+        if (it != bytecode_cache_.end()) {
+            bytecode_lru_.splice(bytecode_lru_.begin(), bytecode_lru_, it->second);
+            g_cache_hits.add();
+            return it->second->second;
         }
-        std::sort(scripts.begin(), scripts.end());
+    }
 
-        for (const auto& s : scripts) {
-            LOG_INFO("Auto-executing: {}", s.filename().string());
-            if (output_cb_)
-                output_cb_("[autoexec] Running " + s.filename().string());
-            execute_file(s.string());
+    auto t0 = std::chrono::steady_clock::now();
+    std::string bytecode = LuaEngine::compile_source(source, error);
+    g_compile_us.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count()));
+    if (!bytecode.empty()) {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        // Another lane may have compiled the same source meanwhile
+        if (bytecode_cache_.count(source)) return bytecode;
+        if (bytecode_lru_.size() >= MAX_CACHED_CHUNKS) {
+            bytecode_cache_.erase(bytecode_lru_.back().first);
+            bytecode_lru_.pop_back();
         }
-
-        if (!scripts.empty())
-            LOG_INFO("Auto-executed {} scripts", scripts.size());
-    } catch (const std::filesystem::filesystem_error& e) {
-        LOG_ERROR("Auto-execute failed: {}", e.what());
-        if (error_cb_)
-            error_cb_("Auto-execute error: " + std::string(e.what()));
+        bytecode_lru_.emplace_front(source, bytecode);
+        bytecode_cache_.emplace(bytecode_lru_.front().first, bytecode_lru_.begin());
     }
+    return bytecode;
 }
 
 std::vector<ExecutionResult> Executor::get_history() const {
@@ -530,10 +1215,31 @@ void Executor::clear_history() {
     execution_history_.clear();
 }
 
-void Executor::set_output_callback(OutputCallback cb) { output_cb_ = std::move(cb); }
-void Executor::set_error_callback(ErrorCallback  cb) { error_cb_  = std::move(cb); }
-void Executor::set_status_callback(StatusCallback cb) { status_cb_ = std::move(cb); }
-void Executor::set_result_callback(ResultCallback cb) { result_cb_ = std::move(cb); }
+// The old callback is released outside cb_mutex_; a call already in flight
+// on another thread finishes with its own copy
+void Executor::set_output_callback(OutputCallback cb) {
+    auto slot = make_callback(std::move(cb));
+    std::lock_guard<std::mutex> lock(cb_mutex_);
+    output_cb_.swap(slot);
+}
+
+void Executor::set_error_callback(ErrorCallback cb) {
+    auto slot = make_callback(std::move(cb));
+    std::lock_guard<std::mutex> lock(cb_mutex_);
+    error_cb_.swap(slot);
+}
+
+void Executor::set_status_callback(StatusCallback cb) {
+    auto slot = make_callback(std::move(cb));
+    std::lock_guard<std::mutex> lock(cb_mutex_);
+    status_cb_.swap(slot);
+}
+
+void Executor::set_result_callback(ResultCallback cb) {
+    auto slot = make_callback(std::move(cb));
+    std::lock_guard<std::mutex> lock(cb_mutex_);
+    result_cb_.swap(slot);
+}
 
 } // namespace oss
 
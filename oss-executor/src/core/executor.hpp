@@ -2,38 +2,112 @@
 
 #include "core/lua_engine.hpp"
 #include "core/injection.hpp"
+#include "core/exec_trace.hpp"
+#include "utils/config.hpp"
 
 #include <string>
 #include <functional>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <deque>
+#include <list>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <condition_variable>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace oss {
 
-struct QueuedScript {
-    std::string source;
-    std::string name;
-    bool is_file   = false;
-    int  priority  = 0;
-    std::chrono::steady_clock::time_point queued_at{};
-
-    bool operator<(const QueuedScript& other) const {
-        return priority < other.priority;
-    }
-};
-
 struct ExecutionResult {
     bool        success           = false;
     std::string output;
     std::string error;
     double      execution_time_ms = 0.0;
     std::string script_name;
+    bool        cancelled         = false;  // dropped before it started
+
+    // Phase breakdown; phases a script never entered stay at 0
+    double queue_ms    = 0.0;
+    double compile_ms  = 0.0;
+    double transfer_ms = 0.0;  // deliver + payload ack
+    double run_ms      = 0.0;
+    // Remote runs are timed by the payload's run span; false when none came
+    // back (untraced payload, or it had not drained yet), run_ms is then 0
+    bool   run_reported = true;
+
+    // Executor::execution_trace(trace_id) returns the stitched executor +
+    // payload timeline; trace_path is set when trace.executions_dir is.
+    uint64_t    trace_id = 0;
+    std::string trace_path;
+};
+
+enum class ExecutionStage { Queued, Compile, Deliver, Ack, Run, Done };
+
+const char* execution_stage_name(ExecutionStage stage);
+
+// Each lane has its own worker, so a slow payload ack never holds up local
+// runs. Injection drives a single target, hence a single remote lane.
+enum class ExecutionLane { Local, Remote, Compile };
+
+constexpr size_t EXECUTION_LANE_COUNT = 3;
+
+const char* execution_lane_name(ExecutionLane lane);
+
+// A script submitted with Executor::submit(). Both callbacks fire on the
+// lane's worker thread, or for jobs still queued at stop_queue_processor()
+// on the thread stopping the lanes; UI code marshals them onto its own loop.
+struct ExecutionJob {
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t      id = 0;
+    uint64_t      trace_id = 0;  // carried to the payload with the script
+    std::string   source;
+    std::string   name;
+    int           priority = 0;
+    ExecutionLane lane     = ExecutionLane::Local;
+
+    std::function<void(ExecutionStage)>         on_stage;
+    std::function<void(const ExecutionResult&)> on_done;
+
+    std::atomic<ExecutionStage> stage{ExecutionStage::Queued};
+    std::atomic<bool>           cancelled{false};
+
+    // Written by the worker only
+    Clock::time_point                  queued_at{};
+    std::array<Clock::time_point, 6>   stage_at{};
+};
+
+using ExecutionHandle = std::shared_ptr<ExecutionJob>;
+
+// One entry of Executor::enqueue_batch()
+struct ScriptRequest {
+    std::string source;
+    std::string name         = "queued";
+    int         priority     = 0;      // higher runs first within a lane
+    bool        compile_only = false;  // syntax check + bytecode cache warm-up
+
+    std::function<void(ExecutionStage)>         on_stage;
+    std::function<void(const ExecutionResult&)> on_done;
+};
+
+struct LatencySummary {
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+};
+
+// Percentiles over the most recent executions
+struct ExecutionLatency {
+    size_t         samples = 0;
+    LatencySummary queue;
+    LatencySummary compile;
+    LatencySummary transfer;
+    LatencySummary run;
+    LatencySummary total;
 };
 
 class Executor {
@@ -52,16 +126,36 @@ public:
     void execute_script(const std::string& script, const std::string& name);
     void execute_file(const std::string& path);
     void cancel_execution();
+    // Reads and compiles scripts/autoexec/* in parallel on a background
+    // thread, then submits them in sorted order. Returns immediately.
     void auto_execute();
 
+    // Local-engine bytecode, memoized by source. Safe from any thread.
+    std::string compile_cached(const std::string& source, std::string& error);
+
+    // Queues the script on the local or remote lane (picked by attach
+    // state at submit time); returns immediately.
+    ExecutionHandle submit(const std::string& script, const std::string& name,
+                           std::function<void(ExecutionStage)> on_stage = nullptr,
+                           std::function<void(const ExecutionResult&)> on_done = nullptr);
+    ExecutionHandle submit(ScriptRequest request);
+    // Sources are moved into the jobs; each lane is locked once per batch.
+    std::vector<ExecutionHandle> enqueue_batch(std::vector<ScriptRequest> batch);
+    void cancel(const ExecutionHandle& job);
+
     void   enqueue_script(const std::string& script,
                           const std::string& name = "queued",
                           int priority = 0);
     void   enqueue_file(const std::string& path, int priority = 0);
     void   clear_queue();
     size_t queue_size() const;
+    size_t lane_depth(ExecutionLane lane) const;
     bool   is_executing() const;
 
+    ExecutionLatency latency() const;
+    // Chrome trace JSON for one of the last MAX_TRACES executions, or ""
+    std::string      execution_trace(uint64_t trace_id) const;
+
     void start_queue_processor();
     void stop_queue_processor();
 
@@ -72,6 +166,11 @@ public:
     LuaEngine&       lua()       { return lua_; }
     const LuaEngine& lua() const { return lua_; }
 
+    // Task manager view of the scripts run on the local VM
+    std::vector<ScriptUsage> script_usage() { return lua_.script_usage(); }
+    void kill_script(int script_id);
+    void remove_script(int script_id)       { lua_.remove_script(script_id); }
+
     Injection& injection() { return Injection::instance(); }
 
     using OutputCallback = std::function<void(const std::string&)>;
@@ -84,6 +183,11 @@ public:
     void set_status_callback(StatusCallback cb);
     void set_result_callback(ResultCallback cb);
 
+    // Registers the script environment on the executor's VM. Runs once on the
+    // job thread (or before the first synchronous execution), keeping the
+    // API registration off the UI thread's startup path.
+    void set_lua_setup(std::function<void(lua_State*)> setup);
+
     std::vector<ExecutionResult> get_history() const;
     void clear_history();
 
@@ -91,34 +195,84 @@ private:
     Executor();
     ~Executor();
 
+    struct Lane {
+        std::deque<ExecutionHandle> jobs;  // by priority, FIFO within one
+        ExecutionHandle             current;
+        mutable std::mutex          mutex;
+        std::condition_variable     cv;
+        std::thread                 worker;
+    };
+
     ExecutionResult execute_internal(const std::string& script,
-                                     const std::string& name);
-    bool        send_to_payload(const std::string& source);
-    void        process_queue();
+                                     const std::string& name,
+                                     ExecutionJob& job);
+    ExecutionResult compile_only(ExecutionJob& job);
+    bool        send_to_payload(const std::string& source, ExecutionJob* job = nullptr);
+    void        report_result(const ExecutionResult& result, bool attached);
+    void        record_result(const ExecutionResult& result, bool keep_history);
+    void        record_trace(ExecutionResult& result, const ExecutionJob& job,
+                             ExecutionJob::Clock::time_point start,
+                             ExecutionJob::Clock::time_point end,
+                             const std::vector<PayloadSpan>& payload_spans);
+    ExecutionHandle make_job(ScriptRequest&& request);
+    void        push_job(Lane& lane, ExecutionHandle job);
+    void        process_lane(ExecutionLane kind);
+    void        warm_autoexec();
+    void        apply_lua_setup();
+    // Wakes the local lane to run the VM's scheduler now
+    void        request_tick();
     std::string read_file(const std::string& path);
 
+    // Invokes a snapshot of the callback, taken under cb_mutex_
+    template<typename Fn, typename... Args>
+    void notify(const std::shared_ptr<const Fn>& slot, Args&&... args) const;
+
     LuaEngine lua_;
 
     std::atomic<bool> initialized_{false};
-    std::atomic<bool> executing_{false};
-    std::atomic<bool> queue_running_{false};
+    std::atomic<int>  executing_{0};
+    std::atomic<bool> lanes_running_{false};
 
-    std::mutex exec_mutex_;
+    std::mutex exec_mutex_;     // local VM
+    std::mutex payload_mutex_;  // payload IPC / mailbox
     std::mutex init_mutex_;
 
-    std::priority_queue<QueuedScript> script_queue_;
-    mutable std::mutex                queue_mutex_;
-    std::condition_variable           queue_cv_;
-    std::thread                       queue_thread_;
+    std::array<Lane, EXECUTION_LANE_COUNT> lanes_;
+    std::atomic<uint64_t>            next_job_id_{1};
+    std::function<void(lua_State*)>  lua_setup_;  // guarded by the local lane's mutex
+    bool                             tick_requested_ = false;  // likewise
+
+    std::thread autoexec_thread_;
+    Config::Subscription auto_inject_sub_;
+
+    // LRU keyed on the full source; index keys view the strings in lru_
+    static constexpr size_t MAX_CACHED_CHUNKS = 256;
+    using CachedChunk = std::pair<std::string, std::string>;  // source, bytecode
+    std::list<CachedChunk>                                                 bytecode_lru_;
+    std::unordered_map<std::string_view, std::list<CachedChunk>::iterator> bytecode_cache_;
+    std::mutex                                                             cache_mutex_;
+
+    struct PhaseSample {
+        float queue, compile, transfer, run, total;
+    };
+    static constexpr size_t LATENCY_WINDOW = 1024;
 
     mutable std::mutex              history_mutex_;
     std::deque<ExecutionResult>     execution_history_;
     size_t                          max_history_ = 100;
+    std::vector<PhaseSample>        latency_samples_;  // ring of LATENCY_WINDOW
+    size_t                          latency_next_ = 0;
+
+    static constexpr size_t MAX_TRACES = 64;
+    std::deque<std::pair<uint64_t, std::string>> traces_;  // guarded by history_mutex_
 
-    OutputCallback output_cb_;
-    ErrorCallback  error_cb_;
-    StatusCallback status_cb_;
-    ResultCallback result_cb_;
+    // Replaced from the UI thread while lane workers and actor threads call
+    // them, so each is swapped as a whole and read through notify()
+    mutable std::mutex                    cb_mutex_;
+    std::shared_ptr<const OutputCallback> output_cb_;
+    std::shared_ptr<const ErrorCallback>  error_cb_;
+    std::shared_ptr<const StatusCallback> status_cb_;
+    std::shared_ptr<const ResultCallback> result_cb_;
 };
 
 } // namespace oss
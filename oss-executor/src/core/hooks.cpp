@@ -7,11 +7,13 @@
 #include <link.h>
 #include <elf.h>
 #include <unistd.h>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <stdexcept>
+#include <string_view>
 
 namespace oss {
 
@@ -108,40 +110,238 @@ std::vector<HookManager::MemRegionInfo> HookManager::parse_proc_maps(pid_t pid)
     return regions;
 }
 
-bool HookManager::is_address_in_own_process(uintptr_t addr) {
-    auto regions = parse_self_maps();
-    for (const auto& r : regions)
-        if (addr >= r.start && addr < r.end) return true;
-    return false;
+const HookManager::MemRegionInfo* HookManager::self_region(uintptr_t addr) {
+    for (int pass = 0; pass < 2; ++pass) {
+        auto it = std::upper_bound(self_regions_.begin(), self_regions_.end(), addr,
+            [](uintptr_t a, const MemRegionInfo& r) { return a < r.end; });
+        if (it != self_regions_.end() && it->start <= addr) return &*it;
+        if (pass == 0) self_regions_ = parse_self_maps();
+    }
+    return nullptr;
 }
 
-int HookManager::get_region_protection(uintptr_t addr) {
-    auto regions = parse_self_maps();
-    for (const auto& r : regions)
-        if (addr >= r.start && addr < r.end) return r.prot;
-    return PROT_READ | PROT_EXEC;
+// ── Trampolines ──
+
+// Enough for the displaced prologue plus an absolute jump back on either arch
+static constexpr size_t TRAMPOLINE_SLOT = 32;
+
+#if defined(__x86_64__)
+static constexpr size_t HOOK_SIZE = 14;
+
+// jmp qword ptr [rip+0]; .quad to
+static std::vector<uint8_t> abs_jump(uintptr_t to) {
+    std::vector<uint8_t> code = {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+    code.resize(HOOK_SIZE);
+    std::memcpy(code.data() + 6, &to, 8);
+    return code;
+}
+#elif defined(__aarch64__)
+static constexpr size_t HOOK_SIZE = 16;
+
+// ldr x17, #8; br x17; .quad to
+static std::vector<uint8_t> abs_jump(uintptr_t to) {
+    const uint32_t insns[2] = {0x58000051, 0xD61F0220};
+    std::vector<uint8_t> code(HOOK_SIZE);
+    std::memcpy(code.data(), insns, 8);
+    std::memcpy(code.data() + 8, &to, 8);
+    return code;
+}
+#else
+    #error "Unsupported architecture"
+#endif
+
+static_assert(HOOK_SIZE * 2 <= TRAMPOLINE_SLOT, "trampoline slot too small");
+
+// Slots come from a page within ±2GB of the target when one exists or can be
+// mapped there, otherwise from any page with room.
+uintptr_t HookManager::alloc_trampoline(uintptr_t near) {
+    auto is_near = [&](uintptr_t base) {
+        uintptr_t d = base > near ? base - near : near - base;
+        return d < (uintptr_t{1} << 31) - page_size_;
+    };
+    auto take = [&](SlabPage& page) {
+        for (size_t i = 0; i < page.used.size(); ++i) {
+            if (page.used[i]) continue;
+            page.used[i] = true;
+            page.live++;
+            return page.base + i * TRAMPOLINE_SLOT;
+        }
+        return uintptr_t{0};
+    };
+
+    SlabPage* any_free = nullptr;
+    for (auto& page : slab_) {
+        if (page.live == page.used.size()) continue;
+        if (is_near(page.base)) return take(page);
+        if (!any_free) any_free = &page;
+    }
+
+    uintptr_t hint = near > (uintptr_t{1} << 30) ? (near - (uintptr_t{1} << 30)) & ~(page_size_ - 1) : 0;
+    void* mem = mmap(reinterpret_cast<void*>(hint), page_size_, PROT_READ | PROT_EXEC,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) return any_free ? take(*any_free) : 0;
+
+    uintptr_t base = reinterpret_cast<uintptr_t>(mem);
+    if (!is_near(base) && any_free) {
+        munmap(mem, page_size_);
+        return take(*any_free);
+    }
+    slab_.push_back({base, std::vector<bool>(page_size_ / TRAMPOLINE_SLOT, false), 0});
+    return take(slab_.back());
 }
 
-bool HookManager::make_writable(uintptr_t addr, size_t size) {
-    uintptr_t mask = ~(page_size_ - 1);
-    uintptr_t page_start = addr & mask;
-    size_t total = ((addr + size + page_size_ - 1) & mask) - page_start;
-    return mprotect(reinterpret_cast<void*>(page_start), total,
-                    PROT_READ | PROT_WRITE | PROT_EXEC) == 0;
+void HookManager::free_trampoline(uintptr_t slot) {
+    for (auto it = slab_.begin(); it != slab_.end(); ++it) {
+        if (slot < it->base || slot >= it->base + page_size_) continue;
+        size_t i = (slot - it->base) / TRAMPOLINE_SLOT;
+        if (it->used[i]) {
+            it->used[i] = false;
+            it->live--;
+        }
+        if (it->live == 0) {
+            munmap(reinterpret_cast<void*>(it->base), page_size_);
+            slab_.erase(it);
+        }
+        return;
+    }
+}
+
+// ── Patching ──
+
+// Patches are sorted and split into runs of adjacent pages sharing one
+// protection; each run is made writable once, written, and restored.
+// The sort is stable, so patches to the same address land in the order they
+// were queued and the last one wins. Returns how many could not be written.
+size_t HookManager::apply_patches(std::vector<Patch>& patches) {
+    std::stable_sort(patches.begin(), patches.end(),
+                     [](const Patch& a, const Patch& b) { return a.addr < b.addr; });
+
+    const uintptr_t mask = ~(page_size_ - 1);
+    auto page_end = [&](const Patch& p) { return (p.addr + p.bytes.size() + page_size_ - 1) & mask; };
+
+    size_t failed = 0;
+    for (size_t i = 0; i < patches.size();) {
+        uintptr_t lo = patches[i].addr & mask;
+        uintptr_t hi = page_end(patches[i]);
+        size_t j = i + 1;
+        while (j < patches.size() && patches[j].prot == patches[i].prot &&
+               (patches[j].addr & mask) <= hi) {
+            hi = std::max(hi, page_end(patches[j]));
+            ++j;
+        }
+
+        void* run = reinterpret_cast<void*>(lo);
+        if (mprotect(run, hi - lo, PROT_READ | PROT_WRITE | PROT_EXEC) == 0) {
+            for (size_t k = i; k < j; ++k) {
+                auto& p = patches[k];
+                std::memcpy(reinterpret_cast<void*>(p.addr), p.bytes.data(), p.bytes.size());
+#if defined(__aarch64__)
+                __builtin___clear_cache(reinterpret_cast<char*>(p.addr),
+                                        reinterpret_cast<char*>(p.addr + p.bytes.size()));
+#endif
+                p.applied = true;
+            }
+            mprotect(run, hi - lo, patches[i].prot);
+        } else {
+            LOG_ERROR("Cannot make {:#x}-{:#x} writable: {}", lo, hi, strerror(errno));
+            failed += j - i;
+        }
+        i = j;
+    }
+    return failed;
 }
 
-bool HookManager::restore_protection(uintptr_t addr, size_t size, int old_prot) {
-    uintptr_t mask = ~(page_size_ - 1);
-    uintptr_t page_start = addr & mask;
-    size_t total = ((addr + size + page_size_ - 1) & mask) - page_start;
-    return mprotect(reinterpret_cast<void*>(page_start), total, old_prot) == 0;
+// Trampolines land first, then the jumps into them; a hook whose trampoline
+// failed never gets its jump written.
+bool HookManager::commit_locked() {
+    std::unordered_map<uintptr_t, bool> failed;
+    size_t bad = apply_patches(pending_code_);
+    for (const auto& p : pending_code_)
+        if (!p.applied) failed[p.owner] = true;
+
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                   [&](const Patch& p) { return failed.count(p.owner) > 0; }), pending_.end());
+    bad += apply_patches(pending_);
+    for (const auto& p : pending_)
+        if (!p.applied) failed[p.owner] = true;
+
+    for (const auto& inst : pending_installs_) {
+        bool ok = !failed.count(inst.owner);
+        if (inst.plt_symbol.empty()) {
+            auto it = hooks_.find(inst.owner);
+            if (it == hooks_.end()) continue;
+            if (ok) {
+                it->second.active = true;
+                LOG_INFO("Installed hook '{}' at {:#x} -> {:#x}",
+                         it->second.name, it->second.target, it->second.detour);
+            } else {
+                LOG_ERROR("Failed to patch target for {}", it->second.name);
+                free_trampoline(it->second.trampoline);
+                hooks_.erase(it);
+            }
+        } else {
+            auto it = plt_hooks_.find(inst.plt_symbol);
+            if (it == plt_hooks_.end()) continue;
+            if (ok) {
+                it->second.active = true;
+                LOG_INFO("Installed PLT hook for {} at GOT {:#x}", inst.plt_symbol, inst.owner);
+            } else {
+                LOG_ERROR("Cannot make GOT writable for {}", inst.plt_symbol);
+                plt_hooks_.erase(it);
+            }
+        }
+    }
+
+    // A trampoline whose hook could not be unpatched stays mapped
+    for (const auto& [owner, slot] : pending_frees_)
+        if (!failed.count(owner)) free_trampoline(slot);
+
+    pending_code_.clear();
+    pending_.clear();
+    pending_installs_.clear();
+    pending_frees_.clear();
+    return bad == 0;
+}
+
+void HookManager::drop_pending(uintptr_t owner) {
+    auto mine = [owner](const Patch& p) { return p.owner == owner; };
+    pending_code_.erase(std::remove_if(pending_code_.begin(), pending_code_.end(), mine),
+                        pending_code_.end());
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(), mine), pending_.end());
+    pending_installs_.erase(std::remove_if(pending_installs_.begin(), pending_installs_.end(),
+                            [owner](const PendingInstall& i) { return i.owner == owner; }),
+                            pending_installs_.end());
+}
+
+// Bytes about to be snapshotted must not have a patch still queued over
+// them (say, the restore of a hook removed earlier in this batch, whose jump
+// is still in memory), so such a batch is committed first
+void HookManager::settle_pending(uintptr_t addr, size_t len) {
+    auto overlaps = [&](const Patch& p) {
+        return p.addr < addr + len && addr < p.addr + p.bytes.size();
+    };
+    if (std::any_of(pending_.begin(), pending_.end(), overlaps) ||
+        std::any_of(pending_code_.begin(), pending_code_.end(), overlaps))
+        commit_locked();
+}
+
+void HookManager::begin_batch() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++batch_depth_;
+}
+
+bool HookManager::commit_batch() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (batch_depth_ > 0 && --batch_depth_ > 0) return true;
+    return commit_locked();
 }
 
 bool HookManager::install_hook(uintptr_t target, uintptr_t detour,
                                 uintptr_t* original, const std::string& name) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!is_address_in_own_process(target)) {
+    const MemRegionInfo* region = self_region(target);
+    if (!region) {
         LOG_ERROR("Hook target {:#x} not in own process", target);
         return false;
     }
@@ -156,101 +356,44 @@ bool HookManager::install_hook(uintptr_t target, uintptr_t detour,
     hook.detour = detour;
     hook.name   = name.empty() ? ("hook_" + std::to_string(target)) : name;
     hook.active = false;
-    hook.original_prot = get_region_protection(target);
-
-#if defined(__x86_64__)
-    constexpr size_t HOOK_SIZE = 14;
+    hook.original_prot = region->prot;
 
+    settle_pending(target, HOOK_SIZE);
     hook.original_bytes.resize(HOOK_SIZE);
     std::memcpy(hook.original_bytes.data(),
                 reinterpret_cast<const void*>(target), HOOK_SIZE);
 
-    void* tramp = mmap(nullptr, page_size_,
-                       PROT_READ | PROT_WRITE | PROT_EXEC,
-                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (tramp == MAP_FAILED) {
+    hook.trampoline = alloc_trampoline(target);
+    if (!hook.trampoline) {
         LOG_ERROR("Failed to allocate trampoline for {}", hook.name);
         return false;
     }
-    hook.trampoline = reinterpret_cast<uintptr_t>(tramp);
-
-    std::memcpy(tramp, hook.original_bytes.data(), HOOK_SIZE);
 
-    uint8_t* tramp_jmp = static_cast<uint8_t*>(tramp) + HOOK_SIZE;
-    tramp_jmp[0] = 0xFF;
-    tramp_jmp[1] = 0x25;
-    std::memset(tramp_jmp + 2, 0, 4);
-    uint64_t return_addr = target + HOOK_SIZE;
-    std::memcpy(tramp_jmp + 6, &return_addr, 8);
-
-    if (!make_writable(target, HOOK_SIZE)) {
-        munmap(tramp, page_size_);
-        LOG_ERROR("Failed to make target writable for {}", hook.name);
-        return false;
-    }
+    std::vector<uint8_t> tramp = hook.original_bytes;
+    auto back = abs_jump(target + HOOK_SIZE);
+    tramp.insert(tramp.end(), back.begin(), back.end());
 
-    uint8_t* target_ptr = reinterpret_cast<uint8_t*>(target);
-    target_ptr[0] = 0xFF;
-    target_ptr[1] = 0x25;
-    std::memset(target_ptr + 2, 0, 4);
-    std::memcpy(target_ptr + 6, &detour, 8);
-
-    restore_protection(target, HOOK_SIZE, hook.original_prot);
-
-#elif defined(__aarch64__)
-    constexpr size_t HOOK_SIZE = 16;
-
-    hook.original_bytes.resize(HOOK_SIZE);
-    std::memcpy(hook.original_bytes.data(),
-                reinterpret_cast<const void*>(target), HOOK_SIZE);
-
-    void* tramp = mmap(nullptr, page_size_,
-                       PROT_READ | PROT_WRITE | PROT_EXEC,
-                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (tramp == MAP_FAILED) {
-        LOG_ERROR("Failed to allocate trampoline for {}", hook.name);
-        return false;
-    }
-    hook.trampoline = reinterpret_cast<uintptr_t>(tramp);
+    pending_code_.push_back({hook.trampoline, std::move(tramp), PROT_READ | PROT_EXEC, target});
+    pending_.push_back({target, abs_jump(detour), hook.original_prot, target});
+    pending_installs_.push_back({target, {}});
 
-    std::memcpy(tramp, hook.original_bytes.data(), HOOK_SIZE);
-
-    uint32_t* tramp_code = reinterpret_cast<uint32_t*>(
-        static_cast<uint8_t*>(tramp) + HOOK_SIZE);
-    uintptr_t tramp_return = target + HOOK_SIZE;
-    tramp_code[0] = 0x58000051;
-    tramp_code[1] = 0xD61F0220;
-    std::memcpy(&tramp_code[2], &tramp_return, 8);
+    if (original) *original = hook.trampoline;
+    hooks_[target] = std::move(hook);
 
-    __builtin___clear_cache(static_cast<char*>(tramp),
-                            static_cast<char*>(tramp) + page_size_);
+    if (batch_depth_ > 0) return true;
+    return commit_locked();
+}
 
-    if (!make_writable(target, HOOK_SIZE)) {
-        munmap(tramp, page_size_);
-        LOG_ERROR("Failed to make target writable for {}", hook.name);
-        return false;
+// Queues the restore of a hook's original bytes and the release of its
+// trampoline; a hook still waiting on commit just has its patches dropped.
+void HookManager::queue_hook_removal(Hook& hook) {
+    drop_pending(hook.target);
+    if (hook.active) {
+        const MemRegionInfo* region = self_region(hook.target);
+        if (region)
+            pending_.push_back({hook.target, hook.original_bytes, hook.original_prot, hook.target});
     }
-
-    uint32_t* target_code = reinterpret_cast<uint32_t*>(target);
-    target_code[0] = 0x58000051;
-    target_code[1] = 0xD61F0220;
-    std::memcpy(&target_code[2], &detour, 8);
-
-    __builtin___clear_cache(reinterpret_cast<char*>(target),
-                            reinterpret_cast<char*>(target + HOOK_SIZE));
-
-    restore_protection(target, HOOK_SIZE, hook.original_prot);
-#else
-    #error "Unsupported architecture"
-#endif
-
-    hook.active = true;
-    if (original) *original = hook.trampoline;
-
-    hooks_[target] = std::move(hook);
-    LOG_INFO("Installed hook '{}' at {:#x} -> {:#x}",
-             hooks_[target].name, target, detour);
-    return true;
+    if (hook.trampoline) pending_frees_.push_back({hook.target, hook.trampoline});
 }
 
 bool HookManager::remove_hook(uintptr_t target) {
@@ -259,25 +402,11 @@ bool HookManager::remove_hook(uintptr_t target) {
     auto it = hooks_.find(target);
     if (it == hooks_.end()) return false;
 
-    auto& hook = it->second;
-    if (hook.active && is_address_in_own_process(target)) {
-        size_t sz = hook.original_bytes.size();
-        if (make_writable(target, sz)) {
-            std::memcpy(reinterpret_cast<void*>(target),
-                        hook.original_bytes.data(), sz);
-            restore_protection(target, sz, hook.original_prot);
-#if defined(__aarch64__)
-            __builtin___clear_cache(reinterpret_cast<char*>(target),
-                                    reinterpret_cast<char*>(target + sz));
-#endif
-        }
-    }
-
-    if (hook.trampoline)
-        munmap(reinterpret_cast<void*>(hook.trampoline), page_size_);
-
-    LOG_INFO("Removed hook '{}' at {:#x}", hook.name, target);
+    queue_hook_removal(it->second);
+    LOG_INFO("Removed hook '{}' at {:#x}", it->second.name, target);
     hooks_.erase(it);
+
+    if (batch_depth_ == 0) commit_locked();
     return true;
 }
 
@@ -356,194 +485,255 @@ uintptr_t HookManager::find_got_entry(const std::string& library,
     return data.result;
 }
 
-uintptr_t HookManager::find_remote_got_entry(pid_t pid, const std::string& library,
-                                              const std::string& symbol) {
-    auto regions = parse_proc_maps(pid);
+// ── Remote modules ──
+
+// Anything larger is a corrupt header, not a dynamic table
+static constexpr size_t MAX_REMOTE_TABLE = 64u << 20;
 
-    uintptr_t lib_base = 0;
-    std::string lib_path;
+RemoteModule::Ptr RemoteModule::load(pid_t pid, const std::string& library) {
+    if (pid <= 0 || library.empty()) return nullptr;
+
+    std::shared_ptr<RemoteModule> mod(new RemoteModule());
+    mod->pid_ = pid;
+
+    Memory mem(pid);
+    auto regions = mem.get_regions(true);
     for (const auto& r : regions) {
-        if (!library.empty() && r.path.find(library) != std::string::npos) {
-            if (!lib_base || r.start < lib_base) {
-                lib_base = r.start;
-                lib_path = r.path;
-            }
+        if (r.path.find(library) == std::string::npos) continue;
+        if (!mod->base_ || r.start < mod->base_) {
+            mod->base_ = r.start;
+            mod->path_ = r.path;
         }
     }
-    if (!lib_base) return 0;
+    if (!mod->base_) return nullptr;
+    for (const auto& r : regions)
+        if (r.path == mod->path_ && r.end > mod->end_) mod->end_ = r.end;
 
-    Memory mem(pid);
-    if (!mem.attach()) return 0;
+    // Vectored reads need no fd; only open /proc/pid/mem if they are refused
+    if (!mod->read(mem) && (!mem.attach() || !mod->read(mem))) return nullptr;
+    return mod;
+}
+
+bool RemoteModule::read(Memory& mem) {
+    symbols_.clear();
+    got_.clear();
 
+    // ELF header and program headers nearly always share the first page
+    std::vector<uint8_t> head(4096);
+    if (!mem.read(base_, head.data(), head.size())) {
+        head.resize(sizeof(ElfW(Ehdr)));
+        if (!mem.read(base_, head.data(), head.size())) return false;
+    }
     ElfW(Ehdr) ehdr{};
-    if (!mem.read(lib_base, &ehdr, sizeof(ehdr))) return 0;
-    if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0) return 0;
+    std::memcpy(&ehdr, head.data(), sizeof(ehdr));
+    if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0) return false;
 
     std::vector<ElfW(Phdr)> phdrs(ehdr.e_phnum);
-    if (!mem.read(lib_base + ehdr.e_phoff, phdrs.data(),
-                  ehdr.e_phnum * sizeof(ElfW(Phdr)))) return 0;
+    size_t ph_bytes = phdrs.size() * sizeof(ElfW(Phdr));
+    if (ehdr.e_phoff + ph_bytes <= head.size())
+        std::memcpy(phdrs.data(), head.data() + ehdr.e_phoff, ph_bytes);
+    else if (!mem.read(base_ + ehdr.e_phoff, phdrs.data(), ph_bytes))
+        return false;
 
+    uintptr_t bias = (ehdr.e_type == ET_DYN) ? base_ : 0;
     uintptr_t dyn_addr = 0;
     size_t dyn_size = 0;
     for (const auto& ph : phdrs) {
         if (ph.p_type == PT_DYNAMIC) {
-            dyn_addr = lib_base + ph.p_vaddr;
+            dyn_addr = bias + ph.p_vaddr;
             dyn_size = ph.p_memsz;
             break;
         }
     }
-    if (!dyn_addr) return 0;
+    if (!dyn_addr || !dyn_size || dyn_size > MAX_REMOTE_TABLE) return false;
 
-    size_t dyn_count = dyn_size / sizeof(ElfW(Dyn));
-    std::vector<ElfW(Dyn)> dyns(dyn_count);
-    if (!mem.read(dyn_addr, dyns.data(), dyn_size)) return 0;
+    std::vector<ElfW(Dyn)> dyns(dyn_size / sizeof(ElfW(Dyn)));
+    if (!mem.read(dyn_addr, dyns.data(), dyns.size() * sizeof(ElfW(Dyn)))) return false;
 
-    uintptr_t symtab_addr = 0, strtab_addr = 0, jmprel_addr = 0;
-    size_t pltrelsz = 0;
-    uintptr_t got_bias = (ehdr.e_type == ET_DYN) ? lib_base : 0;
+    // ld.so relocates the d_ptr entries of modules it loaded in place; raw
+    // file offsets only show up for modules it never touched
+    auto addr_of = [&](uintptr_t p) { return (p >= base_ && p < end_) ? p : p + bias; };
 
+    uintptr_t symtab = 0, strtab = 0, jmprel = 0, hash = 0, gnu_hash = 0;
+    size_t strsz = 0, pltrelsz = 0;
     for (const auto& d : dyns) {
+        if (d.d_tag == DT_NULL) break;
         switch (d.d_tag) {
-            case DT_SYMTAB:   symtab_addr = d.d_un.d_ptr + got_bias; break;
-            case DT_STRTAB:   strtab_addr = d.d_un.d_ptr + got_bias; break;
-            case DT_JMPREL:   jmprel_addr = d.d_un.d_ptr + got_bias; break;
+            case DT_SYMTAB:   symtab   = addr_of(d.d_un.d_ptr); break;
+            case DT_STRTAB:   strtab   = addr_of(d.d_un.d_ptr); break;
+            case DT_JMPREL:   jmprel   = addr_of(d.d_un.d_ptr); break;
+            case DT_HASH:     hash     = addr_of(d.d_un.d_ptr); break;
+            case DT_GNU_HASH: gnu_hash = addr_of(d.d_un.d_ptr); break;
+            case DT_STRSZ:    strsz    = d.d_un.d_val; break;
             case DT_PLTRELSZ: pltrelsz = d.d_un.d_val; break;
             default: break;
         }
     }
+    if (!symtab || !strtab || !strsz || strsz > MAX_REMOTE_TABLE || pltrelsz > MAX_REMOTE_TABLE)
+        return false;
+    if (!jmprel) pltrelsz = 0;
+
+    // Round one: string table, PLT relocations and the hash table header
+    std::vector<char> strings(strsz);
+    std::vector<ElfW(Rela)> relas(pltrelsz / sizeof(ElfW(Rela)));
+    uint32_t hash_head[4]{};
+    std::vector<Memory::BatchReadEntry> batch;
+    batch.push_back({strtab, strings.data(), strings.size()});
+    if (!relas.empty())
+        batch.push_back({jmprel, relas.data(), relas.size() * sizeof(ElfW(Rela))});
+    if (hash)          batch.push_back({hash, hash_head, 8});
+    else if (gnu_hash) batch.push_back({gnu_hash, hash_head, 16});
+    mem.batch_read(batch);
+    if (!batch[0].success) return false;
+    if (!relas.empty() && !batch[1].success) relas.clear();
+    bool have_head = (hash || gnu_hash) && batch.back().success;
+
+    // The symbol count isn't stored anywhere directly: DT_HASH has it as
+    // nchain, DT_GNU_HASH needs the end of the chain of the highest bucket
+    size_t nsyms = 0;
+    if (hash && have_head) {
+        nsyms = hash_head[1];
+    } else if (gnu_hash && have_head) {
+        uint32_t nbuckets = hash_head[0], symoffset = hash_head[1], bloom_size = hash_head[2];
+        uintptr_t buckets_addr = gnu_hash + 16 + static_cast<uintptr_t>(bloom_size) * sizeof(uintptr_t);
+        std::vector<uint32_t> buckets(nbuckets);
+        if (nbuckets && nbuckets * 4u <= MAX_REMOTE_TABLE &&
+            mem.read(buckets_addr, buckets.data(), buckets.size() * 4)) {
+            uint32_t last = *std::max_element(buckets.begin(), buckets.end());
+            if (last >= symoffset) {
+                uintptr_t chain_addr = buckets_addr + nbuckets * 4u + (last - symoffset) * 4u;
+                uint32_t chunk[256];
+                for (size_t n = last; nsyms == 0 && chain_addr < end_; chain_addr += sizeof(chunk)) {
+                    size_t want = std::min<size_t>(sizeof(chunk), end_ - chain_addr) & ~size_t{3};
+                    if (!want || !mem.read(chain_addr, chunk, want)) break;
+                    for (size_t i = 0; i < want / 4; i++, n++) {
+                        if (chunk[i] & 1) { nsyms = n + 1; break; }
+                    }
+                }
+            } else {
+                nsyms = symoffset;
+            }
+        }
+    }
+    // .dynsym sits directly before .dynstr in every common link layout
+    if (!nsyms && strtab > symtab) nsyms = (strtab - symtab) / sizeof(ElfW(Sym));
+    if (!nsyms || nsyms * sizeof(ElfW(Sym)) > MAX_REMOTE_TABLE) return false;
+
+    // Round two: the whole symbol table
+    std::vector<ElfW(Sym)> syms(nsyms);
+    if (!mem.read(symtab, syms.data(), syms.size() * sizeof(ElfW(Sym)))) return false;
+
+    auto name_of = [&](const ElfW(Sym)& sym) -> std::string_view {
+        if (sym.st_name == 0 || sym.st_name >= strsz) return {};
+        const char* p = strings.data() + sym.st_name;
+        return {p, strnlen(p, strsz - sym.st_name)};
+    };
 
-    if (!symtab_addr || !strtab_addr || !jmprel_addr || !pltrelsz) return 0;
-
-    size_t num_rela = pltrelsz / sizeof(ElfW(Rela));
-    for (size_t i = 0; i < num_rela; ++i) {
-        ElfW(Rela) rela{};
-        if (!mem.read(jmprel_addr + i * sizeof(ElfW(Rela)), &rela, sizeof(rela)))
-            continue;
-
-        size_t sym_idx = ELF64_R_SYM(rela.r_info);
-        ElfW(Sym) sym{};
-        if (!mem.read(symtab_addr + sym_idx * sizeof(ElfW(Sym)), &sym, sizeof(sym)))
-            continue;
-
-        char sym_name[256]{};
-        if (!mem.read(strtab_addr + sym.st_name, sym_name, sizeof(sym_name) - 1))
-            continue;
-        sym_name[sizeof(sym_name) - 1] = '\0';
+    symbols_.reserve(syms.size());
+    for (const auto& sym : syms) {
+        if (sym.st_value == 0 || sym.st_shndx == SHN_UNDEF) continue;
+        auto name = name_of(sym);
+        if (!name.empty()) symbols_.emplace(std::string(name), bias + sym.st_value);
+    }
 
-        if (symbol == sym_name)
-            return lib_base + rela.r_offset;
+    got_.reserve(relas.size());
+    for (const auto& rela : relas) {
+        size_t idx = ELF64_R_SYM(rela.r_info);
+        if (idx >= syms.size()) continue;
+        auto name = name_of(syms[idx]);
+        if (!name.empty()) got_.emplace(std::string(name), bias + rela.r_offset);
     }
 
-    return 0;
+    LOG_DEBUG("Loaded remote module {} (pid {}): {} symbols, {} PLT slots",
+              path_, pid_, symbols_.size(), got_.size());
+    return true;
 }
 
-uintptr_t HookManager::find_remote_symbol(pid_t pid, const std::string& library,
-                                           const std::string& symbol) {
-    auto regions = parse_proc_maps(pid);
-
-    uintptr_t lib_base = 0;
-    for (const auto& r : regions) {
-        if (!library.empty() && r.path.find(library) != std::string::npos) {
-            if (!lib_base || r.start < lib_base)
-                lib_base = r.start;
-        }
-    }
-    if (!lib_base) return 0;
+uintptr_t RemoteModule::symbol(const std::string& name) const {
+    auto it = symbols_.find(name);
+    return it != symbols_.end() ? it->second : 0;
+}
 
-    Memory mem(pid);
-    if (!mem.attach()) return 0;
+uintptr_t RemoteModule::got_entry(const std::string& name) const {
+    auto it = got_.find(name);
+    return it != got_.end() ? it->second : 0;
+}
 
-    ElfW(Ehdr) ehdr{};
-    if (!mem.read(lib_base, &ehdr, sizeof(ehdr))) return 0;
-    if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0) return 0;
+// Field 22 of /proc/pid/stat; tells a reused pid apart from the original
+static uint64_t process_start_time(pid_t pid) {
+    std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+    std::string line;
+    if (!std::getline(stat, line)) return 0;
+    auto rp = line.rfind(')');
+    if (rp == std::string::npos || rp + 2 > line.size()) return 0;
+
+    std::istringstream iss(line.substr(rp + 2));
+    std::string skip;
+    for (int field = 3; field < 22; ++field) iss >> skip;
+    uint64_t start = 0;
+    iss >> start;
+    return start;
+}
 
-    std::vector<ElfW(Phdr)> phdrs(ehdr.e_phnum);
-    if (!mem.read(lib_base + ehdr.e_phoff, phdrs.data(),
-                  ehdr.e_phnum * sizeof(ElfW(Phdr)))) return 0;
+RemoteModule::Ptr HookManager::remote_module(pid_t pid, const std::string& library) {
+    uint64_t started = process_start_time(pid);
+    if (!started) return nullptr;
 
-    uintptr_t dyn_addr = 0;
-    size_t dyn_size = 0;
-    for (const auto& ph : phdrs) {
-        if (ph.p_type == PT_DYNAMIC) {
-            dyn_addr = lib_base + ph.p_vaddr;
-            dyn_size = ph.p_memsz;
-            break;
-        }
+    std::string key = std::to_string(pid) + ":" + library;
+    {
+        std::lock_guard<std::mutex> lock(modules_mutex_);
+        auto it = remote_modules_.find(key);
+        if (it != remote_modules_.end() && it->second.start_time == started)
+            return it->second.module;
     }
-    if (!dyn_addr) return 0;
-
-    size_t dyn_count = dyn_size / sizeof(ElfW(Dyn));
-    std::vector<ElfW(Dyn)> dyns(dyn_count);
-    if (!mem.read(dyn_addr, dyns.data(), dyn_size)) return 0;
 
-    uintptr_t symtab_addr = 0, strtab_addr = 0;
-    size_t strtab_size = 0;
-    uintptr_t hash_addr = 0, gnu_hash_addr = 0;
-    uintptr_t sym_bias = (ehdr.e_type == ET_DYN) ? lib_base : 0;
+    auto mod = RemoteModule::load(pid, library);
+    if (!mod) return nullptr;
 
-    for (const auto& d : dyns) {
-        switch (d.d_tag) {
-            case DT_SYMTAB:   symtab_addr = d.d_un.d_ptr + sym_bias; break;
-            case DT_STRTAB:   strtab_addr = d.d_un.d_ptr + sym_bias; break;
-            case DT_STRSZ:    strtab_size = d.d_un.d_val; break;
-            case DT_HASH:     hash_addr = d.d_un.d_ptr + sym_bias; break;
-            case DT_GNU_HASH: gnu_hash_addr = d.d_un.d_ptr + sym_bias; break;
-            default: break;
-        }
-    }
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    remote_modules_[key] = {started, mod};
+    return mod;
+}
 
-    if (!symtab_addr || !strtab_addr) return 0;
-
-    size_t num_syms = 0;
-    if (hash_addr) {
-        uint32_t hash_header[2]{};
-        if (mem.read(hash_addr, hash_header, sizeof(hash_header)))
-            num_syms = hash_header[1];
-    } else if (gnu_hash_addr) {
-        uint32_t gnu_header[4]{};
-        if (mem.read(gnu_hash_addr, gnu_header, sizeof(gnu_header))) {
-            uint32_t nbuckets = gnu_header[0];
-            uint32_t symoffset = gnu_header[1];
-            uint32_t bloom_size = gnu_header[2];
-            uintptr_t buckets_addr = gnu_hash_addr + 16 + bloom_size * sizeof(uintptr_t);
-            uint32_t max_bucket = 0;
-            for (uint32_t i = 0; i < nbuckets; ++i) {
-                uint32_t val = 0;
-                mem.read(buckets_addr + i * 4, &val, 4);
-                if (val > max_bucket) max_bucket = val;
-            }
-            if (max_bucket >= symoffset) {
-                uintptr_t chains_addr = buckets_addr + nbuckets * 4;
-                uint32_t chain_idx = max_bucket - symoffset;
-                uint32_t chain_val = 0;
-                do {
-                    mem.read(chains_addr + chain_idx * 4, &chain_val, 4);
-                    ++chain_idx;
-                } while (!(chain_val & 1));
-                num_syms = symoffset + chain_idx;
-            }
-        }
+void HookManager::forget_remote_modules(pid_t pid) {
+    std::string prefix = std::to_string(pid) + ":";
+    std::lock_guard<std::mutex> lock(modules_mutex_);
+    for (auto it = remote_modules_.begin(); it != remote_modules_.end(); ) {
+        if (it->first.compare(0, prefix.size(), prefix) == 0)
+            it = remote_modules_.erase(it);
+        else
+            ++it;
     }
+}
 
-    if (!num_syms) num_syms = 4096;
-
-    for (size_t i = 0; i < num_syms; ++i) {
-        ElfW(Sym) sym{};
-        if (!mem.read(symtab_addr + i * sizeof(ElfW(Sym)), &sym, sizeof(sym)))
-            continue;
-        if (sym.st_name == 0 || sym.st_value == 0) continue;
-        if (sym.st_name >= strtab_size && strtab_size > 0) continue;
+uintptr_t HookManager::find_remote_got_entry(pid_t pid, const std::string& library,
+                                              const std::string& symbol) {
+    auto mod = remote_module(pid, library);
+    return mod ? mod->got_entry(symbol) : 0;
+}
 
-        char name_buf[256]{};
-        if (!mem.read(strtab_addr + sym.st_name, name_buf, sizeof(name_buf) - 1))
-            continue;
-        name_buf[sizeof(name_buf) - 1] = '\0';
+uintptr_t HookManager::find_remote_symbol(pid_t pid, const std::string& library,
+                                           const std::string& symbol) {
+    auto mod = remote_module(pid, library);
+    return mod ? mod->symbol(symbol) : 0;
+}
 
-        if (symbol == name_buf)
-            return lib_base + sym.st_value;
-    }
+std::vector<uintptr_t> HookManager::find_remote_symbols(pid_t pid, const std::string& library,
+                                                        const std::vector<std::string>& symbols) {
+    std::vector<uintptr_t> out(symbols.size(), 0);
+    auto mod = remote_module(pid, library);
+    if (!mod) return out;
+    for (size_t i = 0; i < symbols.size(); ++i) out[i] = mod->symbol(symbols[i]);
+    return out;
+}
 
-    return 0;
+std::vector<uintptr_t> HookManager::find_remote_got_entries(pid_t pid, const std::string& library,
+                                                            const std::vector<std::string>& symbols) {
+    std::vector<uintptr_t> out(symbols.size(), 0);
+    auto mod = remote_module(pid, library);
+    if (!mod) return out;
+    for (size_t i = 0; i < symbols.size(); ++i) out[i] = mod->got_entry(symbols[i]);
+    return out;
 }
 
 bool HookManager::install_plt_hook(const std::string& library,
@@ -562,25 +752,25 @@ bool HookManager::install_plt_hook(const std::string& library,
         return false;
     }
 
+    const MemRegionInfo* region = self_region(got);
+
     PLTHook hook;
     hook.got_entry   = got;
     hook.symbol_name = symbol;
     hook.detour_func = detour;
-    hook.original_prot = get_region_protection(got);
+    hook.original_prot = region ? region->prot : PROT_READ;
+    settle_pending(got, sizeof(uintptr_t));
     hook.original_func = *reinterpret_cast<uintptr_t*>(got);
     if (original) *original = hook.original_func;
 
-    if (!make_writable(got, sizeof(uintptr_t))) {
-        LOG_ERROR("Cannot make GOT writable for {}", symbol);
-        return false;
-    }
-
-    *reinterpret_cast<uintptr_t*>(got) = detour;
-
-    hook.active = true;
+    Patch patch{got, std::vector<uint8_t>(sizeof(uintptr_t)), hook.original_prot, got};
+    std::memcpy(patch.bytes.data(), &detour, sizeof(detour));
+    pending_.push_back(std::move(patch));
+    pending_installs_.push_back({got, symbol});
     plt_hooks_[symbol] = hook;
-    LOG_INFO("Installed PLT hook for {} at GOT {:#x}", symbol, got);
-    return true;
+
+    if (batch_depth_ > 0) return true;
+    return commit_locked();
 }
 
 bool HookManager::remove_plt_hook(const std::string& symbol) {
@@ -590,15 +780,18 @@ bool HookManager::remove_plt_hook(const std::string& symbol) {
     if (it == plt_hooks_.end()) return false;
 
     auto& hook = it->second;
+    drop_pending(hook.got_entry);
     if (hook.active && hook.got_entry) {
-        if (make_writable(hook.got_entry, sizeof(uintptr_t))) {
-            *reinterpret_cast<uintptr_t*>(hook.got_entry) = hook.original_func;
-            restore_protection(hook.got_entry, sizeof(uintptr_t), hook.original_prot);
-        }
+        Patch patch{hook.got_entry, std::vector<uint8_t>(sizeof(uintptr_t)),
+                    hook.original_prot, hook.got_entry};
+        std::memcpy(patch.bytes.data(), &hook.original_func, sizeof(uintptr_t));
+        pending_.push_back(std::move(patch));
     }
 
     LOG_INFO("Removed PLT hook for {}", symbol);
     plt_hooks_.erase(it);
+
+    if (batch_depth_ == 0) commit_locked();
     return true;
 }
 
@@ -763,34 +956,25 @@ bool HookManager::dispatch_newindex(const std::string& key, void* state) {
 void HookManager::remove_all() {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    for (auto& [target, hook] : hooks_) {
-        if (hook.active && is_address_in_own_process(target)) {
-            size_t sz = hook.original_bytes.size();
-            if (make_writable(target, sz)) {
-                std::memcpy(reinterpret_cast<void*>(target),
-                            hook.original_bytes.data(), sz);
-                restore_protection(target, sz, hook.original_prot);
-#if defined(__aarch64__)
-                __builtin___clear_cache(reinterpret_cast<char*>(target),
-                                        reinterpret_cast<char*>(target + sz));
-#endif
-            }
-        }
-        if (hook.trampoline)
-            munmap(reinterpret_cast<void*>(hook.trampoline), page_size_);
-    }
+    for (auto& [target, hook] : hooks_) queue_hook_removal(hook);
     hooks_.clear();
 
     for (auto& [sym, hook] : plt_hooks_) {
+        drop_pending(hook.got_entry);
         if (hook.active && hook.got_entry) {
-            if (make_writable(hook.got_entry, sizeof(uintptr_t))) {
-                *reinterpret_cast<uintptr_t*>(hook.got_entry) = hook.original_func;
-                restore_protection(hook.got_entry, sizeof(uintptr_t), hook.original_prot);
-            }
+            Patch patch{hook.got_entry, std::vector<uint8_t>(sizeof(uintptr_t)),
+                        hook.original_prot, hook.got_entry};
+            std::memcpy(patch.bytes.data(), &hook.original_func, sizeof(uintptr_t));
+            pending_.push_back(std::move(patch));
         }
     }
     plt_hooks_.clear();
 
+    // Everything is already unhooked as far as callers can tell, so this
+    // commits even inside a batch. The batch itself stays open: its owner's
+    // commit_batch() still closes it and applies whatever it queues next.
+    commit_locked();
+
     namecall_handler_ = nullptr;
     index_handler_    = nullptr;
     newindex_handler_ = nullptr;
@@ -815,6 +999,7 @@ void HookManager::remove_all_remote(Memory& mem) {
             ++it;
     }
 
+    forget_remote_modules(target_pid);
     LOG_INFO("All remote hooks for pid {} removed", target_pid);
 }
 
@@ -5,6 +5,7 @@
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <mutex>
 #include <cstdint>
@@ -12,6 +13,40 @@
 
 namespace oss {
 
+// Dynamic-linking view of one module mapped into another process. load()
+// pulls the dynamic section, PLT relocations, dynamic symbol table and
+// string table across in a handful of vectored reads; every lookup after
+// that is answered locally.
+class RemoteModule {
+public:
+    using Ptr = std::shared_ptr<const RemoteModule>;
+
+    // `library` matches the lowest mapping whose path contains it
+    static Ptr load(pid_t pid, const std::string& library);
+
+    pid_t              pid()  const { return pid_; }
+    uintptr_t          base() const { return base_; }
+    const std::string& path() const { return path_; }
+
+    // Absolute address, or 0 when the module doesn't define / import it
+    uintptr_t symbol(const std::string& name) const;
+    uintptr_t got_entry(const std::string& name) const;
+
+    size_t symbol_count() const { return symbols_.size(); }
+    size_t got_count()    const { return got_.size(); }
+
+private:
+    RemoteModule() = default;
+    bool read(Memory& mem);
+
+    pid_t       pid_  = 0;
+    uintptr_t   base_ = 0;
+    uintptr_t   end_  = 0;
+    std::string path_;
+    std::unordered_map<std::string, uintptr_t> symbols_;
+    std::unordered_map<std::string, uintptr_t> got_;
+};
+
 class HookManager {
 public:
     struct Hook {
@@ -53,6 +88,12 @@ public:
     HookManager(HookManager&&)                 = delete;
     HookManager& operator=(HookManager&&)      = delete;
 
+    // Hooks installed or removed between these two are written at commit,
+    // each touched page made writable once. Until then `original` already
+    // names the trampoline but nothing is patched. Batches nest.
+    void begin_batch();
+    bool commit_batch();
+
     bool install_hook(uintptr_t target, uintptr_t detour,
                       uintptr_t* original = nullptr,
                       const std::string& name = "");
@@ -80,6 +121,17 @@ public:
     uintptr_t find_remote_got_entry(pid_t pid, const std::string& library,
                                      const std::string& symbol);
 
+    // One module load for all names; results line up with `symbols`, 0 if missing
+    std::vector<uintptr_t> find_remote_symbols(pid_t pid, const std::string& library,
+                                               const std::vector<std::string>& symbols);
+    std::vector<uintptr_t> find_remote_got_entries(pid_t pid, const std::string& library,
+                                                   const std::vector<std::string>& symbols);
+
+    // Modules are cached per (pid, library) until the pid is reused; call this
+    // if the target may have unloaded or reloaded a library
+    RemoteModule::Ptr remote_module(pid_t pid, const std::string& library);
+    void forget_remote_modules(pid_t pid);
+
     void set_namecall_handler(NamecallHandler handler);
     void set_index_handler(IndexHandler handler);
     void set_newindex_handler(NewindexHandler handler);
@@ -104,24 +156,67 @@ private:
     HookManager();
     ~HookManager();
 
+    struct Patch {
+        uintptr_t addr = 0;
+        std::vector<uint8_t> bytes;
+        int prot = 0;               // protection the page goes back to
+        uintptr_t owner = 0;        // hook target or GOT slot this belongs to
+        bool applied = false;
+    };
+
+    struct PendingInstall {
+        uintptr_t owner = 0;
+        std::string plt_symbol;     // empty for inline hooks
+    };
+
+    // One executable page carved into fixed trampoline slots
+    struct SlabPage {
+        uintptr_t base = 0;
+        std::vector<bool> used;
+        size_t live = 0;
+    };
+
     static std::vector<MemRegionInfo> parse_self_maps();
     static std::vector<MemRegionInfo> parse_proc_maps(pid_t pid);
-    static bool is_address_in_own_process(uintptr_t addr);
     static uintptr_t find_got_entry(const std::string& library,
                                      const std::string& symbol);
 
-    int  get_region_protection(uintptr_t addr);
-    bool make_writable(uintptr_t addr, size_t size);
-    bool restore_protection(uintptr_t addr, size_t size, int old_prot);
+    // Cached /proc/self/maps entry for addr, re-read once on a miss
+    const MemRegionInfo* self_region(uintptr_t addr);
+
+    uintptr_t alloc_trampoline(uintptr_t near);
+    void      free_trampoline(uintptr_t slot);
+
+    void   queue_hook_removal(Hook& hook);
+    void   drop_pending(uintptr_t owner);
+    void   settle_pending(uintptr_t addr, size_t len);
+    size_t apply_patches(std::vector<Patch>& patches);
+    bool   commit_locked();
 
     std::unordered_map<uintptr_t, Hook> hooks_;
     std::unordered_map<std::string, PLTHook> plt_hooks_;
     std::unordered_map<std::string, RemoteHook> remote_hooks_;
 
+    struct CachedModule {
+        uint64_t start_time = 0;
+        RemoteModule::Ptr module;
+    };
+    std::mutex modules_mutex_;
+    std::unordered_map<std::string, CachedModule> remote_modules_;
+
     NamecallHandler namecall_handler_;
     IndexHandler index_handler_;
     NewindexHandler newindex_handler_;
 
+    std::vector<MemRegionInfo> self_regions_;
+    std::vector<SlabPage> slab_;
+
+    int batch_depth_ = 0;
+    std::vector<Patch> pending_code_;       // trampoline bodies, written first
+    std::vector<Patch> pending_;            // jumps into them and restores
+    std::vector<PendingInstall> pending_installs_;
+    std::vector<std::pair<uintptr_t, uintptr_t>> pending_frees_;  // (owner, slot)
+
     mutable std::mutex mutex_;
     size_t page_size_ = 4096;
 };
@@ -1,6 +1,7 @@
 #include "injection.hpp"
 #include "memory.hpp"
 #include "utils/logger.hpp"
+#include "utils/config.hpp"
 
 #include <chrono>
 #include <algorithm>
@@ -39,6 +40,7 @@ static constexpr size_t REGION_MAX      = 0x80000000ULL;
 static constexpr int    AUTOSCAN_TICKS  = 30;
 static constexpr int    TICK_MS         = 100;
 static constexpr const char* PAYLOAD_SOCK = "/tmp/oss_executor.sock";
+static const auto kTargetProcess = Config::key<std::string>("injection.target_process");
 
 static const std::string DIRECT_TARGETS[] = {
     "RobloxPlayer","RobloxPlayerBeta","RobloxPlayerBeta.exe",
@@ -544,9 +546,9 @@ ProcessInfo Injection::gather_info(pid_t pid) {
     return info;
 }
 
-void Injection::adopt_target(pid_t pid, const std::string& via) {
+void Injection::adopt_target(pid_t pid, const std::string& via, bool pinned) {
     std::string comm=read_proc_comm(pid),cmd=read_proc_cmdline(pid),exe=read_proc_exe(pid);
-    if(!is_valid_target(pid,comm,cmd,exe)) return;
+    if(pinned?is_self_process(pid):!is_valid_target(pid,comm,cmd,exe)) return;
     if(dhook_.active&&memory_.get_pid()>0&&memory_.get_pid()!=pid) cleanup_direct_hook();
     memory_.set_pid(pid); proc_info_=gather_info(pid);
     set_state(InjectionState::Found,"Found Roblox "+via+" (PID "+std::to_string(pid)+")");
@@ -632,7 +634,22 @@ bool Injection::scan_brute() {
     return false;
 }
 
+// injection.target_process pins the scan to one process name (e.g. the
+// oss_fake_target benchmark target, whose build path would otherwise trip
+// the self-process filter) and disables the Roblox heuristics.
+bool Injection::scan_pinned(const std::string& name) {
+    for(auto p:Memory::find_all_processes(name)){
+        if(is_self_process(p)) continue;
+        adopt_target(p,"pinned '"+name+"'",true); if(memory_.is_valid()) return true;}
+    return false;
+}
+
 bool Injection::scan_for_roblox() {
+    const std::string& pinned=kTargetProcess.get();
+    if(!pinned.empty()){
+        set_state(InjectionState::Scanning,"Scanning for '"+pinned+"'...");
+        if(scan_pinned(pinned)) return true;
+        set_state(InjectionState::Idle,"'"+pinned+"' not found"); return false;}
     set_state(InjectionState::Scanning,"Scanning for Roblox...");
     if(scan_flatpak()||scan_direct()||scan_wine_cmdline()||scan_wine_regions()||scan_brute()) return true;
     set_state(InjectionState::Idle,"Roblox not found"); return false;
@@ -2277,11 +2294,13 @@ uint64_t Injection::send_via_mailbox(const void* data, size_t len, uint32_t flag
     return ns;
 }
 
-bool Injection::wait_for_mailbox_ack(uint64_t armed_seq, size_t bc_len, uint8_t bc_ver) {
+bool Injection::wait_for_mailbox_ack(uint64_t armed_seq, size_t bc_len, uint8_t bc_ver,
+                                     const std::atomic<bool>* cancel) {
     if(!dhook_.active||!dhook_.mailbox_addr||armed_seq==0) return false;
     pid_t mpid=memory_.get_pid();if(mpid<=0)return false;
     for(int i=0;i<100;i++){
         usleep(50000);if(kill(mpid,0)!=0)return false;
+        if(cancel&&cancel->load(std::memory_order_acquire)){LOG_INFO("[direct-hook] ack wait cancelled");return false;}
         uint64_t ca=0;proc_mem_read(mpid,dhook_.mailbox_addr+24,&ca,8);
         if(ca>=armed_seq){LOG_INFO("[direct-hook] ack confirmed in {}ms",(i+1)*50);return true;}
         if(i%20==19){uint32_t step=0;uint8_t guard=0;uint16_t hits=0;
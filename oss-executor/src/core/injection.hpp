@@ -90,7 +90,8 @@ public:
 
     Memory& memory() { return memory_; }
     uint64_t send_via_mailbox(const void* data, size_t len, uint32_t flags);
-    bool wait_for_mailbox_ack(uint64_t armed_seq, size_t bc_len, uint8_t bc_ver);
+    bool wait_for_mailbox_ack(uint64_t armed_seq, size_t bc_len, uint8_t bc_ver,
+                              const std::atomic<bool>* cancel = nullptr);
     bool is_direct_hook() const { return dhook_.active; }
 
 private:
@@ -110,13 +111,14 @@ private:
     ProcessInfo gather_info(pid_t pid);
 
     void set_state(InjectionState s, const std::string& msg);
-    void adopt_target(pid_t pid, const std::string& via);
+    void adopt_target(pid_t pid, const std::string& via, bool pinned = false);
 
     bool scan_direct();
     bool scan_wine_cmdline();
     bool scan_wine_regions();
     bool scan_flatpak();
     bool scan_brute();
+    bool scan_pinned(const std::string& name);
     pid_t find_roblox_child(pid_t wrapper_pid);
 
     bool should_scan_region(const MemoryRegion& r) const;
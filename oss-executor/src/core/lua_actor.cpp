@@ -0,0 +1,420 @@
+#include "lua_actor.hpp"
+#include "lua_engine.hpp"
+#include "utils/logger.hpp"
+#include "utils/metrics.hpp"
+
+#include "lua.h"
+#include "lualib.h"
+
+#include <algorithm>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace oss {
+
+// ── Message encoding ──
+
+namespace {
+
+enum : uint8_t {
+    TAG_NIL, TAG_FALSE, TAG_TRUE, TAG_NUMBER, TAG_STRING,
+    TAG_BUFFER, TAG_TABLE, TAG_END, TAG_SHARED,
+};
+
+constexpr size_t MAX_TABLE_DEPTH = 32;
+
+struct Encoder {
+    lua_State*   L;
+    ActorMessage& out;
+    std::string& error;
+    std::vector<const void*> path;  // tables currently being encoded
+
+    void put(const void* p, size_t n) { out.bytes.append(static_cast<const char*>(p), n); }
+    void put_u8(uint8_t v)            { out.bytes.push_back(static_cast<char>(v)); }
+    void put_u32(uint32_t v)          { put(&v, sizeof(v)); }
+
+    void put_bytes(uint8_t tag, const void* p, size_t n) {
+        put_u8(tag);
+        put_u32(static_cast<uint32_t>(n));
+        put(p, n);
+    }
+
+    bool value(int idx) {
+        switch (lua_type(L, idx)) {
+        case LUA_TNIL:
+            put_u8(TAG_NIL);
+            break;
+        case LUA_TBOOLEAN:
+            put_u8(lua_toboolean(L, idx) ? TAG_TRUE : TAG_FALSE);
+            break;
+        case LUA_TNUMBER: {
+            double d = lua_tonumber(L, idx);
+            put_u8(TAG_NUMBER);
+            put(&d, sizeof(d));
+            break;
+        }
+        case LUA_TSTRING: {
+            size_t n = 0;
+            const char* s = lua_tolstring(L, idx, &n);
+            if (n > MAX_ACTOR_MESSAGE_BYTES) return too_large();
+            put_bytes(TAG_STRING, s, n);
+            break;
+        }
+        case LUA_TBUFFER: {
+            size_t n = 0;
+            const void* p = lua_tobuffer(L, idx, &n);
+            if (n > MAX_ACTOR_MESSAGE_BYTES) return too_large();
+            put_bytes(TAG_BUFFER, p, n);
+            break;
+        }
+        case LUA_TTABLE:
+            return table(idx);
+        case LUA_TUSERDATA:
+            if (is_shared_buffer(idx)) {
+                auto* ud = static_cast<std::shared_ptr<SharedBuffer>*>(lua_touserdata(L, idx));
+                put_u8(TAG_SHARED);
+                put_u32(static_cast<uint32_t>(out.shared.size()));
+                out.shared.push_back(*ud);
+                break;
+            }
+            [[fallthrough]];
+        default:
+            error = std::string("cannot send a ") + luaL_typename(L, idx) + " to an actor";
+            return false;
+        }
+        return out.bytes.size() <= MAX_ACTOR_MESSAGE_BYTES || too_large();
+    }
+
+    bool table(int idx) {
+        const void* p = lua_topointer(L, idx);
+        if (std::find(path.begin(), path.end(), p) != path.end()) {
+            error = "cannot send a table that contains itself";
+            return false;
+        }
+        if (path.size() >= MAX_TABLE_DEPTH || !lua_checkstack(L, 3)) {
+            error = "tables nested too deeply to send";
+            return false;
+        }
+        path.push_back(p);
+        put_u8(TAG_TABLE);
+
+        lua_pushnil(L);
+        while (lua_next(L, idx)) {
+            int top = lua_gettop(L);
+            if (!value(top - 1) || !value(top)) {
+                lua_pop(L, 2);
+                return false;
+            }
+            lua_pop(L, 1);
+        }
+        put_u8(TAG_END);
+        path.pop_back();
+        return true;
+    }
+
+    bool is_shared_buffer(int idx) {
+        if (!lua_getmetatable(L, idx)) return false;
+        luaL_getmetatable(L, SHARED_BUFFER_MT);
+        bool same = lua_rawequal(L, -1, -2) != 0;
+        lua_pop(L, 2);
+        return same;
+    }
+
+    bool too_large() {
+        error = "actor message exceeds 16 MB";
+        return false;
+    }
+};
+
+struct Decoder {
+    lua_State*          L;
+    const ActorMessage& msg;
+    size_t              pos = 0;
+
+    bool take(void* p, size_t n) {
+        if (msg.bytes.size() - pos < n) return false;
+        std::memcpy(p, msg.bytes.data() + pos, n);
+        pos += n;
+        return true;
+    }
+
+    bool take_len(uint32_t& n) {
+        return take(&n, sizeof(n)) && msg.bytes.size() - pos >= n;
+    }
+
+    // Leaves exactly one value on the stack on success, nothing on failure
+    bool value(size_t depth) {
+        uint8_t tag;
+        if (depth > MAX_TABLE_DEPTH || !lua_checkstack(L, 3) || !take(&tag, 1)) return false;
+
+        switch (tag) {
+        case TAG_NIL:   lua_pushnil(L); return true;
+        case TAG_FALSE: lua_pushboolean(L, 0); return true;
+        case TAG_TRUE:  lua_pushboolean(L, 1); return true;
+        case TAG_NUMBER: {
+            double d;
+            if (!take(&d, sizeof(d))) return false;
+            lua_pushnumber(L, d);
+            return true;
+        }
+        case TAG_STRING: {
+            uint32_t n;
+            if (!take_len(n)) return false;
+            lua_pushlstring(L, msg.bytes.data() + pos, n);
+            pos += n;
+            return true;
+        }
+        case TAG_BUFFER: {
+            uint32_t n;
+            if (!take_len(n)) return false;
+            void* b = lua_newbuffer(L, n);
+            if (n) std::memcpy(b, msg.bytes.data() + pos, n);
+            pos += n;
+            return true;
+        }
+        case TAG_TABLE:
+            lua_newtable(L);
+            while (pos < msg.bytes.size() &&
+                   static_cast<uint8_t>(msg.bytes[pos]) != TAG_END) {
+                if (!value(depth + 1)) { lua_pop(L, 1); return false; }
+                if (!value(depth + 1)) { lua_pop(L, 2); return false; }
+                if (lua_isnil(L, -2)) lua_pop(L, 2);
+                else lua_rawset(L, -3);
+            }
+            if (pos >= msg.bytes.size()) { lua_pop(L, 1); return false; }
+            ++pos;
+            return true;
+        case TAG_SHARED: {
+            uint32_t i;
+            if (!take(&i, sizeof(i)) || i >= msg.shared.size()) return false;
+            push_shared_buffer(L, msg.shared[i]);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+};
+
+} // namespace
+
+bool encode_actor_message(lua_State* L, int first, int count,
+                          ActorMessage& out, std::string& error) {
+    out.bytes.clear();
+    out.shared.clear();
+    Encoder enc{L, out, error, {}};
+    enc.put_u32(static_cast<uint32_t>(count));
+    for (int i = 0; i < count; i++)
+        if (!enc.value(first + i)) return false;
+    return true;
+}
+
+int decode_actor_message(lua_State* L, const ActorMessage& msg) {
+    Decoder dec{L, msg};
+    uint32_t count = 0;
+    if (!dec.take(&count, sizeof(count))) return 0;
+    int pushed = 0;
+    while (static_cast<uint32_t>(pushed) < count && dec.value(0)) ++pushed;
+    return pushed;
+}
+
+void push_shared_buffer(lua_State* L, std::shared_ptr<SharedBuffer> buf) {
+    void* mem = lua_newuserdatadtor(L, sizeof(std::shared_ptr<SharedBuffer>), [](void* p) {
+        static_cast<std::shared_ptr<SharedBuffer>*>(p)->~shared_ptr();
+    });
+    new (mem) std::shared_ptr<SharedBuffer>(std::move(buf));
+    luaL_getmetatable(L, SHARED_BUFFER_MT);
+    lua_setmetatable(L, -2);
+}
+
+SharedBuffer& check_shared_buffer(lua_State* L, int idx) {
+    auto* ud = static_cast<std::shared_ptr<SharedBuffer>*>(
+        luaL_checkudata(L, idx, SHARED_BUFFER_MT));
+    return **ud;
+}
+
+// ── LuaActor ──
+
+LuaActor::LuaActor(int id, std::string name) : id_(id), name_(std::move(name)) {}
+
+LuaActor::~LuaActor() {
+    stop();
+    if (wake_fd_ >= 0) ::close(wake_fd_);
+    delete vm_;
+}
+
+bool LuaActor::start(std::string bytecode, const LuaEngine* parent) {
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) return false;
+
+    vm_ = new LuaEngine();
+    vm_->actor_ = this;
+    if (parent) {
+        std::string prefix = "[" + name_ + "] ";
+        if (auto out = parent->output_cb_)
+            vm_->output_cb_ = [prefix, out](const std::string& s) { out(prefix + s); };
+        if (auto err = parent->error_cb_)
+            vm_->error_cb_ = [prefix, err](const LuaError& e) {
+                err({prefix + e.message, e.line, e.source});
+            };
+    }
+
+    alive_.store(true, std::memory_order_release);
+    try {
+        thread_ = std::thread(&LuaActor::run, this, std::move(bytecode));
+    } catch (const std::system_error& e) {
+        LOG_ERROR("Actor {}: cannot start thread: {}", id_, e.what());
+        alive_.store(false, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void LuaActor::run(std::string bytecode) {
+    if (!vm_->init()) {
+        LOG_ERROR("Actor {} ('{}'): VM failed to initialize", id_, name_);
+        alive_.store(false, std::memory_order_release);
+        return;
+    }
+    LOG_INFO("Actor {} ('{}') started", id_, name_);
+
+    if (!stop_requested()) vm_->execute_bytecode(bytecode, "=" + name_);
+    vm_->leave_serial();
+
+    while (!stop_requested()) {
+        inbox_.drain([this](ActorMessage& m) { inbox_staged_.push_back(std::move(m)); });
+        vm_->deliver_actor_messages();
+        vm_->tick();
+        vm_->leave_serial();
+        if (!vm_->has_actor_work()) break;
+
+        // Dekker handshake with wake(): publish sleeping_, then re-check the ring
+        sleeping_.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (inbox_.empty() && !stop_requested()) {
+            pollfd pfd = {wake_fd_, POLLIN, 0};
+            ::poll(&pfd, 1, vm_->ms_until_next_task());
+            uint64_t drained;
+            if (::read(wake_fd_, &drained, sizeof(drained)) < 0) {}
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    vm_->shutdown();
+    alive_.store(false, std::memory_order_release);
+    LOG_INFO("Actor {} ('{}') exited", id_, name_);
+}
+
+void LuaActor::wake(bool force) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sleeping_.exchange(false, std::memory_order_seq_cst) && !force) return;
+    uint64_t one = 1;
+    if (::write(wake_fd_, &one, sizeof(one)) < 0) {}
+}
+
+void LuaActor::request_stop() {
+    stopping_.store(true, std::memory_order_release);
+    if (vm_) vm_->stop();
+    if (wake_fd_ >= 0) wake(true);
+}
+
+void LuaActor::stop() {
+    request_stop();
+    if (thread_.joinable()) thread_.join();
+}
+
+bool LuaActor::post(ActorMessage& msg) {
+    if (!alive() || !inbox_.try_push(msg)) return false;
+    wake(false);
+    return true;
+}
+
+bool LuaActor::poll(ActorMessage& out) {
+    outbox_.drain([this](ActorMessage& m) { outbox_staged_.push_back(std::move(m)); });
+    if (outbox_staged_.empty()) return false;
+    out = std::move(outbox_staged_.front());
+    outbox_staged_.pop_front();
+    return true;
+}
+
+bool LuaActor::reply(ActorMessage& msg) {
+    return outbox_.try_push(msg);
+}
+
+bool LuaActor::next_inbound(ActorMessage& out) {
+    inbox_.drain([this](ActorMessage& m) { inbox_staged_.push_back(std::move(m)); });
+    if (inbox_staged_.empty()) return false;
+    out = std::move(inbox_staged_.front());
+    inbox_staged_.pop_front();
+    return true;
+}
+
+// ── ActorSystem ──
+
+static Gauge& actors_gauge() {
+    static Gauge& g = Metrics::instance().gauge(
+        "oss_lua_actors", "Actor VMs with a live thread");
+    return g;
+}
+
+ActorSystem& ActorSystem::instance() {
+    static ActorSystem inst;
+    return inst;
+}
+
+std::shared_ptr<LuaActor> ActorSystem::spawn(const std::string& source, const std::string& name,
+                                             const LuaEngine* parent, std::string& error) {
+    std::string bytecode = LuaEngine::compile_source(source, error);
+    if (bytecode.empty()) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    reap_locked();
+    if (actors_.size() >= MAX_ACTORS) {
+        error = "too many actors (limit " + std::to_string(MAX_ACTORS) + ")";
+        return nullptr;
+    }
+
+    int id = next_id_++;
+    std::shared_ptr<LuaActor> actor(
+        new LuaActor(id, name.empty() ? "actor_" + std::to_string(id) : name));
+    if (!actor->start(std::move(bytecode), parent)) {
+        error = "could not start actor thread";
+        return nullptr;
+    }
+    actors_.emplace(id, actor);
+    actors_gauge().set(static_cast<double>(actors_.size()));
+    return actor;
+}
+
+void ActorSystem::reap_locked() {
+    for (auto it = actors_.begin(); it != actors_.end();) {
+        if (it->second->alive()) ++it;
+        else it = actors_.erase(it);
+    }
+}
+
+void ActorSystem::stop_all() {
+    std::unordered_map<int, std::shared_ptr<LuaActor>> actors;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        actors.swap(actors_);
+    }
+    // Signal everyone before joining, so an actor blocked in task.synchronize()
+    // behind another one being stopped isn't waited on first
+    for (auto& [id, actor] : actors) actor->request_stop();
+    for (auto& [id, actor] : actors) actor->stop();
+    if (!actors.empty()) LOG_INFO("Stopped {} actor(s)", actors.size());
+    actors_gauge().set(0);
+}
+
+size_t ActorSystem::count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reap_locked();
+    actors_gauge().set(static_cast<double>(actors_.size()));
+    return actors_.size();
+}
+
+} // namespace oss
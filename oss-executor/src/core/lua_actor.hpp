@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/spsc_queue.hpp"
+
+struct lua_State;
+
+namespace oss {
+
+class LuaEngine;
+
+inline constexpr const char* SHARED_BUFFER_MT = "SharedBuffer";
+
+// Bytes shared by reference between VMs. Access is not synchronized; actors
+// agree through their messages on who writes which range.
+struct SharedBuffer {
+    explicit SharedBuffer(size_t n) : data(n) {}
+    std::vector<uint8_t> data;
+};
+
+// Luau values serialized for another VM. Nil, booleans, numbers, strings,
+// buffers and acyclic tables are copied; SharedBuffers travel by reference.
+struct ActorMessage {
+    std::string bytes;
+    std::vector<std::shared_ptr<SharedBuffer>> shared;
+};
+
+inline constexpr size_t MAX_ACTOR_MESSAGE_BYTES = 16 * 1024 * 1024;
+
+// Encodes stack values [first, first + count). Functions, userdata, threads,
+// cycles and tables nested deeper than 32 fail with `error` set.
+bool encode_actor_message(lua_State* L, int first, int count,
+                          ActorMessage& out, std::string& error);
+// Pushes the message's values; returns how many
+int decode_actor_message(lua_State* L, const ActorMessage& msg);
+
+void push_shared_buffer(lua_State* L, std::shared_ptr<SharedBuffer> buf);
+// Raises a Lua error when the value isn't a SharedBuffer
+SharedBuffer& check_shared_buffer(lua_State* L, int idx);
+
+// One script running in its own LuaEngine on its own thread. The VM that
+// spawned it and the actor talk over two bounded SPSC rings, so neither side
+// takes a lock to send. The actor thread sleeps on an eventfd while it has
+// no messages and no due tasks, and exits once its script has finished with
+// nothing scheduled and no onmessage handler.
+class LuaActor {
+public:
+    ~LuaActor();
+
+    LuaActor(const LuaActor&)            = delete;
+    LuaActor& operator=(const LuaActor&) = delete;
+
+    int  id() const                 { return id_; }
+    const std::string& name() const { return name_; }
+    bool alive() const          { return alive_.load(std::memory_order_acquire); }
+    bool stop_requested() const { return stopping_.load(std::memory_order_acquire); }
+
+    // Spawning VM's side. post() fails when the inbox is full or the actor exited.
+    bool post(ActorMessage& msg);
+    bool poll(ActorMessage& out);
+    // Cancels the running script without waiting for the thread. Safe from
+    // inside another VM; the thread is joined once the actor is reaped.
+    void request_stop();
+    // Cancels the running script and joins the thread. Never call this while
+    // holding a VM lock the actor may need on its way out.
+    void stop();
+
+    // Actor VM's side
+    bool reply(ActorMessage& msg);
+    bool next_inbound(ActorMessage& out);
+
+    static constexpr size_t CHANNEL_CAPACITY = 1024;
+
+private:
+    friend class ActorSystem;
+
+    LuaActor(int id, std::string name);
+    bool start(std::string bytecode, const LuaEngine* parent);
+    void run(std::string bytecode);
+    // Writes the eventfd only when the actor is asleep, unless forced
+    void wake(bool force);
+
+    int         id_;
+    std::string name_;
+    LuaEngine*  vm_ = nullptr;
+    std::thread thread_;
+    int         wake_fd_ = -1;
+
+    std::atomic<bool> alive_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> sleeping_{false};
+
+    SpscQueue<ActorMessage, CHANNEL_CAPACITY> inbox_;
+    SpscQueue<ActorMessage, CHANNEL_CAPACITY> outbox_;
+    std::deque<ActorMessage> inbox_staged_;   // actor thread only
+    std::deque<ActorMessage> outbox_staged_;  // spawning VM only
+};
+
+// Owns every live actor. The main engine stops them all on shutdown.
+class ActorSystem {
+public:
+    static ActorSystem& instance();
+
+    ActorSystem(const ActorSystem&)            = delete;
+    ActorSystem& operator=(const ActorSystem&) = delete;
+
+    // Compiles on the caller so syntax errors reach the spawning script. The
+    // actor inherits the spawning engine's output and error callbacks.
+    std::shared_ptr<LuaActor> spawn(const std::string& source, const std::string& name,
+                                    const LuaEngine* parent, std::string& error);
+    void   stop_all();
+    size_t count();
+
+    // Held by an actor between task.synchronize() and task.desynchronize().
+    // Only actors take it, so it orders actors against each other and never
+    // against the main VM.
+    std::mutex& serial_mutex() { return serial_mutex_; }
+
+    static constexpr size_t MAX_ACTORS = 64;
+
+private:
+    ActorSystem() = default;
+
+    void reap_locked();
+
+    std::mutex mutex_;
+    std::unordered_map<int, std::shared_ptr<LuaActor>> actors_;
+    int next_id_ = 1;
+
+    std::mutex serial_mutex_;
+};
+
+} // namespace oss
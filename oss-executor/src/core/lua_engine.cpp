@@ -1,10 +1,13 @@
 #include "lua_engine.hpp"
+#include "lua_actor.hpp"
 #include "ui/overlay.hpp"
 #include "utils/http.hpp"
 #include "utils/crypto.hpp"
 #include "utils/config.hpp"
 #include "api/environment.hpp"
 #include "utils/logger.hpp"
+#include "utils/metrics.hpp"
+#include "utils/cycle_clock.hpp"
 
 #include "lua.h"
 #include "lualib.h"
@@ -18,7 +21,9 @@
 #include <cstring>
 #include <array>
 #include <algorithm>
+#include <climits>
 #include <cstdlib>
+#include <type_traits>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <sys/stat.h>
@@ -29,6 +34,9 @@ namespace oss {
 
 static thread_local LuaEngine* current_engine = nullptr;
 
+// Luau's lua_setmemcat range; category 0 stays unattributed
+static constexpr int MEMORY_CATEGORIES = 256;
+
 static LuaEngine* get_engine(lua_State* L) {
     lua_getfield(L, LUA_REGISTRYINDEX, "__oss_engine");
     auto* eng = static_cast<LuaEngine*>(lua_touserdata(L, -1));
@@ -53,6 +61,10 @@ static DrawingObject::Type parse_drawing_type(const char* s) {
     if (strcmp(s, "Triangle") == 0)  return DrawingObject::Type::Triangle;
     if (strcmp(s, "Quad") == 0)      return DrawingObject::Type::Quad;
     if (strcmp(s, "Image") == 0)     return DrawingObject::Type::Image;
+    if (strcmp(s, "LineList") == 0)   return DrawingObject::Type::LineList;
+    if (strcmp(s, "Polyline") == 0)   return DrawingObject::Type::Polyline;
+    if (strcmp(s, "PointCloud") == 0) return DrawingObject::Type::PointCloud;
+    if (strcmp(s, "RectList") == 0)   return DrawingObject::Type::RectList;
     return DrawingObject::Type::Line;
 }
 
@@ -108,6 +120,33 @@ static bool read_color(lua_State* L, int idx, double& r, double& g, double& b) {
     return true;
 }
 
+static constexpr size_t MAX_DRAWING_POINTS = 1u << 20;
+
+std::shared_ptr<const std::vector<float>> LuaEngine::read_point_array(lua_State* L, int idx) {
+    auto pts = std::make_shared<std::vector<float>>();
+
+    if (lua_isbuffer(L, idx)) {
+        size_t len = 0;
+        const void* data = lua_tobuffer(L, idx, &len);
+        size_t n = std::min(len / sizeof(float), MAX_DRAWING_POINTS);
+        pts->resize(n);
+        if (n) std::memcpy(pts->data(), data, n * sizeof(float));
+        return pts;
+    }
+
+    if (!lua_istable(L, idx)) return nullptr;
+
+    int abs_idx = (idx > 0) ? idx : lua_gettop(L) + idx + 1;
+    size_t n = std::min(static_cast<size_t>(lua_objlen(L, abs_idx)), MAX_DRAWING_POINTS);
+    pts->resize(n);
+    for (size_t i = 0; i < n; i++) {
+        lua_rawgeti(L, abs_idx, static_cast<int>(i + 1));
+        (*pts)[i] = static_cast<float>(lua_tonumber(L, -1));
+        lua_pop(L, 1);
+    }
+    return pts;
+}
+
 static void push_vec2(lua_State* L, double x, double y) {
     lua_newtable(L);
     lua_pushnumber(L, x); lua_setfield(L, -2, "X");
@@ -121,6 +160,30 @@ static void push_color3(lua_State* L, double r, double g, double b) {
     lua_pushnumber(L, b); lua_setfield(L, -2, "B");
 }
 
+static const char* CRYPT_HASHER_MT = "CryptHasher";
+
+// Strings and buffers both hash without a copy
+static ByteSpan check_bytes(lua_State* L, int idx) {
+    if (lua_isbuffer(L, idx)) {
+        size_t len = 0;
+        const void* data = lua_tobuffer(L, idx, &len);
+        return ByteSpan(data, len);
+    }
+    size_t len = 0;
+    const char* data = luaL_checklstring(L, idx, &len);
+    return ByteSpan(data, len);
+}
+
+static HashAlgorithm check_hash_algorithm(lua_State* L, int idx) {
+    const char* name = luaL_optstring(L, idx, "sha256");
+    try {
+        return Crypto::parse_algorithm(name);
+    } catch (const std::exception&) {
+    }
+    luaL_error(L, "unsupported hash algorithm: %s", name);
+    return HashAlgorithm::SHA256;
+}
+
 static DrawingHandle* check_drawing_handle(lua_State* L, int idx) {
     auto* h = static_cast<DrawingHandle*>(luaL_checkudata(L, idx, DRAWING_OBJ_MT));
     if (h->removed) {
@@ -148,6 +211,130 @@ struct ConnUD {
     bool disconnected;
 };
 
+static const char* ACTOR_HANDLE_MT = "ActorHandle";
+
+static LuaActor& check_actor(lua_State* L, int idx) {
+    return **static_cast<std::shared_ptr<LuaActor>*>(luaL_checkudata(L, idx, ACTOR_HANDLE_MT));
+}
+
+static void push_actor(lua_State* L, std::shared_ptr<LuaActor> actor) {
+    void* mem = lua_newuserdatadtor(L, sizeof(std::shared_ptr<LuaActor>), [](void* p) {
+        static_cast<std::shared_ptr<LuaActor>*>(p)->~shared_ptr();
+    });
+    new (mem) std::shared_ptr<LuaActor>(std::move(actor));
+    luaL_getmetatable(L, ACTOR_HANDLE_MT);
+    lua_setmetatable(L, -2);
+}
+
+static LuaActor& check_inside_actor(lua_State* L, LuaActor* actor, const char* fn) {
+    if (!actor) luaL_error(L, "%s is only available inside an actor", fn);
+    return *actor;
+}
+
+static void send_message(lua_State* L, int first, LuaActor& actor, bool to_actor) {
+    ActorMessage msg;
+    std::string error;
+    if (!encode_actor_message(L, first, lua_gettop(L) - first + 1, msg, error))
+        luaL_error(L, "%s", error.c_str());
+    lua_pushboolean(L, to_actor ? actor.post(msg) : actor.reply(msg));
+}
+
+static int actor_handle_send(lua_State* L) {
+    send_message(L, 2, check_actor(L, 1), true);
+    return 1;
+}
+
+// Non-blocking: false when nothing is queued, else true and the values
+static int actor_handle_receive(lua_State* L) {
+    ActorMessage msg;
+    if (!check_actor(L, 1).poll(msg)) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    lua_pushboolean(L, 1);
+    return 1 + decode_actor_message(L, msg);
+}
+
+// Runs with the engine's mutex_ held, so it only signals the actor; joining
+// here would wait on a thread that may itself be waiting on this VM
+static int actor_handle_kill(lua_State* L) {
+    check_actor(L, 1).request_stop();
+    return 0;
+}
+
+static int actor_handle_isalive(lua_State* L) {
+    lua_pushboolean(L, check_actor(L, 1).alive());
+    return 1;
+}
+
+static int actor_handle_tostring(lua_State* L) {
+    LuaActor& a = check_actor(L, 1);
+    lua_pushfstring(L, "Actor(%d, %s)", a.id(), a.name().c_str());
+    return 1;
+}
+
+static size_t check_shared_offset(lua_State* L, const SharedBuffer& b, size_t width) {
+    double off = luaL_checknumber(L, 2);
+    if (!(off >= 0) || off + static_cast<double>(width) > static_cast<double>(b.data.size()))
+        luaL_error(L, "SharedBuffer access out of bounds");
+    return static_cast<size_t>(off);
+}
+
+template<typename T>
+static int shared_buffer_read(lua_State* L) {
+    SharedBuffer& b = check_shared_buffer(L, 1);
+    size_t off = check_shared_offset(L, b, sizeof(T));
+    T v;
+    std::memcpy(&v, b.data.data() + off, sizeof(T));
+    lua_pushnumber(L, static_cast<double>(v));
+    return 1;
+}
+
+// Integers wrap like the buffer library's writes
+template<typename T>
+static int shared_buffer_write(lua_State* L) {
+    SharedBuffer& b = check_shared_buffer(L, 1);
+    size_t off = check_shared_offset(L, b, sizeof(T));
+    double d = luaL_checknumber(L, 3);
+    T v;
+    if constexpr (std::is_integral_v<T>)
+        v = static_cast<T>(static_cast<int64_t>(d));
+    else
+        v = static_cast<T>(d);
+    std::memcpy(b.data.data() + off, &v, sizeof(T));
+    return 0;
+}
+
+static int shared_buffer_len(lua_State* L) {
+    lua_pushnumber(L, static_cast<double>(check_shared_buffer(L, 1).data.size()));
+    return 1;
+}
+
+static int shared_buffer_readstring(lua_State* L) {
+    SharedBuffer& b = check_shared_buffer(L, 1);
+    size_t n = static_cast<size_t>(luaL_checkinteger(L, 3));
+    size_t off = check_shared_offset(L, b, n);
+    lua_pushlstring(L, reinterpret_cast<const char*>(b.data.data() + off), n);
+    return 1;
+}
+
+static int shared_buffer_writestring(lua_State* L) {
+    SharedBuffer& b = check_shared_buffer(L, 1);
+    size_t n = 0;
+    const char* s = luaL_checklstring(L, 3, &n);
+    size_t off = check_shared_offset(L, b, n);
+    if (n) std::memcpy(b.data.data() + off, s, n);
+    return 0;
+}
+
+// Copies the current contents into a VM-local buffer
+static int shared_buffer_tobuffer(lua_State* L) {
+    SharedBuffer& b = check_shared_buffer(L, 1);
+    void* out = lua_newbuffer(L, b.data.size());
+    if (!b.data.empty()) std::memcpy(out, b.data.data(), b.data.size());
+    return 1;
+}
+
 static int lua_loadstring_impl(lua_State* L) {
     size_t len;
     const char* source = luaL_checklstring(L, 1, &len);
@@ -181,6 +368,8 @@ static int lua_loadstring_impl(lua_State* L) {
 }
 
 LuaEngine& LuaEngine::instance() {
+    // Constructed first so it outlives the engine, whose shutdown stops actors
+    ActorSystem::instance();
     static LuaEngine inst;
     return inst;
 }
@@ -219,13 +408,16 @@ void LuaEngine::lua_interrupt(lua_State* L, int gc) {
     if (gc >= 0) return;
     auto* eng = get_engine(L);
     if (!eng) return;
-    if (!eng->is_running()) {
+    if (!eng->is_running() || (eng->actor_ && eng->actor_->stop_requested())) {
         lua_getfield(L, LUA_REGISTRYINDEX, "_oss_internal_exec");
         bool internal = lua_toboolean(L, -1) != 0;
         lua_pop(L, 1);
         if (internal) return;
         luaL_error(L, "Script execution cancelled");
     }
+    if (eng->kill_pending_.load(std::memory_order_relaxed) &&
+        eng->script_killed(eng->current_script_))
+        luaL_error(L, "Script killed");
 }
 
 LuaEngine::LuaEngine() = default;
@@ -233,6 +425,7 @@ LuaEngine::LuaEngine() = default;
 LuaEngine::~LuaEngine() { shutdown_internal(); }
 
 bool LuaEngine::init() {
+    if (!actor_) ActorSystem::instance().stop_all();
     std::lock_guard<std::mutex> lock(mutex_);
     if (L_) shutdown_internal();
 
@@ -245,9 +438,20 @@ bool LuaEngine::init() {
         std::lock_guard<std::mutex> dlock(drawing_mutex_);
         drawing_objects_.clear();
     }
-    next_drawing_id_ = 1;
     next_signal_id_  = 1;
     total_allocated_ = 0;
+    actor_handler_ref_ = LUA_NOREF;
+    {
+        std::lock_guard<std::mutex> sl(stats_mutex_);
+        scripts_.clear();
+        free_memcats_.clear();
+        for (int cat = MEMORY_CATEGORIES - 1; cat >= 1; --cat)
+            free_memcats_.push_back(cat);
+    }
+    next_script_id_ = 1;
+    current_script_ = 0;
+    child_ticks_    = 0;
+    kill_pending_.store(false, std::memory_order_relaxed);
 
     LOG_DEBUG("LuaEngine: Creating Luau state...");
     L_ = lua_newstate(lua_alloc, this);
@@ -276,6 +480,8 @@ bool LuaEngine::init() {
     register_drawing_lib();
     LOG_DEBUG("LuaEngine: Registering signal library...");
     register_signal_lib();
+    LOG_DEBUG("LuaEngine: Registering actor library...");
+    register_actor_lib();
     LOG_DEBUG("LuaEngine: Setting up environment API...");
     running_.store(true, std::memory_order_release);
 
@@ -289,6 +495,9 @@ bool LuaEngine::init() {
 }
 
 void LuaEngine::shutdown() {
+    // Join actors before taking mutex_; shutdown_internal() only finds the
+    // ones spawned in between
+    if (!actor_) ActorSystem::instance().stop_all();
     std::lock_guard<std::mutex> lock(mutex_);
     shutdown_internal();
 }
@@ -297,6 +506,11 @@ void LuaEngine::shutdown_internal() {
     ready_.store(false, std::memory_order_release);
     running_ = false;
 
+    // Actors belong to the main VM's session
+    if (!actor_) ActorSystem::instance().stop_all();
+    leave_serial();
+    actor_handler_ref_ = LUA_NOREF;
+
     for (auto& task : tasks_) {
         if (L_) {
             if (task.thread_ref != LUA_NOREF)
@@ -308,6 +522,11 @@ void LuaEngine::shutdown_internal() {
         }
     }
     tasks_.clear();
+    {
+        std::lock_guard<std::mutex> sl(stats_mutex_);
+        scripts_.clear();
+        free_memcats_.clear();
+    }
 
     if (L_) {
         for (auto& [name, sig] : signals_) {
@@ -321,18 +540,8 @@ void LuaEngine::shutdown_internal() {
     }
     signals_.clear();
 
-    {
-        std::lock_guard<std::mutex> dlock(drawing_mutex_);
-        for (auto& [id, obj] : drawing_objects_) {
-            if (obj.image_surface) {
-                cairo_surface_destroy(obj.image_surface);
-                obj.image_surface = nullptr;
-            }
-        }
-        drawing_objects_.clear();
-    }
     try {
-        Overlay::instance().clear_objects();
+        clear_all_drawing_objects();
     } catch (...) {}
 
     {
@@ -341,6 +550,8 @@ void LuaEngine::shutdown_internal() {
     }
 
     if (L_) { lua_close(L_); L_ = nullptr; }
+    total_allocated_ = 0;
+    publish_metrics();
 
     LOG_INFO("LuaEngine: Shutdown complete");
 }
@@ -348,6 +559,13 @@ void LuaEngine::shutdown_internal() {
 void LuaEngine::reset() { shutdown(); init(); }
 
 std::string LuaEngine::compile(const std::string& source) {
+    std::string error;
+    std::string bytecode = compile_source(source, error);
+    if (bytecode.empty()) last_error_ = error;
+    return bytecode;
+}
+
+std::string LuaEngine::compile_source(const std::string& source, std::string& error) {
     Luau::CompileOptions options{};
     options.optimizationLevel = 1;
     options.debugLevel        = 1;
@@ -356,13 +574,13 @@ std::string LuaEngine::compile(const std::string& source) {
     std::string bytecode = Luau::compile(source, options);
 
     if (bytecode.empty()) {
-        last_error_ = "Compilation produced empty bytecode";
+        error = "Compilation produced empty bytecode";
         return "";
     }
 
     if (bytecode[0] == 0) {
-        last_error_ = "Compile error: " + bytecode.substr(1);
-        LOG_ERROR("LuaEngine: {}", last_error_);
+        error = "Compile error: " + bytecode.substr(1);
+        LOG_ERROR("LuaEngine: {}", error);
         return "";
     }
 
@@ -397,13 +615,36 @@ bool LuaEngine::execute_internal(const std::string& source,
 
     bool result = execute_bytecode_internal(bytecode, chunk_name);
     current_engine = nullptr;
+    publish_metrics();
     return result;
 }
 
+// Called with mutex_ held, on whichever thread owns the VM at the moment
+void LuaEngine::publish_metrics() {
+    static Gauge& heap = Metrics::instance().gauge(
+        "oss_lua_heap_bytes", "Bytes allocated by Luau VMs (GC heap)");
+    static Gauge& tasks = Metrics::instance().gauge(
+        "oss_lua_pending_tasks", "Scheduled task.spawn/delay/wait continuations");
+
+    double heap_now  = static_cast<double>(total_allocated_);
+    double tasks_now = static_cast<double>(pending_task_count());
+    heap.add(heap_now - published_heap_);
+    tasks.add(tasks_now - published_tasks_);
+    published_heap_  = heap_now;
+    published_tasks_ = tasks_now;
+
+    refresh_script_usage();
+}
+
 bool LuaEngine::execute_bytecode(const std::string& bytecode,
                                   const std::string& chunk_name) {
     std::lock_guard<std::mutex> lock(mutex_);
-    return execute_bytecode_internal(bytecode, chunk_name);
+    running_.store(true, std::memory_order_release);
+    current_engine = this;
+    bool result = execute_bytecode_internal(bytecode, chunk_name);
+    current_engine = nullptr;
+    publish_metrics();
+    return result;
 }
 
 bool LuaEngine::execute_bytecode_internal(const std::string& bytecode,
@@ -418,6 +659,7 @@ bool LuaEngine::execute_bytecode_internal(const std::string& bytecode,
               chunk_name, bytecode.size());
 
     lua_State* thread = lua_newthread(L_);
+    int sid = begin_script(thread, chunk_name);
     luaL_sandboxthread(thread);
 
     int load_result = luau_load(thread, chunk_name.c_str(),
@@ -434,7 +676,7 @@ bool LuaEngine::execute_bytecode_internal(const std::string& bytecode,
 
     auto start_time = std::chrono::steady_clock::now();
 
-    int exec_result = lua_resume(thread, nullptr, 0);
+    int exec_result = resume_script(thread, 0, sid);
 
     auto elapsed = std::chrono::steady_clock::now() - start_time;
     double ms = std::chrono::duration<double, std::milli>(elapsed).count();
@@ -465,6 +707,7 @@ bool LuaEngine::execute_bytecode_internal(const std::string& bytecode,
                     std::chrono::duration<double>(wait_seconds));
             task.thread_ref = thread_ref;
             task.func_ref   = LUA_NOREF;
+            task.script_id  = sid;
             schedule_task(std::move(task));
         } else {
             lua_pushthread(thread);
@@ -478,6 +721,7 @@ bool LuaEngine::execute_bytecode_internal(const std::string& bytecode,
             task.resume_at = std::chrono::steady_clock::now();
             task.thread_ref = thread_ref;
             task.func_ref   = LUA_NOREF;
+            task.script_id  = sid;
             schedule_task(std::move(task));
         }
 
@@ -688,10 +932,12 @@ void LuaEngine::tick() {
 
     process_tasks();
     current_engine = nullptr;
+    publish_metrics();
 }
 
 void LuaEngine::process_tasks() {
     auto now = std::chrono::steady_clock::now();
+    cancel_killed_scripts();
 
     auto cancelled_end = std::stable_partition(
         tasks_.begin(), tasks_.end(),
@@ -751,6 +997,7 @@ void LuaEngine::execute_task(ScheduledTask& task,
 
     if (!co && task.func_ref != LUA_NOREF) {
         co = lua_newthread(L_);
+        tag_thread(co, task.script_id);
         luaL_sandboxthread(co);
         int thread_ref = lua_ref(L_, -1);
         lua_pop(L_, 1);
@@ -796,7 +1043,7 @@ void LuaEngine::execute_task(ScheduledTask& task,
     }
     task.arg_refs.clear();
 
-    int status = lua_resume(co, nullptr, nargs);
+    int status = resume_script(co, nargs, task.script_id);
 
     if (status == LUA_YIELD) {
         if (lua_gettop(co) > 0 && lua_isnumber(co, -1)) {
@@ -805,6 +1052,7 @@ void LuaEngine::execute_task(ScheduledTask& task,
 
             ScheduledTask new_task;
             new_task.id            = next_task_id_++;
+            new_task.script_id     = task.script_id;
             new_task.type          = ScheduledTask::Type::Delay;
             new_task.delay_seconds = wait_seconds;
             new_task.resume_at     = now +
@@ -817,6 +1065,7 @@ void LuaEngine::execute_task(ScheduledTask& task,
         } else {
             ScheduledTask new_task;
             new_task.id         = next_task_id_++;
+            new_task.script_id  = task.script_id;
             new_task.type       = ScheduledTask::Type::Defer;
             new_task.resume_at  = now;
             new_task.thread_ref = task.thread_ref;
@@ -836,6 +1085,7 @@ void LuaEngine::execute_task(ScheduledTask& task,
 
 int LuaEngine::schedule_task(ScheduledTask task) {
     task.id = next_task_id_++;
+    if (!task.script_id) task.script_id = current_script_;
     int id  = task.id;
     tasks_.push_back(std::move(task));
     return id;
@@ -853,14 +1103,235 @@ size_t LuaEngine::pending_task_count() const {
     return c;
 }
 
+// ── Per-script accounting ──
+
+// Gives a new execution an id and, while any are free, its own memory
+// category so its allocations can be told apart from other scripts'
+int LuaEngine::begin_script(lua_State* thread, const std::string& chunk_name) {
+    int sid = next_script_id_++;
+    std::lock_guard<std::mutex> sl(stats_mutex_);
+    auto& s = scripts_.try_emplace(sid).first->second;
+    s.name = chunk_name;
+    if (!s.name.empty() && (s.name[0] == '=' || s.name[0] == '@'))
+        s.name.erase(0, 1);
+    if (!free_memcats_.empty()) {
+        s.memcat = free_memcats_.back();
+        free_memcats_.pop_back();
+        // A recycled category may still hold objects its last owner left behind
+        s.mem_baseline = lua_totalbytes(L_, s.memcat);
+        lua_setmemcat(thread, s.memcat);
+    }
+    return sid;
+}
+
+void LuaEngine::tag_thread(lua_State* co, int script_id) {
+    if (auto* s = find_script(script_id); s && s->memcat)
+        lua_setmemcat(co, s->memcat);
+}
+
+LuaEngine::ScriptStats* LuaEngine::find_script(int script_id) {
+    if (!script_id) return nullptr;
+    auto it = scripts_.find(script_id);
+    return it != scripts_.end() ? &it->second : nullptr;
+}
+
+bool LuaEngine::script_killed(int script_id) {
+    auto* s = find_script(script_id);
+    return s && s->killed.load(std::memory_order_relaxed);
+}
+
+int LuaEngine::resume_script(lua_State* co, int nargs, int script_id) {
+    int      outer_script = current_script_;
+    uint64_t outer_child  = child_ticks_;
+    current_script_ = script_id;
+    child_ticks_    = 0;
+
+    uint64_t start  = CycleClock::now();
+    int      status = lua_resume(co, nullptr, nargs);
+    uint64_t dt     = CycleClock::now() - start;
+
+    if (auto* s = find_script(script_id)) {
+        s->ticks.fetch_add(dt - std::min(dt, child_ticks_), std::memory_order_relaxed);
+        s->resumes.fetch_add(1, std::memory_order_relaxed);
+        if (status == LUA_YIELD) s->yields.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    current_script_ = outer_script;
+    child_ticks_    = outer_child + dt;
+    return status;
+}
+
+void LuaEngine::cancel_killed_scripts() {
+    if (!kill_pending_.load(std::memory_order_acquire)) return;
+    for (auto& t : tasks_)
+        if (!t.cancelled && script_killed(t.script_id)) t.cancelled = true;
+}
+
+// Called with mutex_ held. A script with nothing left running or scheduled
+// is marked finished and its memory category goes back to the pool, freezing
+// its memory figure; the entry stays listed until remove_script().
+void LuaEngine::refresh_script_usage() {
+    cancel_killed_scripts();
+
+    std::unordered_map<int, std::pair<size_t, size_t>> live;  // id -> tasks, timers
+    for (const auto& t : tasks_) {
+        if (t.cancelled || !t.script_id) continue;
+        auto& c = live[t.script_id];
+        ++c.first;
+        if (t.type == ScheduledTask::Type::Delay) ++c.second;
+    }
+
+    std::lock_guard<std::mutex> sl(stats_mutex_);
+    bool any_killed = false;
+    std::vector<int> finished;
+    for (auto it = scripts_.begin(); it != scripts_.end();) {
+        auto& s  = it->second;
+        auto  lt = live.find(it->first);
+        bool idle = lt == live.end() && it->first != current_script_;
+        if (idle && s.removed.load(std::memory_order_relaxed)) {
+            if (s.memcat) free_memcats_.push_back(s.memcat);
+            it = scripts_.erase(it);
+            continue;
+        }
+        s.pending_timers = lt != live.end() ? lt->second.second : 0;
+        if (s.memcat && L_) {
+            size_t total = lua_totalbytes(L_, s.memcat);
+            s.memory = total > s.mem_baseline ? total - s.mem_baseline : 0;
+        }
+        s.finished = idle;
+        if (idle) {
+            if (s.memcat) free_memcats_.push_back(s.memcat);
+            s.memcat = 0;
+            finished.push_back(it->first);
+        }
+        any_killed = any_killed || (!idle && s.killed.load(std::memory_order_relaxed));
+        ++it;
+    }
+    if (finished.size() > MAX_FINISHED_SCRIPTS) {
+        std::sort(finished.begin(), finished.end());
+        for (size_t i = 0; i < finished.size() - MAX_FINISHED_SCRIPTS; i++)
+            scripts_.erase(finished[i]);
+    }
+    if (!any_killed) kill_pending_.store(false, std::memory_order_release);
+}
+
+std::vector<ScriptUsage> LuaEngine::script_usage() {
+    // An idle VM gets fresh memory and timer figures; a busy one reports the
+    // last published ones
+    {
+        std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+        if (lock.owns_lock()) refresh_script_usage();
+    }
+
+    std::lock_guard<std::mutex> sl(stats_mutex_);
+    std::vector<ScriptUsage> out;
+    out.reserve(scripts_.size());
+    for (const auto& [id, s] : scripts_) {
+        if (s.removed.load(std::memory_order_relaxed)) continue;
+        ScriptUsage u;
+        u.id             = id;
+        u.name           = s.name;
+        u.cpu_ms         = CycleClock::to_ns(s.ticks.load(std::memory_order_relaxed)) / 1e6;
+        u.memory         = s.memory;
+        u.resumes        = s.resumes.load(std::memory_order_relaxed);
+        u.yields         = s.yields.load(std::memory_order_relaxed);
+        u.pending_timers = s.pending_timers;
+        u.killed         = s.killed.load(std::memory_order_relaxed);
+        u.finished       = s.finished;
+        out.push_back(std::move(u));
+    }
+    std::sort(out.begin(), out.end(),
+              [](const ScriptUsage& a, const ScriptUsage& b) { return a.id < b.id; });
+    return out;
+}
+
+// The interrupt raises in the script's running thread on its next check;
+// its scheduled tasks are cancelled now if the VM is idle, else on the
+// next tick or publish
+void LuaEngine::kill_script(int script_id) {
+    {
+        std::lock_guard<std::mutex> sl(stats_mutex_);
+        auto it = scripts_.find(script_id);
+        if (it == scripts_.end()) return;
+        it->second.killed.store(true, std::memory_order_relaxed);
+        kill_pending_.store(true, std::memory_order_release);
+    }
+    LOG_INFO("LuaEngine: Killing script {}", script_id);
+
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock()) publish_metrics();
+}
+
+// Hidden at once; the entry itself goes on the next refresh, which holds
+// the VM lock this may not get
+void LuaEngine::remove_script(int script_id) {
+    {
+        std::lock_guard<std::mutex> sl(stats_mutex_);
+        auto it = scripts_.find(script_id);
+        if (it == scripts_.end() || !it->second.finished) return;
+        it->second.removed.store(true, std::memory_order_relaxed);
+    }
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock()) refresh_script_usage();
+}
+
+// Each message becomes a task running the onmessage handler with its values
+void LuaEngine::deliver_actor_messages() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!L_ || !actor_ || actor_handler_ref_ == LUA_NOREF) return;
+
+    auto now = std::chrono::steady_clock::now();
+    ActorMessage msg;
+    while (actor_->next_inbound(msg)) {
+        ScheduledTask task;
+        task.type      = ScheduledTask::Type::Spawn;
+        task.resume_at = now;
+
+        lua_rawgeti(L_, LUA_REGISTRYINDEX, actor_handler_ref_);
+        task.func_ref = lua_ref(L_, -1);
+        lua_pop(L_, 1);
+
+        int n = decode_actor_message(L_, msg);
+        for (int i = n; i > 0; --i)
+            task.arg_refs.push_back(lua_ref(L_, -i));
+        lua_pop(L_, n);
+        schedule_task(std::move(task));
+    }
+}
+
+void LuaEngine::leave_serial() {
+    if (!serial_held_) return;
+    serial_held_ = false;
+    ActorSystem::instance().serial_mutex().unlock();
+}
+
+bool LuaEngine::has_actor_work() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return actor_handler_ref_ != LUA_NOREF || pending_task_count() > 0;
+}
+
+// -1 when nothing is scheduled
+int LuaEngine::ms_until_next_task() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now  = std::chrono::steady_clock::now();
+    long long best = -1;
+    for (const auto& t : tasks_) {
+        if (t.cancelled) continue;
+        long long ms = std::max<long long>(0,
+            std::chrono::ceil<std::chrono::milliseconds>(t.resume_at - now).count());
+        if (best < 0 || ms < best) best = ms;
+    }
+    return static_cast<int>(std::min<long long>(best, INT_MAX));
+}
+
 int LuaEngine::create_drawing_object(DrawingObject::Type type) {
     std::lock_guard<std::mutex> dlock(drawing_mutex_);
-    int id = next_drawing_id_++;
+    // The overlay hands out ids so objects from every VM share one space
+    int id = Overlay::instance().create_object(type);
     DrawingObject obj;
     obj.type = type;
     obj.id   = id;
     drawing_objects_[id] = obj;
-    Overlay::instance().create_object_with_id(id, type);
     return id;
 }
 
@@ -903,6 +1374,7 @@ bool LuaEngine::remove_drawing_object(int id) {
     return true;
 }
 
+// An actor only owns the objects it created; the main VM owns the overlay
 void LuaEngine::clear_all_drawing_objects() {
     std::lock_guard<std::mutex> dlock(drawing_mutex_);
     for (auto& [id, obj] : drawing_objects_) {
@@ -910,9 +1382,10 @@ void LuaEngine::clear_all_drawing_objects() {
             cairo_surface_destroy(obj.image_surface);
             obj.image_surface = nullptr;
         }
+        if (actor_) Overlay::instance().remove_object(id);
     }
     drawing_objects_.clear();
-    Overlay::instance().clear_objects();
+    if (!actor_) Overlay::instance().clear_objects();
 }
 
 void LuaEngine::register_function(const std::string& name,
@@ -1023,6 +1496,8 @@ void LuaEngine::register_task_lib() {
         {"defer",  lua_task_defer},
         {"wait",   lua_task_wait},
         {"cancel", lua_task_cancel},
+        {"synchronize",   lua_task_synchronize},
+        {"desynchronize", lua_task_desynchronize},
         {nullptr, nullptr}
     };
     register_library("task", funcs);
@@ -1090,6 +1565,70 @@ void LuaEngine::register_signal_lib() {
     register_function("Signal", lua_signal_new);
 }
 
+void LuaEngine::register_actor_lib() {
+    luaL_newmetatable(L_, ACTOR_HANDLE_MT);
+    lua_pushstring(L_, "__index");
+    lua_newtable(L_);
+    lua_pushcfunction(L_, actor_handle_send, "Actor.send");
+    lua_setfield(L_, -2, "send");
+    lua_pushcfunction(L_, actor_handle_receive, "Actor.receive");
+    lua_setfield(L_, -2, "receive");
+    lua_pushcfunction(L_, actor_handle_kill, "Actor.kill");
+    lua_setfield(L_, -2, "kill");
+    lua_pushcfunction(L_, actor_handle_isalive, "Actor.isalive");
+    lua_setfield(L_, -2, "isalive");
+    lua_settable(L_, -3);
+    lua_pushcfunction(L_, actor_handle_tostring, "Actor.__tostring");
+    lua_setfield(L_, -2, "__tostring");
+    lua_pop(L_, 1);
+
+    static const luaL_Reg shared_methods[] = {
+        {"len",         shared_buffer_len},
+        {"readu8",      shared_buffer_read<uint8_t>},
+        {"writeu8",     shared_buffer_write<uint8_t>},
+        {"readi32",     shared_buffer_read<int32_t>},
+        {"writei32",    shared_buffer_write<int32_t>},
+        {"readu32",     shared_buffer_read<uint32_t>},
+        {"writeu32",    shared_buffer_write<uint32_t>},
+        {"readf32",     shared_buffer_read<float>},
+        {"writef32",    shared_buffer_write<float>},
+        {"readf64",     shared_buffer_read<double>},
+        {"writef64",    shared_buffer_write<double>},
+        {"readstring",  shared_buffer_readstring},
+        {"writestring", shared_buffer_writestring},
+        {"tobuffer",    shared_buffer_tobuffer},
+        {nullptr, nullptr}
+    };
+    luaL_newmetatable(L_, SHARED_BUFFER_MT);
+    lua_pushstring(L_, "__index");
+    lua_newtable(L_);
+    for (const luaL_Reg* f = shared_methods; f->name; ++f) {
+        lua_pushcfunction(L_, f->func, f->name);
+        lua_setfield(L_, -2, f->name);
+    }
+    lua_settable(L_, -3);
+    lua_pop(L_, 1);
+
+    static const luaL_Reg funcs[] = {
+        {"spawn",        lua_actor_spawn},
+        {"send",         lua_actor_send},
+        {"receive",      lua_actor_receive},
+        {"onmessage",    lua_actor_onmessage},
+        {"sharedbuffer", lua_actor_sharedbuffer},
+        {nullptr, nullptr}
+    };
+    register_library("actor", funcs);
+
+    if (actor_) {
+        lua_getglobal(L_, "actor");
+        lua_pushinteger(L_, actor_->id());
+        lua_setfield(L_, -2, "id");
+        lua_pushstring(L_, actor_->name().c_str());
+        lua_setfield(L_, -2, "name");
+        lua_pop(L_, 1);
+    }
+}
+
 void LuaEngine::register_custom_libs() {
     register_function("readfile",   lua_readfile);
     register_function("writefile",  lua_writefile);
@@ -1122,10 +1661,24 @@ void LuaEngine::register_custom_libs() {
     };
     register_library("rconsole", console_lib);
 
+    luaL_newmetatable(L_, CRYPT_HASHER_MT);
+    lua_pushstring(L_, "__index");
+    lua_newtable(L_);
+    lua_pushcfunction(L_, lua_hasher_update, "Hasher.update");
+    lua_setfield(L_, -2, "update");
+    lua_pushcfunction(L_, lua_hasher_digest, "Hasher.digest");
+    lua_setfield(L_, -2, "digest");
+    lua_settable(L_, -3);
+    lua_pop(L_, 1);
+
     static const luaL_Reg crypt_lib[] = {
         {"base64encode", lua_base64_encode},
         {"base64decode", lua_base64_decode},
         {"sha256",       lua_sha256},
+        {"hash",         lua_crypt_hash},
+        {"hmac",         lua_crypt_hmac},
+        {"hasher",       lua_crypt_hasher},
+        {"hashfile",     lua_crypt_hashfile},
         {nullptr, nullptr}
     };
     register_library("crypt", crypt_lib);
@@ -1220,6 +1773,17 @@ int LuaEngine::lua_drawing_index(lua_State* L) {
     else if (strcmp(key, "Text") == 0)         lua_pushstring(L, copy.text.c_str());
     else if (strcmp(key, "Font") == 0)         lua_pushinteger(L, copy.font);
     else if (strcmp(key, "Rounding") == 0)     lua_pushnumber(L, copy.rounding);
+    else if (strcmp(key, "Closed") == 0)       lua_pushboolean(L, copy.closed);
+    else if (strcmp(key, "PointCount") == 0)
+        lua_pushinteger(L, copy.points ? static_cast<int>(copy.points->size()) : 0);
+    else if (strcmp(key, "Points") == 0) {
+        size_t n = copy.points ? copy.points->size() : 0;
+        lua_createtable(L, static_cast<int>(n), 0);
+        for (size_t i = 0; i < n; i++) {
+            lua_pushnumber(L, (*copy.points)[i]);
+            lua_rawseti(L, -2, static_cast<int>(i + 1));
+        }
+    }
     else if (strcmp(key, "TextSize") == 0)     lua_pushnumber(L, copy.text_size);
     else if (strcmp(key, "ImageWidth") == 0)   lua_pushnumber(L, copy.image_w);
     else if (strcmp(key, "ImageHeight") == 0)  lua_pushnumber(L, copy.image_h);
@@ -1324,6 +1888,15 @@ int LuaEngine::lua_drawing_newindex(lua_State* L) {
         double v = std::max(0.0, luaL_checknumber(L, 3));
         eng->update_drawing_object(h->id, [v](DrawingObject& o){ o.rounding = v; });
     }
+    else if (strcmp(key, "Closed") == 0) {
+        bool v = lua_toboolean(L, 3) != 0;
+        eng->update_drawing_object(h->id, [v](DrawingObject& o){ o.closed = v; });
+    }
+    else if (strcmp(key, "Points") == 0) {
+        auto pts = read_point_array(L, 3);
+        if (!pts) { luaL_error(L, "Points: expected table or buffer"); return 0; }
+        eng->update_drawing_object(h->id, [pts](DrawingObject& o){ o.points = pts; });
+    }
     else if (strcmp(key, "Position") == 0) {
         double x = 0, y = 0;
         read_vec2(L, 3, x, y);
@@ -1481,6 +2054,7 @@ int LuaEngine::lua_task_spawn(lua_State* L) {
     if (!eng) { luaL_error(L, "engine not available"); return 0; }
 
     lua_State* co = lua_newthread(eng->L_);
+    eng->tag_thread(co, eng->current_script_);
     luaL_sandboxthread(co);
     int thread_ref = lua_ref(eng->L_, -1);
     lua_pop(eng->L_, 1);
@@ -1493,7 +2067,7 @@ int LuaEngine::lua_task_spawn(lua_State* L) {
         lua_xmove(L, co, 1);
     }
 
-    int status = lua_resume(co, nullptr, nargs);
+    int status = eng->resume_script(co, nargs, eng->current_script_);
 
     if (status == LUA_YIELD) {
         if (lua_gettop(co) > 0 && lua_isnumber(co, -1)) {
@@ -1617,6 +2191,88 @@ int LuaEngine::lua_task_cancel(lua_State* L) {
     return 0;
 }
 
+// Actors run in parallel by default. A serial section, from synchronize() to
+// desynchronize() or the next return to the actor's scheduler, excludes every
+// other actor's serial section. It does not exclude the main VM, which never
+// takes the lock, so state shared with the main VM has to travel by message.
+// Both calls are no-ops on the main VM.
+int LuaEngine::lua_task_synchronize(lua_State* L) {
+    auto* eng = get_engine(L);
+    if (eng && eng->actor_ && !eng->serial_held_) {
+        ActorSystem::instance().serial_mutex().lock();
+        eng->serial_held_ = true;
+    }
+    return 0;
+}
+
+int LuaEngine::lua_task_desynchronize(lua_State* L) {
+    auto* eng = get_engine(L);
+    if (eng && eng->actor_) eng->leave_serial();
+    return 0;
+}
+
+int LuaEngine::lua_actor_spawn(lua_State* L) {
+    size_t len = 0;
+    const char* source = luaL_checklstring(L, 1, &len);
+    const char* name   = luaL_optstring(L, 2, "");
+    auto* eng = get_engine(L);
+
+    std::string error;
+    auto actor = ActorSystem::instance().spawn(std::string(source, len), name, eng, error);
+    if (!actor) {
+        lua_pushnil(L);
+        lua_pushstring(L, error.c_str());
+        return 2;
+    }
+    push_actor(L, std::move(actor));
+    return 1;
+}
+
+int LuaEngine::lua_actor_send(lua_State* L) {
+    auto* eng = get_engine(L);
+    send_message(L, 1, check_inside_actor(L, eng ? eng->actor_ : nullptr, "actor.send"), false);
+    return 1;
+}
+
+int LuaEngine::lua_actor_receive(lua_State* L) {
+    auto* eng = get_engine(L);
+    LuaActor& self = check_inside_actor(L, eng ? eng->actor_ : nullptr, "actor.receive");
+    ActorMessage msg;
+    if (!self.next_inbound(msg)) {
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+    lua_pushboolean(L, 1);
+    return 1 + decode_actor_message(L, msg);
+}
+
+// The handler runs as a task per message; nil unbinds it. With no handler
+// and nothing scheduled, the actor exits.
+int LuaEngine::lua_actor_onmessage(lua_State* L) {
+    auto* eng = get_engine(L);
+    check_inside_actor(L, eng ? eng->actor_ : nullptr, "actor.onmessage");
+    if (!lua_isnil(L, 1)) luaL_checktype(L, 1, LUA_TFUNCTION);
+
+    if (eng->actor_handler_ref_ != LUA_NOREF) {
+        lua_unref(L, eng->actor_handler_ref_);
+        eng->actor_handler_ref_ = LUA_NOREF;
+    }
+    if (lua_isfunction(L, 1)) {
+        lua_pushvalue(L, 1);
+        eng->actor_handler_ref_ = lua_ref(L, -1);
+        lua_pop(L, 1);
+    }
+    return 0;
+}
+
+int LuaEngine::lua_actor_sharedbuffer(lua_State* L) {
+    double size = luaL_checknumber(L, 1);
+    if (!(size >= 0) || size > static_cast<double>(MAX_MEMORY))
+        luaL_error(L, "sharedbuffer size out of range");
+    push_shared_buffer(L, std::make_shared<SharedBuffer>(static_cast<size_t>(size)));
+    return 1;
+}
+
 int LuaEngine::lua_signal_new(lua_State* L) {
     const char* name = luaL_optstring(L, 1, "");
     auto* eng = get_engine(L);
@@ -1890,6 +2546,7 @@ int LuaEngine::lua_spawn(lua_State* L) {
     if (!eng) { luaL_error(L, "engine not available"); return 0; }
 
     lua_State* co = lua_newthread(eng->L_);
+    eng->tag_thread(co, eng->current_script_);
     luaL_sandboxthread(co);
     int thread_ref = lua_ref(eng->L_, -1);
     lua_pop(eng->L_, 1);
@@ -1902,7 +2559,7 @@ int LuaEngine::lua_spawn(lua_State* L) {
         lua_xmove(L, co, 1);
     }
 
-    int status = lua_resume(co, nullptr, nargs);
+    int status = eng->resume_script(co, nargs, eng->current_script_);
 
     if (status == LUA_YIELD) {
         if (lua_gettop(co) > 0 && lua_isnumber(co, -1)) {
@@ -2114,76 +2771,126 @@ int LuaEngine::lua_rconsole_clear(lua_State* L) {
     return 0;
 }
 
+// crypt.base64encode(data) -> string; encodes straight into the result string
 int LuaEngine::lua_base64_encode(lua_State* L) {
-    size_t len;
-    const char* data = luaL_checklstring(L, 1, &len);
-    std::vector<uint8_t> input(data, data + len);
-    lua_pushstring(L, Crypto::base64_encode(input).c_str());
+    ByteSpan in = check_bytes(L, 1);
+    size_t len = Base64::encoded_size(in.size);
+    luaL_Strbuf b;
+    char* out = luaL_buffinitsize(L, &b, len);
+    Base64::encode(in, out);
+    luaL_pushresultsize(&b, len);
     return 1;
 }
 
+// crypt.base64decode(data, strict = false, as_buffer = false) -> string or buffer.
+// Lenient decoding skips whitespace and stray padding; strict rejects both.
 int LuaEngine::lua_base64_decode(lua_State* L) {
-    size_t encoded_len;
-    const char* encoded = luaL_checklstring(L, 1, &encoded_len);
-
-    static const auto table = []() {
-        std::array<unsigned char, 256> t{};
-        t.fill(0xFF);
-        const char* chars =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-        for (size_t i = 0; i < 64; ++i)
-            t[static_cast<unsigned char>(chars[i])] =
-                static_cast<unsigned char>(i);
-        t[static_cast<unsigned char>('=')] = 0;
-        return t;
-    }();
+    ByteSpan in = check_bytes(L, 1);
+    // Skipping junk is the long-standing default; strict rejection is opt-in
+    auto mode = lua_toboolean(L, 2) ? Base64::Mode::Strict : Base64::Mode::SkipInvalid;
+    bool as_buffer = lua_toboolean(L, 3);
+    std::string_view text(reinterpret_cast<const char*>(in.data), in.size);
+    size_t cap = Base64::decoded_size(text);
+
+    size_t len = Base64::npos;
+    if (as_buffer) {
+        auto* out = static_cast<uint8_t*>(lua_newbuffer(L, cap));
+        len = Base64::decode(text, out, mode);
+        if (len != Base64::npos && len != cap)
+            std::memcpy(lua_newbuffer(L, len), out, len);
+    } else {
+        luaL_Strbuf b;
+        char* out = luaL_buffinitsize(L, &b, cap);
+        len = Base64::decode(text, reinterpret_cast<uint8_t*>(out), mode);
+        if (len != Base64::npos) luaL_pushresultsize(&b, len);
+    }
+    if (len == Base64::npos) {
+        luaL_error(L, "invalid base64 input");
+        return 0;
+    }
+    return 1;
+}
 
-    std::string output;
-    output.reserve(encoded_len * 3 / 4);
-
-    size_t i = 0;
-    while (i < encoded_len) {
-        while (i < encoded_len &&
-               (encoded[i] == '\n' || encoded[i] == '\r' ||
-                encoded[i] == ' '  || encoded[i] == '\t'))
-            ++i;
-        if (i >= encoded_len) break;
-
-        uint32_t n = 0;
-        int pad = 0;
-        int chars_read = 0;
-
-        for (int j = 0; j < 4 && i < encoded_len; ++j) {
-            unsigned char c = static_cast<unsigned char>(encoded[i]);
-            if (c == '=') {
-                ++pad;
-                n <<= 6;
-            } else if (table[c] != 0xFF) {
-                n = (n << 6) | table[c];
-            } else {
-                --j;
-                ++i;
-                continue;
-            }
-            ++i;
-            ++chars_read;
-        }
+int LuaEngine::lua_sha256(lua_State* L) {
+    lua_pushstring(L, Crypto::sha256(check_bytes(L, 1)).c_str());
+    return 1;
+}
 
-        if (chars_read < 2) break;
+// crypt.hash(data, algo = "sha256") -> hex
+int LuaEngine::lua_crypt_hash(lua_State* L) {
+    ByteSpan data = check_bytes(L, 1);
+    auto algo = check_hash_algorithm(L, 2);
+    lua_pushstring(L, Crypto::hash(data, algo).c_str());
+    return 1;
+}
 
-        output += static_cast<char>((n >> 16) & 0xFF);
-        if (pad < 2) output += static_cast<char>((n >> 8) & 0xFF);
-        if (pad < 1) output += static_cast<char>(n & 0xFF);
-    }
+// crypt.hmac(data, key, algo = "sha256") -> hex
+int LuaEngine::lua_crypt_hmac(lua_State* L) {
+    ByteSpan data = check_bytes(L, 1);
+    ByteSpan key  = check_bytes(L, 2);
+    auto algo = check_hash_algorithm(L, 3);
+    lua_pushstring(L, Crypto::hmac(data, key, algo).c_str());
+    return 1;
+}
 
-    lua_pushlstring(L, output.c_str(), output.size());
+// crypt.hasher(algo = "sha256", hmac_key?) -> streaming hasher
+int LuaEngine::lua_crypt_hasher(lua_State* L) {
+    auto algo = check_hash_algorithm(L, 1);
+    bool keyed = !lua_isnoneornil(L, 2);
+    ByteSpan key = keyed ? check_bytes(L, 2) : ByteSpan();
+
+    // Built before the userdata, so a constructor that throws leaves no
+    // destructor behind to run on uninitialized memory
+    Hasher hasher = keyed ? Hasher(algo, key) : Hasher(algo);
+    void* mem = lua_newuserdatadtor(L, sizeof(Hasher), [](void* p) {
+        static_cast<Hasher*>(p)->~Hasher();
+    });
+    new (mem) Hasher(std::move(hasher));
+    luaL_getmetatable(L, CRYPT_HASHER_MT);
+    lua_setmetatable(L, -2);
     return 1;
 }
 
-int LuaEngine::lua_sha256(lua_State* L) {
-    size_t len;
-    const char* input = luaL_checklstring(L, 1, &len);
-    lua_pushstring(L, Crypto::sha256(std::string(input, len)).c_str());
+// hasher:update(data) -> hasher, so calls chain
+int LuaEngine::lua_hasher_update(lua_State* L) {
+    auto* h = static_cast<Hasher*>(luaL_checkudata(L, 1, CRYPT_HASHER_MT));
+    h->update(check_bytes(L, 2));
+    lua_settop(L, 1);
+    return 1;
+}
+
+// hasher:digest(raw = false) -> hex or raw bytes; the hasher starts over
+int LuaEngine::lua_hasher_digest(lua_State* L) {
+    auto* h = static_cast<Hasher*>(luaL_checkudata(L, 1, CRYPT_HASHER_MT));
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    size_t len = h->final(digest);
+    if (lua_toboolean(L, 2))
+        lua_pushlstring(L, reinterpret_cast<const char*>(digest), len);
+    else
+        lua_pushstring(L, Crypto::bytes_to_hex(digest, len).c_str());
+    return 1;
+}
+
+// crypt.hashfile(path, algo = "sha256") -> hex, streamed from the workspace
+int LuaEngine::lua_crypt_hashfile(lua_State* L) {
+    const char* path = luaL_checkstring(L, 1);
+    auto algo = check_hash_algorithm(L, 2);
+    std::string base = Config::instance().home_dir() + "/workspace/";
+    std::string full = base + path;
+    if (!is_sandboxed(full, base)) {
+        luaL_error(L, "Access denied: path traversal detected");
+        return 0;
+    }
+    std::string digest;
+    try {
+        digest = Crypto::hash_file(full, algo);
+    } catch (const std::exception&) {
+    }
+    if (digest.empty()) {
+        luaL_error(L, "Cannot read file: %s", path);
+        return 0;
+    }
+    lua_pushstring(L, digest.c_str());
     return 1;
 }
 
@@ -9,6 +9,7 @@
 #include <optional>
 #include <atomic>
 #include <chrono>
+#include <memory>
 
 #include "lua.h"
 #include "lualib.h"
@@ -18,6 +19,8 @@
 
 namespace oss {
 
+class LuaActor;
+
 struct LuaError {
     std::string message;
     int         line = -1;
@@ -34,6 +37,20 @@ struct ScheduledTask {
     std::vector<int> arg_refs;
     bool   cancelled     = false;
     int    id            = 0;
+    int    script_id     = 0;  // execution the task belongs to; 0 = unattributed
+};
+
+// Snapshot of one running script for the task manager
+struct ScriptUsage {
+    int         id = 0;
+    std::string name;
+    double      cpu_ms         = 0.0;  // self time inside lua_resume
+    size_t      memory         = 0;    // live bytes allocated under its memory category
+    uint64_t    resumes        = 0;
+    uint64_t    yields         = 0;
+    size_t      pending_timers = 0;
+    bool        killed         = false;
+    bool        finished       = false;  // nothing running or scheduled; memory frozen
 };
 
 struct Signal {
@@ -74,6 +91,8 @@ public:
     bool is_payload_connected() const;
 
     std::string compile(const std::string& source);
+    // Same options as compile(); thread-safe, reports errors via `error`.
+    static std::string compile_source(const std::string& source, std::string& error);
 
     void queue_script(const std::string& source,
                       const std::string& name = "");
@@ -112,6 +131,16 @@ public:
     void   cancel_task(int task_id);
     size_t pending_task_count() const;
 
+    // Every script run on this VM, running or finished, until remove_script()
+    // drops it. All three are safe to call from any thread; kill_script stops
+    // only that script's threads, remove_script ignores one still running.
+    std::vector<ScriptUsage> script_usage();
+    void kill_script(int script_id);
+    void remove_script(int script_id);
+
+    // Finished scripts kept beyond this are dropped oldest first
+    static constexpr size_t MAX_FINISHED_SCRIPTS = 64;
+
     int  create_drawing_object(DrawingObject::Type type);
     bool get_drawing_object(int id, DrawingObject& out);
     bool update_drawing_object(int id,
@@ -123,7 +152,12 @@ public:
         return drawing_objects_.size();
     }
 
+    // Reads a flat number array (table) or a float32 buffer for the batch
+    // drawing types. Returns nullptr if the value is neither.
+    static std::shared_ptr<const std::vector<float>> read_point_array(lua_State* L, int idx);
+
     friend class Executor;
+    friend class LuaActor;
 
 private:
     LuaEngine();
@@ -134,6 +168,7 @@ private:
     bool execute_internal(const std::string& script,
                           const std::string& chunk_name);
     void shutdown_internal();
+    void publish_metrics();
 
     bool execute_bytecode_internal(const std::string& bytecode,
                                    const std::string& chunk_name);
@@ -151,8 +186,40 @@ private:
     void register_task_lib();
     void register_drawing_lib();
     void register_signal_lib();
+    void register_actor_lib();
     void sandbox();
 
+    // Actor VMs only: queue inbound messages as handler tasks, drop the serial
+    // lock taken by task.synchronize(), and decide whether/how long to sleep
+    void deliver_actor_messages();
+    void leave_serial();
+    bool has_actor_work() const;
+    // Also used by the Executor's local lane to schedule its ticks
+    int  ms_until_next_task() const;
+
+    // Per-script accounting. Every resume goes through resume_script, which
+    // charges its self time (nested resumes excluded) to the script id.
+    struct ScriptStats {
+        std::string name;
+        int    memcat       = 0;  // 0 when all categories are taken
+        size_t mem_baseline = 0;
+        size_t memory         = 0;
+        size_t pending_timers = 0;
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> resumes{0};
+        std::atomic<uint64_t> yields{0};
+        std::atomic<bool>     killed{false};
+        std::atomic<bool>     removed{false};  // erased on the next refresh
+        bool finished = false;
+    };
+    int          begin_script(lua_State* thread, const std::string& chunk_name);
+    void         tag_thread(lua_State* co, int script_id);
+    int          resume_script(lua_State* co, int nargs, int script_id);
+    ScriptStats* find_script(int script_id);
+    bool         script_killed(int script_id);
+    void         cancel_killed_scripts();
+    void         refresh_script_usage();
+
     static void* lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize);
     static void  lua_interrupt(lua_State* L, int gc);
 
@@ -187,12 +254,26 @@ private:
     static int lua_base64_encode(lua_State* L);
     static int lua_base64_decode(lua_State* L);
     static int lua_sha256(lua_State* L);
+    static int lua_crypt_hash(lua_State* L);
+    static int lua_crypt_hmac(lua_State* L);
+    static int lua_crypt_hasher(lua_State* L);
+    static int lua_crypt_hashfile(lua_State* L);
+    static int lua_hasher_update(lua_State* L);
+    static int lua_hasher_digest(lua_State* L);
 
     static int lua_task_spawn(lua_State* L);
     static int lua_task_delay(lua_State* L);
     static int lua_task_defer(lua_State* L);
     static int lua_task_wait(lua_State* L);
     static int lua_task_cancel(lua_State* L);
+    static int lua_task_synchronize(lua_State* L);
+    static int lua_task_desynchronize(lua_State* L);
+
+    static int lua_actor_spawn(lua_State* L);
+    static int lua_actor_send(lua_State* L);
+    static int lua_actor_receive(lua_State* L);
+    static int lua_actor_onmessage(lua_State* L);
+    static int lua_actor_sharedbuffer(lua_State* L);
 
     lua_State* main_state() const { return L_; }
 
@@ -226,7 +307,6 @@ private:
 
     mutable std::mutex drawing_mutex_;
     std::unordered_map<int, DrawingObject> drawing_objects_;
-    int next_drawing_id_ = 1;
 
     int next_signal_id_ = 1;
 
@@ -244,6 +324,24 @@ private:
 
     size_t total_allocated_ = 0;
     static constexpr size_t MAX_MEMORY = 256 * 1024 * 1024;
+
+    // Last values added to the process-wide gauges (summed across engines)
+    double published_heap_  = 0;
+    double published_tasks_ = 0;
+
+    LuaActor* actor_             = nullptr;  // set when this VM runs an actor
+    int       actor_handler_ref_ = LUA_NOREF;
+    bool      serial_held_       = false;
+
+    // Mutated with both mutex_ and stats_mutex_ held; the VM thread reads
+    // under mutex_ alone, the UI under stats_mutex_
+    std::unordered_map<int, ScriptStats> scripts_;
+    mutable std::mutex stats_mutex_;
+    std::vector<int>   free_memcats_;
+    int      next_script_id_ = 1;
+    int      current_script_ = 0;
+    uint64_t child_ticks_    = 0;
+    std::atomic<bool> kill_pending_{false};  // some listed script is marked killed
 };
 
 }
@@ -1,5 +1,6 @@
 #include "memory.hpp"
 #include "utils/logger.hpp"
+#include "utils/metrics.hpp"
 
 #include <filesystem>
 #include <fstream>
@@ -338,7 +339,7 @@ std::vector<MemoryRegion> Memory::get_regions(bool refresh) {
     }
 
     regions_cached_ = true;
-    LOG_DEBUG("Found {} total regions for PID {}", cached_regions_.size(), pid_);
+    LOG_SUB_DEBUG("memory", "Found {} total regions for PID {}", cached_regions_.size(), pid_);
     return cached_regions_;
 }
 
@@ -377,8 +378,8 @@ std::vector<MemoryRegion> Memory::get_readable_regions() {
         total_size += r.size();
     }
 
-    LOG_INFO("{} readable regions ({:.1f} MB) available for scanning",
-             result.size(),
+    LOG_SUB_INFO("memory", "{} readable regions ({:.1f} MB) available for scanning",
+                 result.size(),
              static_cast<double>(total_size) / (1024.0 * 1024.0));
     return result;
 }
@@ -421,14 +422,21 @@ Memory::get_module_size(const std::string& module_name) {
     return std::nullopt;
 }
 
+static Counter& g_read_syscalls = Metrics::instance().counter(
+    "oss_memory_read_syscalls_total", "pread64/process_vm_readv calls against the target");
+static Counter& g_scanned_bytes = Metrics::instance().counter(
+    "oss_memory_scanned_bytes_total", "Bytes read from the target by memory scans");
+
 bool Memory::read_proc_mem(uintptr_t addr, void* buf, size_t len) {
     if (mem_fd_ < 0) return false;
+    g_read_syscalls.add();
     ssize_t result = ::pread64(mem_fd_, buf, len, static_cast<off64_t>(addr));
     return result == static_cast<ssize_t>(len);
 }
 
 bool Memory::read_process_vm(uintptr_t addr, void* buf, size_t len) {
     if (pid_ <= 0) return false;
+    g_read_syscalls.add();
     struct iovec local_iov  = { buf, len };
     struct iovec remote_iov = { reinterpret_cast<void*>(addr), len };
     ssize_t result = process_vm_readv(pid_, &local_iov, 1, &remote_iov, 1, 0);
@@ -567,6 +575,7 @@ void Memory::batch_read(std::vector<BatchReadEntry>& entries) {
     if (pid_ <= 0 || entries.empty()) return;
 
     if (mem_fd_ >= 0) {
+        g_read_syscalls.add(entries.size());
         for (auto& e : entries) {
             ssize_t r = ::pread64(mem_fd_, e.buffer, e.size,
                                   static_cast<off64_t>(e.address));
@@ -590,6 +599,7 @@ void Memory::batch_read(std::vector<BatchReadEntry>& entries) {
             total_expected += e.size;
         }
 
+        g_read_syscalls.add();
         ssize_t result = process_vm_readv(
             pid_, local_iovs.data(),
             static_cast<unsigned long>(batch_count),
@@ -825,6 +835,8 @@ std::vector<PatternResult> Memory::scan_pattern(
 
             total_scanned_ += read_size;
 
+            g_scanned_bytes.add(read_size);
+
             for (size_t i = 0; i <= read_size - pattern_len; i++) {
                 bool match = true;
                 for (size_t j = 0; j < pattern_len; j++) {
@@ -917,11 +929,11 @@ LuauStateInfo Memory::scan_for_task_scheduler(
 
     auto str_results = scan_string(regions, ts_str);
     if (str_results.empty()) {
-        LOG_DEBUG("TaskScheduler string not found");
+        LOG_SUB_DEBUG("memory", "TaskScheduler string not found");
         return {};
     }
 
-    LOG_DEBUG("Found {} TaskScheduler string refs", str_results.size());
+    LOG_SUB_DEBUG("memory", "Found {} TaskScheduler string refs", str_results.size());
 
     for (const auto& sr : str_results) {
         uintptr_t str_addr = sr.address;
@@ -986,7 +998,7 @@ LuauStateInfo Memory::scan_for_lua_state_direct(
         }
     }
 
-    LOG_DEBUG("Scanning {} heap regions for lua_State", heap_regions.size());
+    LOG_SUB_DEBUG("memory", "Scanning {} heap regions for lua_State", heap_regions.size());
 
     constexpr size_t CHUNK = 2 * 1024 * 1024;
     std::vector<uint8_t> buf(CHUNK);
@@ -1002,6 +1014,8 @@ LuauStateInfo Memory::scan_for_lua_state_direct(
 
             total_scanned_ += rsize;
 
+            g_scanned_bytes.add(rsize);
+
             for (size_t i = 0; i + 128 <= rsize; i += 8) {
 
                 bool layout1 = (buf[i] == 8 && buf[i + 1] < 8 && buf[i + 4] <= 6);
@@ -1089,6 +1103,8 @@ LuauStateInfo Memory::scan_for_string_table(
 
                 total_scanned_ += rsize;
 
+                g_scanned_bytes.add(rsize);
+
                 bool found_marker = false;
                 for (size_t i = 0; i + marker.size() <= rsize; i++) {
                     if (std::memcmp(buf.data() + i, marker.data(),
@@ -21,7 +21,9 @@
 #include <cstdarg>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <ctime>
 #include "luacode.h"
+#include "core/exec_trace.hpp"
 
 static pthread_t g_file_t = 0, g_ipc_t = 0, g_init_t = 0;
 
@@ -176,6 +178,13 @@ using fn_newthread = lua_State* (*)(lua_State*);
 using fn_settop    = void  (*)(lua_State*, int);
 using fn_tolstring = const char* (*)(lua_State*, int, size_t*);
 using fn_gettop    = int   (*)(lua_State*);
+
+struct QueuedScript {
+    std::string src;
+    uint64_t    trace_id  = 0;  // 0 = untraced
+    uint64_t    queued_ns = 0;
+    int         reply_fd  = -1; // socket awaiting PAYLOAD_DONE_LINE
+};
 using fn_sandbox   = void  (*)(lua_State*);
 
 struct {
@@ -192,7 +201,7 @@ struct {
     fn_sandbox    sandbox  = nullptr;
     fn_resume     original_resume = nullptr;
     lua_State*    captured_L = nullptr;
-    std::deque<std::string> queue;
+    std::deque<QueuedScript> queue;
     std::mutex              mtx;
     std::atomic<bool>       alive{false};
     std::atomic<bool>       hooked{false};
@@ -208,6 +217,93 @@ struct {
 
 static thread_local bool g_in = false;
 
+// ─── Execution trace ring ────────────────────────────────────────────────────
+// Only the thread running drain_queue records spans, so the ring needs no
+// lock; the executor stitches the dumped file into its own timeline.
+static oss::PayloadSpan g_spans[oss::PAYLOAD_SPAN_CAP];
+static size_t           g_span_next  = 0;
+static size_t           g_span_count = 0;
+
+static uint64_t mono_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void record_span(uint64_t trace_id, const char* name, uint64_t begin_ns, uint64_t end_ns) {
+    if (!trace_id) return;
+    oss::PayloadSpan& s = g_spans[g_span_next];
+    s.trace_id = trace_id;
+    s.begin_ns = begin_ns;
+    s.end_ns   = end_ns;
+    strncpy(s.name, name, sizeof(s.name) - 1);
+    s.name[sizeof(s.name) - 1] = '\0';
+    g_span_next = (g_span_next + 1) % oss::PAYLOAD_SPAN_CAP;
+    if (g_span_count < oss::PAYLOAD_SPAN_CAP) g_span_count++;
+}
+
+// Refuses a directory someone else owns, one opened up to other users, or a
+// symlink standing in for it
+static bool trace_dir(char (&dir)[32]) {
+    uid_t uid = getuid();
+    oss::format_trace_dir((unsigned)uid, dir);
+    if (mkdir(dir, 0700) != 0 && errno != EEXIST) return false;
+    struct stat st;
+    if (lstat(dir, &st) != 0 || !S_ISDIR(st.st_mode) || st.st_uid != uid ||
+        (st.st_mode & 077) != 0) {
+        plog("[payload] trace dir %s is not a private directory, not writing spans\n", dir);
+        return false;
+    }
+    return true;
+}
+
+// Oldest first, via tmp + rename so the executor never reads a torn file
+static void flush_spans() {
+    char dir[32];
+    if (!trace_dir(dir)) return;
+    char path[64], tmp[72];
+    snprintf(path, sizeof(path), "%s/%s", dir, oss::PAYLOAD_TRACE_FILE);
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    unlink(tmp);  // left behind by a flush that died halfway
+    int fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0600);
+    if (fd < 0) return;
+    size_t first = (g_span_next + oss::PAYLOAD_SPAN_CAP - g_span_count) % oss::PAYLOAD_SPAN_CAP;
+    bool ok = true;
+    for (size_t i = 0; i < g_span_count && ok; i++) {
+        const oss::PayloadSpan& s = g_spans[(first + i) % oss::PAYLOAD_SPAN_CAP];
+        ok = write(fd, &s, sizeof(s)) == (ssize_t)sizeof(s);
+    }
+    close(fd);
+    if (!ok || rename(tmp, path) != 0) unlink(tmp);
+}
+
+// The executor may already have given up on the reply, hence MSG_NOSIGNAL
+static void send_done(int fd) {
+    if (fd < 0) return;
+    ssize_t r = send(fd, oss::PAYLOAD_DONE_LINE, oss::PAYLOAD_DONE_LEN, MSG_NOSIGNAL);
+    (void)r;
+    close(fd);
+}
+
+// Strips the trace tag line (if any) so chunk line numbers match the editor.
+// reply_fd is kept only for traced scripts; untraced senders don't wait.
+static void enqueue_script(std::string&& script, int reply_fd = -1) {
+    QueuedScript q;
+    q.queued_ns = mono_ns();
+    q.trace_id  = oss::parse_trace_line(script.data(), script.size());
+    if (q.trace_id) script.erase(0, oss::TRACE_LINE_LEN);
+    if (q.trace_id) {
+        q.reply_fd = reply_fd;
+    } else if (reply_fd >= 0) {
+        close(reply_fd);
+    }
+    q.src = std::move(script);
+    std::lock_guard<std::mutex> lk(G.mtx);
+    G.queue.emplace_back(std::move(q));
+    G.queue_count.fetch_add(1, std::memory_order_relaxed);
+}
+// ─────────────────────────────────────────────────────────────────────────────
+
 static void set_identity(lua_State* L) {
     if (!L) return;
     uint8_t* extra = nullptr;
@@ -259,15 +355,22 @@ static void drain_queue(lua_State* L) {
         return;
     }
 
-    std::deque<std::string> batch;
+    std::deque<QueuedScript> batch;
     {
         std::lock_guard<std::mutex> lk(G.mtx);
         batch.swap(G.queue);
         G.queue_count.store(0, std::memory_order_relaxed);
     }
-    for (auto& src : batch) {
+    bool traced = false;
+    for (auto& item : batch) {
+        const std::string& src = item.src;
         if (src.empty()) continue;
 
+        const uint64_t tid = item.trace_id;
+        traced |= tid != 0;
+        uint64_t t_compile = mono_ns();
+        record_span(tid, "payload_queue", item.queued_ns, t_compile);
+
         const char* bc_data = nullptr;
         size_t bc_sz = 0;
         char* compiled = nullptr;
@@ -315,6 +418,8 @@ static void drain_queue(lua_State* L) {
 
         plog("[payload] bytecode version byte: %d (size=%zu)\n",
              (int)(uint8_t)bc_data[0], bc_sz);
+        uint64_t t_load = mono_ns();
+        if (!is_bytecode) record_span(tid, "payload_compile", t_compile, t_load);
 
         int top_before = G.gettop ? G.gettop(L) : -1;
         lua_State* th = G.newthread(L);
@@ -348,10 +453,15 @@ static void drain_queue(lua_State* L) {
             if (compiled) { free(compiled); compiled = nullptr; }
             if (top_before >= 0 && G.gettop) G.settop(L, top_before);
             else G.settop(L, -2);
+            record_span(tid, "payload_load_error", t_load, mono_ns());
             continue;
         }
+        uint64_t t_run = mono_ns();
+        record_span(tid, "payload_load", t_load, t_run);
         plog("[payload] executing script (%zu bytes bc)...\n", bc_sz);
         int rr = G.original_resume(th, nullptr, 0);
+        record_span(tid, (rr != 0 && rr != 1) ? "payload_run_error" : "payload_run",
+                    t_run, mono_ns());
         if (rr != 0 && rr != 1) {
             if (G.tolstring) {
                 size_t len = 0;
@@ -367,7 +477,9 @@ static void drain_queue(lua_State* L) {
         else G.settop(L, -2);
         if (compiled) { free(compiled); compiled = nullptr; }
     }
+    if (traced) flush_spans();
     write_status("drained");
+    for (auto& item : batch) send_done(item.reply_fd);
 }
 
 static int resume_detour(lua_State* L, lua_State* from, int nargs) {
@@ -1555,11 +1667,7 @@ static void poll_mailbox() {
     plog("[payload] mailbox: received %u bytes (seq=%lu flags=%u)\n",
          sz, (unsigned long)seq, g_mailbox->flags);
 
-    {
-        std::lock_guard<std::mutex> lk(G.mtx);
-        G.queue.emplace_back(std::move(script));
-        G.queue_count.fetch_add(1, std::memory_order_relaxed);
-    }
+    enqueue_script(std::move(script));
 
     __atomic_store_n(&g_mailbox->ack, seq, __ATOMIC_RELEASE);
 }
@@ -1597,11 +1705,7 @@ static void* file_cmd_worker(void*) {
                             std::string script(buf, (size_t)total);
                             plog("[payload] file-IPC: received %zd bytes, hooked=%d captured_L=%p\n",
                                  total, G.hooked.load() ? 1 : 0, G.captured_L);
-                            {
-                                std::lock_guard<std::mutex> lk(G.mtx);
-                                G.queue.emplace_back(std::move(script));
-                                G.queue_count.fetch_add(1, std::memory_order_relaxed);
-                            }
+                            enqueue_script(std::move(script));
                             plog("[payload] file-IPC: queued (queue size=%d)\n",
                                  G.queue_count.load());
                             write_status("queued");
@@ -1735,12 +1839,11 @@ static void* ipc_worker(void*) {
             if (total >= RECV_BUF - 1) break;
         }
         buf[total] = '\0';
-        close(cfd);
         if (total > 0) {
-            std::lock_guard<std::mutex> lk(G.mtx);
-            G.queue.emplace_back(buf, total);
-            G.queue_count.fetch_add(1, std::memory_order_relaxed);
+            enqueue_script(std::string(buf, total), cfd);
             plog("[payload] ipc: queued %zu bytes\n", total);
+        } else {
+            close(cfd);
         }
     }
     free(buf);
@@ -2078,6 +2181,13 @@ static void payload_fini() {
     }
 
     if (g_ipc_t) { pthread_join(g_ipc_t, &retval); g_ipc_t = 0; }
+    {
+        std::lock_guard<std::mutex> lk(G.mtx);
+        for (auto& item : G.queue) {
+            if (item.reply_fd >= 0) close(item.reply_fd);
+            item.reply_fd = -1;
+        }
+    }
 
     if (g_mailbox) {
         munmap(g_mailbox, sizeof(Mailbox));
@@ -15,14 +15,20 @@ static void fix_gio_before_anything() {
 }
 
 #include "ui/app.hpp"
+#include "ui/render_bench.hpp"
 #include "core/executor.hpp"
 #include "core/injection.hpp"
+#include "core/control_server.hpp"
 #include "utils/logger.hpp"
 #include "utils/config.hpp"
+#include "utils/file_watcher.hpp"
+#include "utils/trace.hpp"
 
 #include <csignal>
+#include <pthread.h>
 #include <iostream>
 #include <filesystem>
+#include <string>
 
 static void signal_handler(int sig) {
     static constexpr char msg[] = "\n[!] Signal received, shutting down...\n";
@@ -66,11 +72,56 @@ static void ensure_home_dirs(const std::string& home) {
     }
 }
 
+// Consumes --startup-trace FILE and --tti-budget MS; GApplication rejects
+// options it doesn't know, so they are removed from argv in place.
+static void parse_trace_args(int& argc, char** argv) {
+    auto& trace = oss::Trace::instance();
+    int out = 1;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (std::strcmp(argv[i], "--startup-trace") == 0 && has_val) {
+            trace.enable(argv[++i]);
+        } else if (std::strcmp(argv[i], "--tti-budget") == 0 && has_val) {
+            trace.set_tti_budget_ms(std::atof(argv[++i]));
+        } else {
+            argv[out++] = argv[i];
+        }
+    }
+    argv[out] = nullptr;
+    argc = out;
+
+    // A budget check needs the recorder even without an output file
+    if (trace.tti_budget_ms() > 0 && !trace.enabled()) trace.enable("");
+}
+
 int main(int argc, char** argv) {
     signal(SIGPIPE, SIG_IGN);
     signal(SIGINT,  signal_handler);
     signal(SIGTERM, signal_handler);
 
+    // Offscreen overlay bench / golden render — needs no display
+    if (argc > 1 && std::strcmp(argv[1], "--render-bench") == 0)
+        return oss::run_render_bench(argc - 1, argv + 1);
+
+    parse_trace_args(argc, argv);
+    auto& trace = oss::Trace::instance();
+
+    // Headless daemon: executor + control socket, no GTK
+    bool headless = false;
+    std::string socket_path;
+    if (argc > 1 && std::strcmp(argv[1], "--headless") == 0) {
+        headless = true;
+        if (argc > 3 && std::strcmp(argv[2], "--socket") == 0) socket_path = argv[3];
+
+        // Signals are collected by sigwait() in run_headless; block them
+        // before any thread starts so every thread inherits the mask.
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGINT);
+        sigaddset(&set, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &set, nullptr);
+    }
+
     print_banner();
 
     int exit_code = 0;
@@ -79,11 +130,34 @@ int main(int argc, char** argv) {
         auto& config = oss::Config::instance();
         std::string home = config.home_dir();
 
-        oss::Logger::init(home + "/logs");
+        {
+            TRACE_SPAN("logger_init");
+            oss::Logger::init(home + "/logs");
+        }
         LOG_INFO("OSS Executor v{} starting", APP_VERSION);
 
         std::string config_path = home + "/config.json";
-        config.load(config_path);
+        {
+            TRACE_SPAN("config_load");
+            config.load(config_path);
+        }
+        oss::Logger::apply_config();
+
+        // Edits to config.json apply live; key listeners pick up the changes
+        oss::FileWatcher::instance().watch(home, [config_path](const std::vector<oss::FileEvent>& events) {
+            for (const auto& ev : events) {
+                bool ours = ev.change == oss::FileChange::Rescan ||
+                            (ev.change == oss::FileChange::Written && ev.path() == config_path);
+                if (!ours) continue;
+                if (oss::Config::instance().reload()) {
+                    oss::Logger::apply_config();
+                    LOG_INFO("Configuration reloaded from {}", config_path);
+                } else {
+                    LOG_WARN("Ignoring unreadable {}", config_path);
+                }
+            }
+        });
+        oss::FileWatcher::instance().start();
         LOG_INFO("Configuration loaded from {}", config_path);
 
         ensure_home_dirs(home);
@@ -102,23 +176,40 @@ int main(int argc, char** argv) {
             LOG_INFO("[status] {}", msg);
         });
 
-        executor.init();
-
-        if (!executor.is_initialized()) {
-            LOG_ERROR("Executor failed to initialize — exiting");
-            std::cerr << "[FATAL] Executor initialization failed" << std::endl;
-            return 1;
+        if (headless) {
+            {
+                TRACE_SPAN("executor_init");
+                executor.init();
+            }
+            if (!executor.is_initialized()) {
+                LOG_ERROR("Executor failed to initialize — exiting");
+                std::cerr << "[FATAL] Executor initialization failed" << std::endl;
+                return 1;
+            }
+            if (socket_path.empty())
+                socket_path = config.get<std::string>("control.socket", home + "/control.sock");
+            exit_code = oss::run_headless(socket_path);
+        } else {
+            // The UI brings the executor up after its first frame
+            LOG_INFO("Starting UI...");
+            oss::App app(argc, argv);
+            exit_code = app.run();
+            LOG_INFO("UI exited with code {}", exit_code);
         }
 
-        if (config.get<bool>("executor.autoexec_on_start", true)) {
-            executor.auto_execute();
-        }
+        // Second dump picks up the deferred subsystems and shutdown-time spans
+        if (trace.enabled()) trace.dump();
 
-        LOG_INFO("Starting UI...");
-        oss::App app(argc, argv);
-        exit_code = app.run();
-        LOG_INFO("UI exited with code {}", exit_code);
+        if (trace.tti_budget_ms() > 0) {
+            double tti = trace.tti_ms();
+            bool over = tti <= 0 || tti > trace.tti_budget_ms();
+            std::cout << "{\"tti_ms\": " << tti
+                      << ", \"budget_ms\": " << trace.tti_budget_ms()
+                      << ", \"passed\": " << (over ? "false" : "true") << "}" << std::endl;
+            if (over && exit_code == 0) exit_code = 4;
+        }
 
+        oss::FileWatcher::instance().stop();
         oss::Injection::instance().stop_auto_scan();
         oss::Injection::instance().detach();
         executor.shutdown();
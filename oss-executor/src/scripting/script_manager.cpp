@@ -7,6 +7,40 @@
 
 namespace oss {
 
+static bool is_script_file(const std::filesystem::path& path) {
+    auto ext = path.extension().string();
+    return ext == ".lua" || ext == ".luau" || ext == ".txt";
+}
+
+// Fills an index entry from one stat; false if the file is gone or not a script
+static bool describe(const std::filesystem::path& path, SavedScript& script) {
+    std::error_code ec;
+    if (!is_script_file(path) || !std::filesystem::is_regular_file(path, ec)) return false;
+
+    script.name = path.filename().string();
+    script.path = path.string();
+    script.size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+
+    auto ftime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    auto sctp  = std::chrono::time_point_cast<
+                     std::chrono::system_clock::duration>(
+        ftime - std::filesystem::file_time_type::clock::now()
+              + std::chrono::system_clock::now()
+    );
+    auto time_val = std::chrono::system_clock::to_time_t(sctp);
+
+    struct tm tm_buf{};
+    localtime_r(&time_val, &tm_buf);
+
+    char time_str[64];
+    strftime(time_str, sizeof(time_str),
+             "%Y-%m-%d %H:%M:%S", &tm_buf);
+    script.modified_time = time_str;
+    return true;
+}
+
 std::filesystem::path ScriptManager::safe_script_path(const std::string& name) const {
     if (name.empty() || dir_.empty()) return {};
 
@@ -38,70 +72,111 @@ std::filesystem::path ScriptManager::safe_script_path(const std::string& name) c
 
 void ScriptManager::set_directory(const std::string& dir) {
     if (dir.empty()) return;
+
+    // unwatch() waits for a running callback, which takes mtx_
+    std::vector<int> old_watches;
+    {
+        std::lock_guard lock(mtx_);
+        for (DirIndex* index : {&scripts_, &autoexec_}) {
+            if (index->watch_id >= 0) old_watches.push_back(index->watch_id);
+            index->watch_id = -1;
+        }
+    }
+    for (int id : old_watches) FileWatcher::instance().unwatch(id);
+
     std::lock_guard lock(mtx_);
     dir_ = dir;
     try {
         std::filesystem::create_directories(dir);
+        std::filesystem::create_directories(dir + "/autoexec");
     } catch (const std::filesystem::filesystem_error& e) {
         LOG_ERROR("Failed to create script directory {}: {}", dir, e.what());
     }
-}
 
-std::string ScriptManager::scripts_directory() const {
-    std::lock_guard lock(mtx_);
-    return dir_;
+    scripts_.dir  = dir;
+    autoexec_.dir = dir + "/autoexec";
+    for (DirIndex* index : {&scripts_, &autoexec_}) {
+        rescan(*index);
+        watch(*index);
+    }
+    LOG_INFO("Indexed {} scripts, {} autoexec", scripts_.entries.size(),
+             autoexec_.entries.size());
 }
 
-std::vector<SavedScript> ScriptManager::list_scripts() const {
-    std::vector<SavedScript> scripts;
+// Waits for a running callback, so the old one is done once this returns
+void ScriptManager::set_change_callback(
+    std::function<void(const std::vector<FileEvent>&)> cb)
+{
+    std::lock_guard lock(cb_mtx_);
+    change_cb_ = std::move(cb);
+}
 
-    std::string dir;
-    {
-        std::lock_guard lock(mtx_);
-        dir = dir_;
+// Caller holds mtx_
+void ScriptManager::rescan(DirIndex& index) {
+    index.entries.clear();
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(index.dir, ec)) {
+        SavedScript script;
+        if (describe(entry.path(), script))
+            index.entries.emplace(script.name, std::move(script));
     }
+    if (ec) LOG_ERROR("Failed to list scripts in {}: {}", index.dir, ec.message());
+}
 
-    if (dir.empty() || !std::filesystem::exists(dir)) return scripts;
+// Caller holds mtx_
+void ScriptManager::refresh_entry(DirIndex& index, const std::string& name) {
+    SavedScript script;
+    if (describe(std::filesystem::path(index.dir) / name, script))
+        index.entries[name] = std::move(script);
+    else
+        index.entries.erase(name);
+}
 
-    try {
-        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
-            if (!entry.is_regular_file()) continue;
-
-            auto ext = entry.path().extension().string();
-            if (ext != ".lua" && ext != ".luau" && ext != ".txt") continue;
-
-            SavedScript script;
-            script.name = entry.path().filename().string();
-            script.path = entry.path().string();
-            script.size = entry.file_size();
-
-            auto ftime = entry.last_write_time();
-            auto sctp  = std::chrono::time_point_cast<
-                             std::chrono::system_clock::duration>(
-                ftime - std::filesystem::file_time_type::clock::now()
-                      + std::chrono::system_clock::now()
-            );
-            auto time_val = std::chrono::system_clock::to_time_t(sctp);
-
-            struct tm tm_buf{};
-            localtime_r(&time_val, &tm_buf);
-
-            char time_str[64];
-            strftime(time_str, sizeof(time_str),
-                     "%Y-%m-%d %H:%M:%S", &tm_buf);
-            script.modified_time = time_str;
-
-            scripts.push_back(std::move(script));
-        }
-    } catch (const std::filesystem::filesystem_error& e) {
-        LOG_ERROR("Failed to list scripts in {}: {}", dir, e.what());
+// Caller holds mtx_; keeps our own writes visible before the watcher reports them
+void ScriptManager::refresh_path(const std::filesystem::path& path) {
+    auto parent = path.parent_path().lexically_normal();
+    for (DirIndex* index : {&scripts_, &autoexec_}) {
+        if (std::filesystem::path(index->dir).lexically_normal() == parent)
+            refresh_entry(*index, path.filename().string());
     }
+}
 
-    std::sort(scripts.begin(), scripts.end(),
-        [](const SavedScript& a, const SavedScript& b) {
-            return a.name < b.name;
+// Caller holds mtx_ and has unwatched the index's previous watch
+void ScriptManager::watch(DirIndex& index) {
+    DirIndex* target = &index;
+    index.watch_id = FileWatcher::instance().watch(index.dir,
+        [this, target](const std::vector<FileEvent>& events) {
+            {
+                std::lock_guard lock(mtx_);
+                for (const auto& ev : events) {
+                    if (ev.change == FileChange::Rescan) rescan(*target);
+                    else refresh_entry(*target, ev.name);
+                }
+            }
+            std::lock_guard lock(cb_mtx_);
+            if (change_cb_) change_cb_(events);
         });
+}
 
+std::string ScriptManager::scripts_directory() const {
+    std::lock_guard lock(mtx_);
+    return dir_;
+}
+
+// Index maps are keyed by name, so both listings come out sorted
+std::vector<SavedScript> ScriptManager::list_scripts() const {
+    std::lock_guard lock(mtx_);
+    std::vector<SavedScript> scripts;
+    scripts.reserve(scripts_.entries.size());
+    for (const auto& [_, script] : scripts_.entries) scripts.push_back(script);
+    return scripts;
+}
+
+std::vector<SavedScript> ScriptManager::list_autoexec() const {
+    std::lock_guard lock(mtx_);
+    std::vector<SavedScript> scripts;
+    scripts.reserve(autoexec_.entries.size());
+    for (const auto& [_, script] : autoexec_.entries) scripts.push_back(script);
     return scripts;
 }
 
@@ -136,6 +211,11 @@ bool ScriptManager::save_script(const std::string& name,
         return false;
     }
 
+    file.close();
+    {
+        std::lock_guard lock(mtx_);
+        refresh_path(path);
+    }
     LOG_INFO("Script saved: {}", path.filename().string());
     return true;
 }
@@ -160,7 +240,11 @@ bool ScriptManager::delete_script(const std::string& name) {
 
     try {
         bool removed = std::filesystem::remove(path);
-        if (removed) LOG_INFO("Script deleted: {}", name);
+        if (removed) {
+            std::lock_guard lock(mtx_);
+            refresh_path(path);
+            LOG_INFO("Script deleted: {}", name);
+        }
         return removed;
     } catch (const std::filesystem::filesystem_error& e) {
         LOG_ERROR("Failed to delete script {}: {}", name, e.what());
@@ -177,6 +261,11 @@ bool ScriptManager::rename_script(const std::string& old_name,
 
     try {
         std::filesystem::rename(old_path, new_path);
+        {
+            std::lock_guard lock(mtx_);
+            refresh_path(old_path);
+            refresh_path(new_path);
+        }
         LOG_INFO("Script renamed: {} → {}", old_name, new_name);
         return true;
     } catch (const std::filesystem::filesystem_error& e) {
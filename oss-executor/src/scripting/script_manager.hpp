@@ -1,9 +1,13 @@
 #pragma once
 
+#include "utils/file_watcher.hpp"
+
 #include <string>
 #include <vector>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <map>
 #include <mutex>
 
 namespace oss {
@@ -22,9 +26,17 @@ public:
         return inst;
     }
 
+    // Scans the directory and its autoexec/ subfolder once, then keeps the
+    // index current from FileWatcher events
     void set_directory(const std::string& dir);
 
+    // Served from the in-memory index; never touches the disk
     std::vector<SavedScript> list_scripts() const;
+    std::vector<SavedScript> list_autoexec() const;
+
+    // Runs on the watcher thread after external changes reach the index.
+    // Replacing it waits for a call in progress.
+    void set_change_callback(std::function<void(const std::vector<FileEvent>&)> cb);
 
     bool        save_script(const std::string& name, const std::string& content);
     std::string load_script(const std::string& name) const;
@@ -41,10 +53,25 @@ private:
     ScriptManager(const ScriptManager&)            = delete;
     ScriptManager& operator=(const ScriptManager&) = delete;
 
+    struct DirIndex {
+        std::string                        dir;
+        std::map<std::string, SavedScript> entries;
+        int                                watch_id = -1;
+    };
+
     std::filesystem::path safe_script_path(const std::string& name) const;
 
+    void rescan(DirIndex& index);
+    void refresh_entry(DirIndex& index, const std::string& name);
+    void refresh_path(const std::filesystem::path& path);
+    void watch(DirIndex& index);
+
     mutable std::mutex mtx_;
     std::string        dir_;
+    DirIndex           scripts_;
+    DirIndex           autoexec_;
+    std::mutex         cb_mtx_;  // held while change_cb_ runs
+    std::function<void(const std::vector<FileEvent>&)> change_cb_;
 };
 
 }
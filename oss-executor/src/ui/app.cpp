@@ -2,15 +2,37 @@
 #include "overlay.hpp"
 #include "utils/logger.hpp"
 #include "utils/config.hpp"
-#include "api/environment.hpp"
-#include "api/closures.hpp"
+#include "utils/trace.hpp"
+#include "utils/metrics.hpp"
+#include "utils/file_watcher.hpp"
 
-#include <fstream>
+#include <cstdio>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <string>
 
 namespace oss {
 
+// Files at least this large show a progress bar while loading
+static constexpr size_t LARGE_FILE_BYTES = 1024 * 1024;
+
+static const auto kTheme           = Config::key<std::string>("theme", "midnight");
+static const auto kFontFamily      = Config::key<std::string>("editor.font_family", "JetBrains Mono");
+static const auto kFontSize        = Config::key<int>("editor.font_size", 14);
+static const auto kMetricsTextfile = Config::key<std::string>("metrics.textfile");
+static const auto kAutoexecOnStart = Config::key<bool>("executor.autoexec_on_start", true);
+
+// Runs fn on the GTK main loop; safe to call from any thread.
+static void run_on_ui(std::function<void()> fn) {
+    g_idle_add([](gpointer data) -> gboolean {
+        auto* f = static_cast<std::function<void()>*>(data);
+        (*f)();
+        delete f;
+        return G_SOURCE_REMOVE;
+    }, new std::function<void()>(std::move(fn)));
+}
+
 App::App(int argc, char** argv) : argc_(argc), argv_(argv) {
 #if GLIB_CHECK_VERSION(2, 74, 0)
     gtk_app_ = gtk_application_new("com.oss.executor", G_APPLICATION_DEFAULT_FLAGS);
@@ -23,8 +45,16 @@ App::App(int argc, char** argv) : argc_(argc), argv_(argv) {
 }
 
 App::~App() {
+    // A save queued just before quitting must land; the tab was already
+    // marked unmodified, so nothing else would warn about losing it
+    FileDialog::flush_writes();
+    config_subs_.clear();
     disconnect_executor();
 
+    if (theme_watch_ >= 0) FileWatcher::instance().unwatch(theme_watch_);
+    ScriptManager::instance().set_change_callback(nullptr);
+    if (theme_provider_) g_object_unref(theme_provider_);
+
     if (tick_id_ > 0) {
         g_source_remove(tick_id_);
         tick_id_ = 0;
@@ -84,38 +114,20 @@ void App::disconnect_executor() {
 }
 
 void App::build_ui(GtkApplication* app) {
+    TRACE_SPAN("build_ui");
     auto& config = Config::instance();
     std::string home = config.home_dir();
 
     Logger::init(home + "/logs");
-    config.load(home + "/config.json");
 
-    ThemeManager::instance().load_themes(home + "/themes");
-    ThemeManager::instance().set_theme(config.get<std::string>("theme", "midnight"));
-    ScriptManager::instance().set_directory(home + "/scripts");
-
-    Executor::instance().init();
-
-    if (Executor::instance().is_initialized()) {
-        lua_State* L = Executor::instance().lua().state();
-        if (L) {
-            Environment::instance().setup(L);
-            Closures::register_all(L);
-            int count = 0;
-            lua_pushvalue(L, LUA_GLOBALSINDEX);
-            lua_pushnil(L);
-            while (lua_next(L, -2) != 0) { ++count; lua_pop(L, 1); }
-            lua_pop(L, 1);
-            LOG_INFO("Lua API registered ({} globals)", count);
-        } else {
-            LOG_ERROR("Lua state is null — skipping API registration");
-        }
-    } else {
-        LOG_ERROR("Executor failed to initialize — execution will be unavailable");
+    {
+        TRACE_SPAN("theme_select");
+        ThemeManager::instance().load_themes(home + "/themes");
+        ThemeManager::instance().set_theme(kTheme.get());
     }
+    ScriptManager::instance().set_directory(home + "/scripts");
 
-    Overlay::instance().init();
-
+    TRACE_SPAN("build_widgets");
     window_ = GTK_WINDOW(gtk_application_window_new(app));
     gtk_window_set_title(window_, "OSS Executor v" APP_VERSION);
     gtk_window_set_default_size(window_, 1400, 900);
@@ -227,6 +239,14 @@ void App::build_ui(GtkApplication* app) {
     }), this);
     gtk_box_append(GTK_BOX(toolbar_), overlay_toggle);
 
+    tasks_toggle_ = gtk_toggle_button_new_with_label("📊 Tasks");
+    gtk_widget_add_css_class(tasks_toggle_, "btn-secondary");
+    gtk_widget_set_tooltip_text(tasks_toggle_, "Running Scripts (Ctrl+Shift+T)");
+    g_signal_connect_swapped(tasks_toggle_, "toggled", G_CALLBACK(+[](gpointer d) {
+        static_cast<App*>(d)->on_toggle_tasks();
+    }), this);
+    gtk_box_append(GTK_BOX(toolbar_), tasks_toggle_);
+
     gtk_box_append(GTK_BOX(main_box_), toolbar_);
 
     tabs_ = std::make_unique<TabManager>();
@@ -235,13 +255,12 @@ void App::build_ui(GtkApplication* app) {
     sidebar_paned_ = gtk_paned_new(GTK_ORIENTATION_HORIZONTAL);
     gtk_widget_set_vexpand(sidebar_paned_, TRUE);
 
-    script_hub_ = std::make_unique<ScriptHub>();
+    // The hub itself is built on first toggle (see ensure_script_hub)
     hub_revealer_ = gtk_revealer_new();
     gtk_revealer_set_transition_type(GTK_REVEALER(hub_revealer_),
                                      GTK_REVEALER_TRANSITION_TYPE_SLIDE_RIGHT);
     gtk_revealer_set_reveal_child(GTK_REVEALER(hub_revealer_), FALSE);
     gtk_widget_set_size_request(hub_revealer_, 300, -1);
-    gtk_revealer_set_child(GTK_REVEALER(hub_revealer_), script_hub_->widget());
     gtk_paned_set_start_child(GTK_PANED(sidebar_paned_), hub_revealer_);
 
     paned_ = gtk_paned_new(GTK_ORIENTATION_VERTICAL);
@@ -264,6 +283,15 @@ void App::build_ui(GtkApplication* app) {
     gtk_paned_set_end_child(GTK_PANED(sidebar_paned_), paned_);
     gtk_box_append(GTK_BOX(main_box_), sidebar_paned_);
 
+    // Filled on first toggle, like the hub
+    tasks_revealer_ = gtk_revealer_new();
+    gtk_revealer_set_transition_type(GTK_REVEALER(tasks_revealer_),
+                                     GTK_REVEALER_TRANSITION_TYPE_SLIDE_UP);
+    gtk_revealer_set_reveal_child(GTK_REVEALER(tasks_revealer_), FALSE);
+    gtk_widget_set_size_request(tasks_revealer_, -1, 180);
+    gtk_widget_set_visible(tasks_revealer_, FALSE);
+    gtk_box_append(GTK_BOX(main_box_), tasks_revealer_);
+
     status_bar_ = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
     gtk_widget_add_css_class(status_bar_, "status-bar");
     gtk_widget_set_margin_start(status_bar_, 12);
@@ -276,6 +304,18 @@ void App::build_ui(GtkApplication* app) {
     gtk_widget_set_hexpand(status_label_, TRUE);
     gtk_box_append(GTK_BOX(status_bar_), status_label_);
 
+    load_progress_ = gtk_progress_bar_new();
+    gtk_widget_set_size_request(load_progress_, 120, -1);
+    gtk_widget_set_valign(load_progress_, GTK_ALIGN_CENTER);
+    gtk_widget_set_visible(load_progress_, FALSE);
+    gtk_box_append(GTK_BOX(status_bar_), load_progress_);
+
+    metrics_label_ = gtk_label_new("");
+    gtk_widget_add_css_class(metrics_label_, "dim-label");
+    gtk_widget_set_tooltip_text(metrics_label_, "Runtime metrics (Ctrl+Shift+M)");
+    gtk_widget_set_visible(metrics_label_, FALSE);
+    gtk_box_append(GTK_BOX(status_bar_), metrics_label_);
+
     position_label_ = gtk_label_new("Ln 1, Col 1");
     gtk_box_append(GTK_BOX(status_bar_), position_label_);
 
@@ -306,16 +346,28 @@ void App::build_ui(GtkApplication* app) {
         if (tabs_) tabs_->set_tab_modified(tabs_->active_id(), modified);
     });
 
-    script_hub_->set_load_callback([this](const std::string& script) {
-        int id = tabs_->add_tab("Hub Script");
-        tabs_->set_active(id);
-        editor_->set_text(script);
-        console_->print("Script loaded from hub", Console::Level::System);
-    });
-
-    apply_theme();
+    {
+        TRACE_SPAN("apply_theme");
+        apply_theme();
+    }
     setup_keybinds();
 
+    // Settings that apply live when the config changes, until ~App drops them
+    config_subs_.push_back(kTheme.on_change([this](const std::string& name) {
+        run_on_ui([this, name]() {
+            ThemeManager::instance().set_theme(name);
+            apply_theme();
+        });
+    }));
+    auto refont = [this](const auto&) {
+        run_on_ui([this]() {
+            if (editor_) editor_->set_font(kFontFamily.get(), kFontSize.get());
+        });
+    };
+    config_subs_.push_back(kFontFamily.on_change(refont));
+    config_subs_.push_back(kFontSize.on_change(refont));
+    watch_files(home);
+
     gtk_window_set_child(window_, main_box_);
     tick_id_ = g_timeout_add(500, on_tick, this);
 
@@ -324,15 +376,22 @@ void App::build_ui(GtkApplication* app) {
     console_->print("  Open Source Softworks", Console::Level::System);
     console_->print("═══════════════════════════════════════", Console::Level::System);
 
-    if (Executor::instance().is_initialized()) {
-        console_->print("Ready. Press Ctrl+Enter to execute.", Console::Level::Info);
-    } else {
-        console_->print("⚠ Executor offline — check logs", Console::Level::Warn);
-    }
-
-    Executor::instance().auto_execute();
     gtk_window_present(window_);
 
+    // Time-to-interactive is the end of the first painted frame; the first
+    // tick hands us the frame clock, whose after-paint fires once per frame.
+    gtk_widget_add_tick_callback(GTK_WIDGET(window_),
+        +[](GtkWidget*, GdkFrameClock* clock, gpointer data) -> gboolean {
+            auto* self = static_cast<App*>(data);
+            self->first_frame_handler_ = g_signal_connect(clock, "after-paint",
+                G_CALLBACK(+[](GdkFrameClock* fc, gpointer d) {
+                    auto* app = static_cast<App*>(d);
+                    g_signal_handler_disconnect(fc, app->first_frame_handler_);
+                    app->first_frame_handler_ = 0;
+                    app->on_first_frame();
+                }), self);
+            return G_SOURCE_REMOVE;
+        }, this, nullptr);
     g_idle_add([](gpointer data) -> gboolean {
         auto* rev = static_cast<GtkWidget*>(data);
         gtk_revealer_set_transition_type(GTK_REVEALER(rev),
@@ -341,23 +400,63 @@ void App::build_ui(GtkApplication* app) {
         return G_SOURCE_REMOVE;
     }, console_revealer_);
 
-    LOG_INFO("UI initialized — executor {}",
-             Executor::instance().is_initialized() ? "online" : "OFFLINE");
+    LOG_INFO("UI initialized");
 }
 
 void App::apply_theme() {
-    auto& theme = ThemeManager::instance().current();
-    std::string css = theme.generate_css();
-    GtkCssProvider* provider = gtk_css_provider_new();
+    auto& themes = ThemeManager::instance();
+    if (theme_provider_ && applied_css_generation_ == themes.css_generation()) return;
+
+    const std::string& css = themes.current_css();
+    if (!theme_provider_) {
+        theme_provider_ = gtk_css_provider_new();
+        gtk_style_context_add_provider_for_display(
+            gdk_display_get_default(), GTK_STYLE_PROVIDER(theme_provider_),
+            GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+    }
 #if GTK_CHECK_VERSION(4, 12, 0)
-    gtk_css_provider_load_from_string(provider, css.c_str());
+    gtk_css_provider_load_from_string(theme_provider_, css.c_str());
 #else
-    gtk_css_provider_load_from_data(provider, css.c_str(), -1);
+    gtk_css_provider_load_from_data(theme_provider_, css.c_str(), -1);
 #endif
-    gtk_style_context_add_provider_for_display(
-        gdk_display_get_default(), GTK_STYLE_PROVIDER(provider),
-        GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-    g_object_unref(provider);
+    applied_css_generation_ = themes.css_generation();
+}
+
+// Config reloads are handled in main (they matter headless too) and reach
+// the UI through Config key listeners; themes and scripts are UI-only.
+void App::watch_files(const std::string& home) {
+    theme_watch_ = FileWatcher::instance().watch(home + "/themes",
+        [this](const std::vector<FileEvent>& events) {
+            run_on_ui([this, events]() {
+                auto& themes = ThemeManager::instance();
+                bool current = false;
+                for (const auto& ev : events) {
+                    if (ev.change == FileChange::Rescan) {
+                        std::error_code ec;
+                        for (const auto& entry : std::filesystem::directory_iterator(ev.dir, ec)) {
+                            if (entry.path().extension() == ".json")
+                                current |= themes.reload_file(entry.path().string());
+                        }
+                        continue;
+                    }
+                    current |= ev.change == FileChange::Removed
+                                   ? themes.remove_file(ev.path())
+                                   : themes.reload_file(ev.path());
+                }
+                if (!current) return;
+                apply_theme();
+                console_->print("Theme reloaded: " + themes.current().name, Console::Level::System);
+            });
+        });
+
+    ScriptManager::instance().set_change_callback([this](const std::vector<FileEvent>& events) {
+        std::string what = events.size() == 1 ? events.front().name
+                                              : std::to_string(events.size()) + " scripts";
+        if (what.empty()) what = "rescanned";
+        run_on_ui([this, what]() {
+            console_->print("Scripts changed on disk: " + what, Console::Level::System);
+        });
+    });
 }
 
 void App::setup_keybinds() {
@@ -375,6 +474,13 @@ void App::setup_keybinds() {
             if (ctrl && keyval == GDK_KEY_w)      { a->on_close_tab();  return TRUE; }
             if (keyval == GDK_KEY_F5)             { a->on_inject();     return TRUE; }
             if (keyval == GDK_KEY_F12)            { a->on_toggle_console(); return TRUE; }
+            if (ctrl && keyval == GDK_KEY_M)      { a->on_toggle_metrics(); return TRUE; }
+            if (ctrl && keyval == GDK_KEY_T) {
+                // Through the toggle button so its pressed state stays in sync
+                gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(a->tasks_toggle_),
+                                             !a->tasks_visible_);
+                return TRUE;
+            }
             if (ctrl && keyval == GDK_KEY_z)      { a->editor_->undo(); return TRUE; }
             if (ctrl && keyval == GDK_KEY_y)      { a->editor_->redo(); return TRUE; }
             return FALSE;
@@ -383,7 +489,7 @@ void App::setup_keybinds() {
 }
 
 void App::on_execute() {
-    if (!Executor::instance().is_initialized()) {
+    if (!ensure_executor()) {
         console_->print("✗ Executor is not initialized", Console::Level::Error);
         return;
     }
@@ -391,7 +497,32 @@ void App::on_execute() {
     if (script.empty()) return;
 
     console_->print("▶ Executing script...", Console::Level::System);
-    Executor::instance().execute_script(script);
+
+    auto on_stage = [this](ExecutionStage stage) {
+        if (stage == ExecutionStage::Done) return;
+        std::string text = std::string("Execution: ") + execution_stage_name(stage) + "...";
+        run_on_ui([this, text] {
+            if (status_label_) gtk_label_set_text(GTK_LABEL(status_label_), text.c_str());
+        });
+    };
+
+    auto on_done = [this](const ExecutionResult& result) {
+        bool ok = result.success;
+        double ms = result.execution_time_ms;
+        bool cancelled = result.cancelled;
+        run_on_ui([this, ok, ms, cancelled] {
+            if (!console_) return;
+            if (ok) {
+                char buf[64];
+                std::snprintf(buf, sizeof(buf), "✓ Finished in %.1f ms", ms);
+                console_->print(buf, Console::Level::Info);
+            } else if (cancelled) {
+                console_->print("Skipped cancelled script", Console::Level::Warn);
+            }
+        });
+    };
+
+    Executor::instance().submit(script, "user_script", on_stage, on_done);
 }
 
 void App::on_clear() {
@@ -400,21 +531,60 @@ void App::on_clear() {
 
 void App::on_open_file() {
     FileDialog::open(window_, [this](const std::string& path) {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            console_->print("Failed to open: " + path, Console::Level::Error);
-            return;
-        }
-        std::string content((std::istreambuf_iterator<char>(file)),
-                             std::istreambuf_iterator<char>());
         std::string name = std::filesystem::path(path).filename().string();
 
-        int id = tabs_->add_tab(name, content);
+        int id = tabs_->add_tab(name);
         tabs_->set_active(id);
         auto* tab = tabs_->get_tab(id);
         if (tab) tab->file_path = path;
+        editor_->begin_stream();
+
+        auto content = std::make_shared<std::string>();
+        FileDialog::ReadHandlers handlers;
+
+        handlers.on_chunk = [this, id, content](const char* data, size_t len) {
+            content->append(data, len);
+            if (tabs_->active_id() != id) return;
+            // Tab was switched away and back mid-load: restart from what we have
+            if (!editor_->is_streaming()) {
+                editor_->begin_stream();
+                editor_->append_stream(content->data(), content->size());
+            } else {
+                editor_->append_stream(data, len);
+            }
+        };
+
+        handlers.on_progress = [this](size_t read, size_t total) {
+            if (total < LARGE_FILE_BYTES) return;
+            gtk_widget_set_visible(load_progress_, TRUE);
+            gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(load_progress_),
+                static_cast<double>(read) / static_cast<double>(total));
+        };
+
+        handlers.on_done = [this, id, name, content](bool ok, const std::string& error) {
+            gtk_widget_set_visible(load_progress_, FALSE);
+            bool active = tabs_->active_id() == id;
+            auto* t = tabs_->get_tab(id);
+
+            if (!ok) {
+                if (active) editor_->end_stream();
+                console_->print("Failed to open: " + name + " (" + error + ")",
+                                Console::Level::Error);
+                return;
+            }
+            if (!t) return;  // tab closed while loading
 
-        console_->print("Opened: " + name, Console::Level::Info);
+            if (active) {
+                // Not streaming means the tab was re-selected after the last chunk
+                if (editor_->is_streaming()) editor_->end_stream();
+                else editor_->set_text(*content);
+            }
+            t->content = std::move(*content);
+            tabs_->set_tab_modified(id, false);
+            console_->print("Opened: " + name, Console::Level::Info);
+        };
+
+        FileDialog::read_async(path, std::move(handlers));
     });
 }
 
@@ -423,32 +593,32 @@ void App::on_save_file() {
     if (!tab) return;
 
     tab->content = editor_->get_text();
+    int tab_id = tab->id;
+
+    auto on_written = [this, tab_id](const std::string& path) {
+        return [this, tab_id, path](bool ok, const std::string& error) {
+            if (ok) {
+                console_->print("Saved: " + path, Console::Level::Info);
+            } else {
+                // Cleared optimistically when the save was queued
+                tabs_->set_tab_modified(tab_id, true);
+                console_->print("Failed to save: " + path + " (" + error + ")",
+                                Console::Level::Error);
+            }
+        };
+    };
 
     if (!tab->file_path.empty()) {
-        std::ofstream file(tab->file_path);
-        if (file.is_open()) {
-            file << tab->content;
-            tabs_->set_tab_modified(tab->id, false);
-            console_->print("Saved: " + tab->file_path, Console::Level::Info);
-        } else {
-            console_->print("Failed to save: " + tab->file_path, Console::Level::Error);
-        }
+        tabs_->set_tab_modified(tab_id, false);
+        FileDialog::write_async(tab->file_path, tab->content, on_written(tab->file_path));
         return;
     }
 
-    int tab_id            = tab->id;
     std::string suggested = tab->title + ".lua";
     std::string content   = tab->content;
 
     FileDialog::save(window_, suggested,
-        [this, tab_id, content](const std::string& path) {
-            std::ofstream file(path);
-            if (!file.is_open()) {
-                console_->print("Failed to save: " + path, Console::Level::Error);
-                return;
-            }
-            file << content;
-
+        [this, tab_id, content, on_written](const std::string& path) {
             auto* t = tabs_->get_tab(tab_id);
             if (t) {
                 t->file_path = path;
@@ -456,7 +626,7 @@ void App::on_save_file() {
                 tabs_->set_tab_modified(tab_id, false);
                 tabs_->set_tab_title(tab_id, t->title);
             }
-            console_->print("Saved: " + path, Console::Level::Info);
+            FileDialog::write_async(path, content, on_written(path));
         });
 }
 
@@ -465,7 +635,7 @@ void App::on_inject() {
         console_->print("⚠ Injection already in progress", Console::Level::Warn);
         return;
     }
-    if (!Executor::instance().is_initialized()) {
+    if (!ensure_executor()) {
         console_->print("✗ Executor not initialized — cannot inject", Console::Level::Error);
         return;
     }
@@ -529,13 +699,89 @@ void App::on_toggle_console() {
     gtk_revealer_set_reveal_child(GTK_REVEALER(console_revealer_), console_visible_);
 }
 
+void App::on_first_frame() {
+    auto& trace = Trace::instance();
+    double tti = trace.since_start_ms();
+    trace.set_tti_ms(tti);
+    trace.mark("first_frame");
+    LOG_INFO("Interactive after {:.1f}ms", tti);
+
+    if (trace.enabled()) {
+        trace.dump();
+        // A TTI budget run only measures startup
+        if (trace.tti_budget_ms() > 0) {
+            g_application_quit(G_APPLICATION(gtk_app_));
+            return;
+        }
+    }
+
+    // Non-critical subsystems come up once the window is interactive. The
+    // overlay goes first so scripts started by the executor find a renderer
+    // draining their GUI commands.
+    g_idle_add([](gpointer) -> gboolean {
+        TRACE_SPAN("overlay_init");
+        Overlay::instance().init();
+        return G_SOURCE_REMOVE;
+    }, nullptr);
+    g_idle_add([](gpointer data) -> gboolean {
+        static_cast<App*>(data)->ensure_executor();
+        return G_SOURCE_REMOVE;
+    }, this);
+
+    // The autoexec warm-up itself runs on background threads
+    if (kAutoexecOnStart.get()) {
+        g_idle_add([](gpointer) -> gboolean {
+            Executor::instance().auto_execute();
+            return G_SOURCE_REMOVE;
+        }, nullptr);
+    }
+}
+
+// The Lua VM comes up after the first frame; an execute or inject before
+// then brings it up on the spot. A failed init is retried on the next call.
+bool App::ensure_executor() {
+    auto& exec = Executor::instance();
+    if (exec.is_initialized()) return true;
+
+    {
+        TRACE_SPAN("executor_init");
+        exec.init();
+    }
+    if (!exec.is_initialized()) {
+        LOG_ERROR("Executor failed to initialize — execution will be unavailable");
+        if (console_) console_->print("⚠ Executor offline — check logs", Console::Level::Warn);
+        return false;
+    }
+
+    if (console_) console_->print("Ready. Press Ctrl+Enter to execute.", Console::Level::Info);
+    return true;
+}
+
+bool App::ensure_script_hub() {
+    if (script_hub_) return false;
+    TRACE_SPAN("script_hub_init");
+
+    script_hub_ = std::make_unique<ScriptHub>();
+    gtk_revealer_set_child(GTK_REVEALER(hub_revealer_), script_hub_->widget());
+    script_hub_->set_load_callback([this](const std::string& script) {
+        int id = tabs_->add_tab("Hub Script");
+        tabs_->set_active(id);
+        editor_->set_text(script);
+        console_->print("Script loaded from hub", Console::Level::System);
+    });
+    return true;
+}
+
 void App::on_toggle_hub() {
     hub_visible_ = !hub_visible_;
+    // A freshly built hub is already loading trending scripts
+    bool created = hub_visible_ && ensure_script_hub();
     gtk_revealer_set_reveal_child(GTK_REVEALER(hub_revealer_), hub_visible_);
-    if (hub_visible_) script_hub_->refresh();
+    if (hub_visible_ && !created) script_hub_->refresh();
 }
 
 void App::on_toggle_overlay() {
+    Overlay::instance().init();
     Overlay::instance().toggle();
 }
 
@@ -545,6 +791,62 @@ void App::update_status_bar() {
     int col  = editor_->get_cursor_column();
     std::string pos = "Ln " + std::to_string(line) + ", Col " + std::to_string(col);
     gtk_label_set_text(GTK_LABEL(position_label_), pos.c_str());
+
+    // Ticks are 500ms apart; the textfile is refreshed every 5s
+    const std::string& textfile = kMetricsTextfile.get();
+    if (!textfile.empty() && ++tick_count_ % 10 == 0)
+        Metrics::instance().write_textfile(textfile);
+    if (metrics_visible_) update_metrics_panel();
+    if (tasks_visible_) task_panel_->refresh();
+}
+
+void App::on_toggle_tasks() {
+    tasks_visible_ = !tasks_visible_;
+    if (tasks_visible_ && !task_panel_) {
+        task_panel_ = std::make_unique<TaskPanel>();
+        gtk_revealer_set_child(GTK_REVEALER(tasks_revealer_), task_panel_->widget());
+    }
+    // Hidden outright when closed so the collapsed revealer takes no space
+    gtk_widget_set_visible(tasks_revealer_, tasks_visible_);
+    gtk_revealer_set_reveal_child(GTK_REVEALER(tasks_revealer_), tasks_visible_);
+    if (tasks_visible_) task_panel_->refresh();
+}
+
+void App::on_toggle_metrics() {
+    metrics_visible_ = !metrics_visible_;
+    gtk_widget_set_visible(metrics_label_, metrics_visible_);
+    last_metrics_us_ = 0;
+    if (metrics_visible_) update_metrics_panel();
+}
+
+void App::update_metrics_panel() {
+    auto& m = Metrics::instance();
+    auto p_ms = [&](const char* name, double p) {
+        const Histogram* h = m.find_histogram(name);
+        return h ? static_cast<double>(h->percentile(p)) / 1000.0 : 0.0;
+    };
+
+    double scanned = m.value("oss_memory_scanned_bytes_total");
+    gint64 now = g_get_monotonic_time();
+    double scan_mbps = 0;
+    if (last_metrics_us_ > 0 && now > last_metrics_us_)
+        scan_mbps = (scanned - last_scanned_bytes_) / (1024.0 * 1024.0) /
+                    (static_cast<double>(now - last_metrics_us_) / 1e6);
+    last_scanned_bytes_ = scanned;
+    last_metrics_us_ = now;
+
+    char buf[256];
+    std::snprintf(buf, sizeof(buf),
+        "q %.0f · compile p50 %.2fms · ipc p99 %.1fms · frame p99 %.2fms · "
+        "heap %.1fMB · tasks %.0f · scan %.1fMB/s",
+        m.value("oss_executor_queue_depth"),
+        p_ms("oss_compile_time_us", 0.50),
+        p_ms("oss_ipc_latency_us", 0.99),
+        p_ms("oss_overlay_frame_time_us", 0.99),
+        m.value("oss_lua_heap_bytes") / (1024.0 * 1024.0),
+        m.value("oss_lua_pending_tasks"),
+        scan_mbps);
+    gtk_label_set_text(GTK_LABEL(metrics_label_), buf);
 }
 
 gboolean App::on_tick(gpointer data) {
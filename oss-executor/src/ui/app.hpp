@@ -9,9 +9,11 @@
 #include "tabs.hpp"
 #include "theme.hpp"
 #include "file_dialog.hpp"
+#include "task_panel.hpp"
 #include "scripting/script_hub.hpp"
 #include "scripting/script_manager.hpp"
 #include "core/executor.hpp"
+#include "utils/config.hpp"
 
 #ifndef APP_VERSION
 #define APP_VERSION "2.0.0"
@@ -32,9 +34,13 @@ public:
 private:
     void build_ui(GtkApplication* app);
     void apply_theme();
+    void watch_files(const std::string& home);
     void setup_keybinds();
     void connect_executor();
     void disconnect_executor();
+    void on_first_frame();
+    bool ensure_executor();
+    bool ensure_script_hub();
 
     void on_execute();
     void on_clear();
@@ -47,7 +53,10 @@ private:
     void on_toggle_console();
     void on_toggle_hub();
     void on_toggle_overlay();
+    void on_toggle_metrics();
+    void on_toggle_tasks();
     void update_status_bar();
+    void update_metrics_panel();
 
     static gboolean on_tick(gpointer data);
 
@@ -62,19 +71,39 @@ private:
     GtkWidget* sidebar_paned_ = nullptr;
     GtkWidget* console_revealer_ = nullptr;
     GtkWidget* hub_revealer_ = nullptr;
+    GtkWidget* tasks_revealer_ = nullptr;
+    GtkWidget* tasks_toggle_ = nullptr;
     GtkWidget* status_bar_ = nullptr;
     GtkWidget* status_label_ = nullptr;
     GtkWidget* position_label_ = nullptr;
+    GtkWidget* load_progress_ = nullptr;
+    GtkWidget* metrics_label_ = nullptr;
 
     std::unique_ptr<Editor> editor_;
     std::unique_ptr<Console> console_;
     std::unique_ptr<TabManager> tabs_;
     std::unique_ptr<ScriptHub> script_hub_;
+    std::unique_ptr<TaskPanel> task_panel_;
 
     bool console_visible_ = true;
     bool hub_visible_ = false;
+    bool metrics_visible_ = false;
+    bool tasks_visible_ = false;
     bool injecting_ = false;  // guard against concurrent inject calls
     guint tick_id_ = 0;       // tracked so we can g_source_remove in dtor
+    gulong first_frame_handler_ = 0;
+
+    // Debug panel state: scan throughput is derived between ticks
+    unsigned tick_count_ = 0;
+    double   last_scanned_bytes_ = 0;
+    gint64   last_metrics_us_ = 0;
+
+    // Theme CSS lives in one provider that is reloaded in place
+    GtkCssProvider* theme_provider_ = nullptr;
+    uint64_t        applied_css_generation_ = 0;
+    int             theme_watch_ = -1;
+
+    std::vector<Config::Subscription> config_subs_;
 };
 
 } // namespace oss
@@ -2,12 +2,15 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <memory>
 #include <cairo.h>
 
 namespace oss {
 
 struct DrawingObject {
-    enum class Type { Line, Text, Circle, Square, Triangle, Quad, Image };
+    enum class Type { Line, Text, Circle, Square, Triangle, Quad, Image,
+                      LineList, Polyline, PointCloud, RectList };
 
     int id = 0;
     Type type = Type::Line;
@@ -45,6 +48,12 @@ struct DrawingObject {
     std::string image_path;
     cairo_surface_t* image_surface = nullptr;
     double image_w = 0, image_h = 0;
+
+    // Flat coordinate data for the batch types, shared so per-frame snapshots
+    // don't copy it. LineList: x1,y1,x2,y2 per segment. Polyline/PointCloud:
+    // x,y per vertex. RectList: x,y,w,h per rect.
+    std::shared_ptr<const std::vector<float>> points;
+    bool closed = false;
 };
 
 } // namespace oss
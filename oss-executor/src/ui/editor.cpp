@@ -46,7 +46,7 @@ Editor::Editor() {
             static_cast<Editor*>(data)->on_text_changed();
         }), this);
     
-    g_signal_connect(buffer_, "insert-text",
+    insert_handler_id_ = g_signal_connect(buffer_, "insert-text",
         G_CALLBACK(+[](GtkTextBuffer* buf, GtkTextIter* loc, 
                        const char* text, int len, gpointer data) {
             (void)len;
@@ -56,9 +56,9 @@ Editor::Editor() {
     gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroll_), GTK_WIDGET(text_view_));
     gtk_box_append(GTK_BOX(container_), scroll_);
     
-    auto& config = Config::instance();
-    set_font(config.get<std::string>("editor.font_family", "JetBrains Mono"),
-             config.get<int>("editor.font_size", 14));
+    static const auto kFontFamily = Config::key<std::string>("editor.font_family", "JetBrains Mono");
+    static const auto kFontSize   = Config::key<int>("editor.font_size", 14);
+    set_font(kFontFamily.get(), kFontSize.get());
 }
 
 Editor::~Editor() {}
@@ -93,7 +93,7 @@ void Editor::setup_highlighting() {
 }
 
 void Editor::apply_highlighting() {
-    if (highlighting_) return;
+    if (highlighting_ || streaming_) return;
     highlighting_ = true;
     
     GtkTextIter start, end;
@@ -292,6 +292,7 @@ void Editor::handle_auto_indent(GtkTextBuffer* buffer, GtkTextIter* location, co
 }
 
 void Editor::set_text(const std::string& text) {
+    stop_stream();
     g_signal_handler_block(buffer_, changed_handler_id_);
     gtk_text_buffer_set_text(buffer_, text.c_str(), -1);
     g_signal_handler_unblock(buffer_, changed_handler_id_);
@@ -315,6 +316,39 @@ void Editor::insert_text(const std::string& text) {
     gtk_text_buffer_insert_at_cursor(buffer_, text.c_str(), -1);
 }
 
+void Editor::begin_stream() {
+    if (!streaming_) {
+        g_signal_handler_block(buffer_, changed_handler_id_);
+        g_signal_handler_block(buffer_, insert_handler_id_);
+        gtk_text_buffer_begin_irreversible_action(buffer_);
+        gtk_text_view_set_editable(text_view_, FALSE);
+        streaming_ = true;
+    }
+    gtk_text_buffer_set_text(buffer_, "", 0);
+}
+
+void Editor::append_stream(const char* data, size_t len) {
+    if (!streaming_) return;
+    GtkTextIter end;
+    gtk_text_buffer_get_end_iter(buffer_, &end);
+    gtk_text_buffer_insert(buffer_, &end, data, static_cast<int>(len));
+}
+
+void Editor::end_stream() {
+    if (!streaming_) return;
+    stop_stream();
+    on_text_changed();
+}
+
+void Editor::stop_stream() {
+    if (!streaming_) return;
+    streaming_ = false;
+    gtk_text_view_set_editable(text_view_, TRUE);
+    gtk_text_buffer_end_irreversible_action(buffer_);
+    g_signal_handler_unblock(buffer_, insert_handler_id_);
+    g_signal_handler_unblock(buffer_, changed_handler_id_);
+}
+
 void Editor::set_font(const std::string& family, int size) {
     std::string css = "textview { font-family: \"" + family + "\"; font-size: " + 
                       std::to_string(size) + "px; }";
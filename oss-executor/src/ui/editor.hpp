@@ -22,8 +22,17 @@ public:
     
     void clear();
     void insert_text(const std::string& text);
+
+    // Chunked loading for large files: the buffer is read-only and
+    // highlighting/line numbers are deferred until end_stream().
+    void begin_stream();
+    void append_stream(const char* data, size_t len);
+    void end_stream();
+    bool is_streaming() const { return streaming_; }
     
     void set_font(const std::string& family, int size);
+    // Re-tags the whole buffer now instead of on the debounce timer
+    void rehighlight() { apply_highlighting(); }
     void set_modified_callback(ModifiedCallback cb) { modified_cb_ = std::move(cb); }
     
     void undo();
@@ -38,6 +47,7 @@ private:
     void apply_highlighting();
     void on_text_changed();
     void handle_auto_indent(GtkTextBuffer* buffer, GtkTextIter* location, const char* text);
+    void stop_stream();
 
     GtkWidget* container_;
     GtkWidget* scroll_;
@@ -47,6 +57,7 @@ private:
     
     ModifiedCallback modified_cb_;
     bool highlighting_ = false;
+    bool streaming_ = false;
     
     struct HighlightRule {
         std::string pattern;
@@ -55,6 +66,7 @@ private:
     std::vector<HighlightRule> rules_;
     
     gulong changed_handler_id_ = 0;
+    gulong insert_handler_id_ = 0;
 };
 
 } // namespace oss
\ No newline at end of file
@@ -2,6 +2,12 @@
 #include "utils/logger.hpp"
 #include "utils/config.hpp"
 
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+
 namespace oss {
 
 #if GTK_CHECK_VERSION(4, 10, 0)
@@ -164,4 +170,213 @@ void FileDialog::save(GtkWindow* parent, const std::string& suggested_name, Call
 
 #endif
 
+// ── Async read ──
+
+static constexpr gsize READ_CHUNK = 64 * 1024;
+
+struct AsyncReadOp {
+    FileDialog::ReadHandlers handlers;
+    GInputStream* stream = nullptr;
+    size_t total = 0;
+    size_t done  = 0;
+    std::string carry;  // incomplete UTF-8 sequence at the end of the last chunk
+};
+
+static void finish_read(AsyncReadOp* op, bool ok, const std::string& error) {
+    if (op->stream) g_object_unref(op->stream);
+    if (op->handlers.on_done) op->handlers.on_done(ok, error);
+    delete op;
+}
+
+// Bytes at the end of buf that start a valid but unfinished UTF-8 sequence
+static size_t incomplete_utf8_tail(const std::string& buf) {
+    for (size_t back = 1; back <= 3 && back <= buf.size(); back++) {
+        const char* p = buf.data() + buf.size() - back;
+        if ((static_cast<unsigned char>(*p) & 0xC0) == 0x80) continue;  // continuation byte
+        bool partial = g_utf8_get_char_validated(p, static_cast<gssize>(back)) ==
+                       static_cast<gunichar>(-2);
+        return partial ? back : 0;
+    }
+    return 0;
+}
+
+static void emit_chunk(AsyncReadOp* op, const char* data, size_t len, bool last) {
+    std::string buf = std::move(op->carry);
+    op->carry.clear();
+    buf.append(data, len);
+
+    // Hold back a character split across chunks before any repair, so an
+    // invalid byte earlier in the chunk doesn't turn it into U+FFFD
+    if (!last) {
+        size_t tail = incomplete_utf8_tail(buf);
+        op->carry.assign(buf, buf.size() - tail, tail);
+        buf.resize(buf.size() - tail);
+    }
+
+    if (!g_utf8_validate(buf.data(), static_cast<gssize>(buf.size()), nullptr)) {
+        gchar* fixed = g_utf8_make_valid(buf.data(), static_cast<gssize>(buf.size()));
+        buf = fixed;
+        g_free(fixed);
+    }
+    if (!buf.empty() && op->handlers.on_chunk) op->handlers.on_chunk(buf.data(), buf.size());
+}
+
+static void on_read_chunk(GObject* source, GAsyncResult* result, gpointer user_data) {
+    auto* op = static_cast<AsyncReadOp*>(user_data);
+    GError* error = nullptr;
+    GBytes* bytes = g_input_stream_read_bytes_finish(G_INPUT_STREAM(source), result, &error);
+    if (!bytes) {
+        std::string msg = error ? error->message : "read failed";
+        g_clear_error(&error);
+        finish_read(op, false, msg);
+        return;
+    }
+
+    gsize len = 0;
+    const char* data = static_cast<const char*>(g_bytes_get_data(bytes, &len));
+    if (len == 0) {
+        g_bytes_unref(bytes);
+        emit_chunk(op, "", 0, true);
+        finish_read(op, true, "");
+        return;
+    }
+
+    op->done += len;
+    emit_chunk(op, data, len, false);
+    g_bytes_unref(bytes);
+    if (op->handlers.on_progress)
+        op->handlers.on_progress(op->done, std::max(op->total, op->done));
+
+    // Low priority so input and redraws get serviced between chunks
+    g_input_stream_read_bytes_async(op->stream, READ_CHUNK, G_PRIORITY_LOW,
+                                    nullptr, on_read_chunk, op);
+}
+
+static void on_file_opened(GObject* source, GAsyncResult* result, gpointer user_data) {
+    auto* op = static_cast<AsyncReadOp*>(user_data);
+    GError* error = nullptr;
+    GFileInputStream* in = g_file_read_finish(G_FILE(source), result, &error);
+    if (!in) {
+        std::string msg = error ? error->message : "open failed";
+        g_clear_error(&error);
+        finish_read(op, false, msg);
+        return;
+    }
+    op->stream = G_INPUT_STREAM(in);
+
+    GFileInfo* info = g_file_input_stream_query_info(in, G_FILE_ATTRIBUTE_STANDARD_SIZE,
+                                                     nullptr, nullptr);
+    if (info) {
+        op->total = static_cast<size_t>(g_file_info_get_size(info));
+        g_object_unref(info);
+    }
+
+    g_input_stream_read_bytes_async(op->stream, READ_CHUNK, G_PRIORITY_LOW,
+                                    nullptr, on_read_chunk, op);
+}
+
+void FileDialog::read_async(const std::string& path, ReadHandlers handlers) {
+    auto* op = new AsyncReadOp;
+    op->handlers = std::move(handlers);
+    GFile* file = g_file_new_for_path(path.c_str());
+    g_file_read_async(file, G_PRIORITY_LOW, nullptr, on_file_opened, op);
+    g_object_unref(file);
+}
+
+// ── Async atomic write ──
+
+struct AsyncWriteJob {
+    std::string path;
+    std::string content;
+    FileDialog::WriteCallback done;
+    unsigned generation = 0;
+    bool ok = false;
+    std::string error;
+};
+
+static bool write_atomic(const std::string& path, const std::string& content, std::string& error) {
+    std::vector<char> tmp(path.begin(), path.end());
+    const char suffix[] = ".XXXXXX";
+    tmp.insert(tmp.end(), suffix, suffix + sizeof(suffix));
+
+    int fd = g_mkstemp(tmp.data());
+    if (fd < 0) {
+        error = std::string("cannot create temp file: ") + g_strerror(errno);
+        return false;
+    }
+
+    // mkstemp creates 0600; keep the original file's mode if there is one
+    struct stat st;
+    fchmod(fd, stat(path.c_str(), &st) == 0 ? (st.st_mode & 07777) : 0644);
+
+    const char* p = content.data();
+    size_t left = content.size();
+    while (left > 0) {
+        ssize_t n = write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = std::string("write failed: ") + g_strerror(errno);
+            close(fd);
+            unlink(tmp.data());
+            return false;
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+
+    if (fsync(fd) != 0) {
+        error = std::string("fsync failed: ") + g_strerror(errno);
+        close(fd);
+        unlink(tmp.data());
+        return false;
+    }
+    close(fd);
+
+    if (rename(tmp.data(), path.c_str()) != 0) {
+        error = std::string("rename failed: ") + g_strerror(errno);
+        unlink(tmp.data());
+        return false;
+    }
+    return true;
+}
+
+// Both touched on the GTK thread only. flush_writes() bumps the generation,
+// so completions queued before it are not delivered.
+static GThreadPool* s_write_pool       = nullptr;
+static unsigned     s_write_generation = 0;
+
+static void write_worker(gpointer data, gpointer) {
+    auto* job = static_cast<AsyncWriteJob*>(data);
+    job->ok = write_atomic(job->path, job->content, job->error);
+    if (!job->ok) LOG_ERROR("Save '{}' failed: {}", job->path, job->error);
+
+    g_idle_add([](gpointer d) -> gboolean {
+        auto* j = static_cast<AsyncWriteJob*>(d);
+        // After flush_writes() the owner of the callback may be gone
+        if (j->done && j->generation == s_write_generation) j->done(j->ok, j->error);
+        delete j;
+        return G_SOURCE_REMOVE;
+    }, job);
+}
+
+void FileDialog::write_async(const std::string& path, std::string content, WriteCallback done) {
+    // A single worker keeps saves in order, so an older save can never land last.
+    if (!s_write_pool)
+        s_write_pool = g_thread_pool_new(write_worker, nullptr, 1, FALSE, nullptr);
+
+    auto* job = new AsyncWriteJob;
+    job->path = path;
+    job->content = std::move(content);
+    job->done = std::move(done);
+    job->generation = s_write_generation;
+    g_thread_pool_push(s_write_pool, job, nullptr);
+}
+
+void FileDialog::flush_writes() {
+    if (!s_write_pool) return;
+    g_thread_pool_free(s_write_pool, FALSE, TRUE);
+    s_write_pool = nullptr;
+    s_write_generation++;
+}
+
 } // namespace oss
@@ -12,6 +12,21 @@ public:
 
     static void open(GtkWindow* parent, Callback cb);
     static void save(GtkWindow* parent, const std::string& suggested_name, Callback cb);
+
+    // ── Async file I/O (all callbacks run on the GTK main loop) ──
+    struct ReadHandlers {
+        std::function<void(const char* data, size_t len)> on_chunk;   // always valid UTF-8
+        std::function<void(size_t read, size_t total)> on_progress;
+        std::function<void(bool ok, const std::string& error)> on_done;
+    };
+    using WriteCallback = std::function<void(bool ok, const std::string& error)>;
+
+    static void read_async(const std::string& path, ReadHandlers handlers);
+    // Writes to a temp file, fsyncs and renames over path on a worker thread.
+    static void write_async(const std::string& path, std::string content, WriteCallback done);
+    // Blocks until every queued write has hit the disk. Completion callbacks
+    // still pending on the main loop are dropped; call before their owner goes.
+    static void flush_writes();
 };
 
 } // namespace oss
\ No newline at end of file
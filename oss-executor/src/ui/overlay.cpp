@@ -1,4 +1,8 @@
 #include "overlay.hpp"
+#include "utils/metrics.hpp"
+#include "utils/logger.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
 #include <cmath>
 #include <algorithm>
 #include <cstring>
@@ -70,6 +74,11 @@ void Overlay::init() {
             static_cast<Overlay*>(data)->setup_passthrough();
         }), this);
 
+    // Commands queued before the overlay existed (autoexec, early scripts)
+    // are applied now rather than waiting for the first tick, which frees the
+    // spill before it can fill up
+    drain_gui_commands();
+
     tick_id_ = g_timeout_add(16, tick_callback, this);
     initialized_ = true;
 }
@@ -93,16 +102,9 @@ void Overlay::shutdown() {
         }
         objects_.clear();
     }
-    {
-        std::lock_guard<std::mutex> lock(gui_mutex_);
-        for (auto& [id, elem] : gui_elements_) {
-            if (elem.image_surface) {
-                cairo_surface_destroy(elem.image_surface);
-                elem.image_surface = nullptr;
-            }
-        }
-        gui_elements_.clear();
-    }
+    drain_gui_commands();
+    apply_gui_clear();
+    gui_count_.store(0, std::memory_order_release);
     if (window_) { gtk_window_destroy(window_); window_ = nullptr; }
     drawing_area_ = nullptr;
     initialized_ = false;
@@ -204,8 +206,189 @@ std::vector<DrawingObject> Overlay::snapshot_objects() const {
 }
 
 int Overlay::create_gui_element(const std::string& class_name, const std::string& name) {
-    std::lock_guard<std::mutex> lock(gui_mutex_);
-    int id = gui_next_id_++;
+    int id = gui_next_id_.fetch_add(1, std::memory_order_relaxed);
+    GuiCommand cmd;
+    cmd.op = GuiCommand::Op::Create;
+    cmd.id = id;
+    cmd.s  = class_name;
+    cmd.s2 = name;
+    push_gui_command(std::move(cmd));
+    return id;
+}
+
+int Overlay::clone_gui_element(int src_id, const std::string& class_name, const std::string& name) {
+    int id = gui_next_id_.fetch_add(1, std::memory_order_relaxed);
+    GuiCommand cmd;
+    cmd.op  = GuiCommand::Op::Clone;
+    cmd.id  = id;
+    cmd.arg = src_id;
+    cmd.s   = class_name;
+    cmd.s2  = name;
+    push_gui_command(std::move(cmd));
+    return id;
+}
+
+std::vector<int> Overlay::clone_gui_tree(const std::vector<int>& src_ids) {
+    std::vector<int> out;
+    if (src_ids.empty()) return out;
+    int first = gui_next_id_.fetch_add(static_cast<int>(src_ids.size()), std::memory_order_relaxed);
+
+    GuiCommand cmd;
+    cmd.op = GuiCommand::Op::CloneTree;
+    cmd.ids.reserve(src_ids.size() * 2);
+    out.reserve(src_ids.size());
+    for (size_t i = 0; i < src_ids.size(); i++) {
+        out.push_back(first + static_cast<int>(i));
+        cmd.ids.push_back(src_ids[i]);
+        cmd.ids.push_back(out.back());
+    }
+    push_gui_command(std::move(cmd));
+    return out;
+}
+
+void Overlay::remove_gui_element(int id) {
+    GuiCommand cmd;
+    cmd.op = GuiCommand::Op::Remove;
+    cmd.id = id;
+    push_gui_command(std::move(cmd));
+}
+
+void Overlay::clear_gui_elements() {
+    GuiCommand cmd;
+    cmd.op = GuiCommand::Op::Clear;
+    push_gui_command(std::move(cmd));
+}
+
+void Overlay::set_gui_parent(int child_id, int parent_id) {
+    GuiCommand cmd;
+    cmd.op  = GuiCommand::Op::SetParent;
+    cmd.id  = child_id;
+    cmd.arg = parent_id;
+    push_gui_command(std::move(cmd));
+}
+
+void Overlay::push_gui_command(GuiCommand&& cmd) {
+    // Every engine and actor VM may produce, so producers take turns on the
+    // ring under a mutex that parks rather than spins when contended. The
+    // renderer never takes it and drains without locking.
+    bool pushed;
+    {
+        std::lock_guard<std::mutex> lock(gui_push_mutex_);
+        pushed = !gui_spilled_.load(std::memory_order_acquire) && gui_queue_.try_push(cmd);
+    }
+    if (pushed) {
+        dirty_.store(true, std::memory_order_release);
+        return;
+    }
+    // Ring full: keep FIFO order by routing everything through the spill
+    // list until the renderer has caught up.
+    static Counter& dropped = Metrics::instance().counter(
+        "oss_gui_commands_dropped_total", "GUI commands dropped with no renderer draining them");
+    std::lock_guard<std::mutex> lock(gui_spill_mutex_);
+    if (gui_spill_.size() >= GUI_SPILL_CAPACITY) {
+        dropped.add();
+        LOG_WARN_EVERY(5000, "GUI command queue full ({} pending) with nothing "
+                       "draining it; dropping GUI updates",
+                       gui_spill_.size() + GUI_QUEUE_CAPACITY);
+        return;
+    }
+    gui_spill_.push_back(std::move(cmd));
+    gui_spilled_.store(true, std::memory_order_release);
+    dirty_.store(true, std::memory_order_release);
+}
+
+void Overlay::drain_gui_commands() {
+    auto apply = [this](GuiCommand& c) { apply_gui_command(c); };
+    size_t n = gui_queue_.drain(apply);
+
+    if (gui_spilled_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(gui_spill_mutex_);
+        n += gui_queue_.drain(apply);
+        for (auto& c : gui_spill_) apply_gui_command(c);
+        n += gui_spill_.size();
+        gui_spill_.clear();
+        gui_spilled_.store(false, std::memory_order_release);
+    }
+
+    if (n > 0) {
+        gui_count_.store(static_cast<int>(gui_elements_.size()), std::memory_order_release);
+        gui_dirty_.store(true, std::memory_order_release);
+        dirty_.store(true, std::memory_order_release);
+    }
+}
+
+void Overlay::apply_gui_command(GuiCommand& cmd) {
+    switch (cmd.op) {
+        case GuiCommand::Op::Create:
+            apply_gui_create(cmd.id, cmd.s, cmd.s2);
+            break;
+        case GuiCommand::Op::Set: {
+            auto it = gui_elements_.find(cmd.id);
+            if (it != gui_elements_.end() && cmd.set) cmd.set(it->second, cmd);
+            break;
+        }
+        case GuiCommand::Op::Update: {
+            auto it = gui_elements_.find(cmd.id);
+            if (it != gui_elements_.end() && cmd.fn) cmd.fn(it->second);
+            break;
+        }
+        case GuiCommand::Op::SetParent:
+            apply_gui_parent(cmd.id, cmd.arg);
+            break;
+        case GuiCommand::Op::Remove:
+            apply_gui_remove(cmd.id);
+            break;
+        case GuiCommand::Op::Clear:
+            apply_gui_clear();
+            break;
+        case GuiCommand::Op::Clone: {
+            auto src = gui_elements_.find(cmd.arg);
+            if (src == gui_elements_.end()) {
+                apply_gui_create(cmd.id, cmd.s, cmd.s2);
+                break;
+            }
+            GuiElement copy = src->second;
+            copy.id = cmd.id;
+            copy.parent_id = -1;
+            copy.children_ids.clear();
+            gui_elements_[cmd.id] = std::move(copy);
+            break;
+        }
+        case GuiCommand::Op::CloneTree:
+            apply_gui_clone_tree(cmd.ids);
+            break;
+    }
+}
+
+// Copies share every style block with their source; only the tree links are
+// rebuilt. The root comes out unparented, like a single Clone.
+void Overlay::apply_gui_clone_tree(const std::vector<int>& ids) {
+    std::unordered_map<int, int> remap;
+    remap.reserve(ids.size() / 2);
+
+    for (size_t i = 0; i + 1 < ids.size(); i += 2) {
+        int src_id = ids[i], new_id = ids[i + 1];
+        auto src = gui_elements_.find(src_id);
+        if (src == gui_elements_.end()) continue;
+
+        GuiElement copy = src->second;
+        copy.id = new_id;
+        copy.children_ids.clear();
+
+        auto pit = remap.find(copy.parent_id);
+        if (i == 0 || pit == remap.end()) {
+            copy.parent_id = -1;
+        } else {
+            copy.parent_id = pit->second;
+            auto parent = gui_elements_.find(pit->second);
+            if (parent != gui_elements_.end()) parent->second.children_ids.push_back(new_id);
+        }
+        remap[src_id] = new_id;
+        gui_elements_[new_id] = std::move(copy);
+    }
+}
+
+void Overlay::apply_gui_create(int id, const std::string& class_name, const std::string& name) {
     GuiElement elem;
     elem.id = id;
     elem.class_name = class_name;
@@ -229,28 +412,17 @@ int Overlay::create_gui_element(const std::string& class_name, const std::string
         elem.is_image_class = true;
     }
 
+    // Style blocks start out as the shared defaults (white background, black
+    // 14px text), which is what every class wants; writing them here would
+    // only give each element a private copy.
     if (elem.is_gui_object) {
-        elem.bg_r = 1; elem.bg_g = 1; elem.bg_b = 1;
-        elem.bg_transparency = 0;
         elem.size_x_offset = 100; elem.size_y_offset = 100;
     }
-    if (class_name == "Frame") {
-        elem.bg_r = 1; elem.bg_g = 1; elem.bg_b = 1;
-    }
-    if (elem.is_text_class) {
-        elem.text_r = 0; elem.text_g = 0; elem.text_b = 0;
-        elem.text_size = 14;
-        elem.bg_transparency = 0;
-    }
 
     gui_elements_[id] = std::move(elem);
-    gui_dirty_.store(true, std::memory_order_release);
-    dirty_.store(true, std::memory_order_release);
-    return id;
 }
 
-void Overlay::remove_gui_element(int id) {
-    std::lock_guard<std::mutex> lock(gui_mutex_);
+void Overlay::apply_gui_remove(int id) {
     auto it = gui_elements_.find(id);
     if (it == gui_elements_.end()) return;
 
@@ -263,40 +435,23 @@ void Overlay::remove_gui_element(int id) {
     }
 
     std::vector<int> to_remove = it->second.children_ids;
-    if (it->second.image_surface)
-        cairo_surface_destroy(it->second.image_surface);
     gui_elements_.erase(it);
 
-    for (int cid : to_remove) {
-        auto cit = gui_elements_.find(cid);
+    for (size_t i = 0; i < to_remove.size(); i++) {
+        auto cit = gui_elements_.find(to_remove[i]);
         if (cit != gui_elements_.end()) {
-            if (cit->second.image_surface)
-                cairo_surface_destroy(cit->second.image_surface);
             for (int gcid : cit->second.children_ids)
                 to_remove.push_back(gcid);
             gui_elements_.erase(cit);
         }
     }
-
-    gui_dirty_.store(true, std::memory_order_release);
-    dirty_.store(true, std::memory_order_release);
 }
 
-void Overlay::clear_gui_elements() {
-    std::lock_guard<std::mutex> lock(gui_mutex_);
-    for (auto& [id, elem] : gui_elements_) {
-        if (elem.image_surface) {
-            cairo_surface_destroy(elem.image_surface);
-            elem.image_surface = nullptr;
-        }
-    }
+void Overlay::apply_gui_clear() {
     gui_elements_.clear();
-    gui_dirty_.store(true, std::memory_order_release);
-    dirty_.store(true, std::memory_order_release);
 }
 
-void Overlay::set_gui_parent(int child_id, int parent_id) {
-    std::lock_guard<std::mutex> lock(gui_mutex_);
+void Overlay::apply_gui_parent(int child_id, int parent_id) {
     auto cit = gui_elements_.find(child_id);
     if (cit == gui_elements_.end()) return;
 
@@ -316,14 +471,16 @@ void Overlay::set_gui_parent(int child_id, int parent_id) {
             pit->second.children_ids.push_back(child_id);
 
             if (cit->second.class_name == "UICorner") {
-                pit->second.corner_radius = 8;
+                pit->second.style.mut().corner_radius = 8;
             } else if (cit->second.class_name == "UIStroke") {
-                pit->second.has_stroke = true;
-                pit->second.stroke_thickness = cit->second.stroke_thickness;
-                pit->second.stroke_r = cit->second.stroke_r;
-                pit->second.stroke_g = cit->second.stroke_g;
-                pit->second.stroke_b = cit->second.stroke_b;
-                pit->second.stroke_transparency = cit->second.stroke_transparency;
+                const GuiStyle& cs = *cit->second.style;
+                GuiStyle& ps = pit->second.style.mut();
+                ps.has_stroke = true;
+                ps.stroke_thickness = cs.stroke_thickness;
+                ps.stroke_r = cs.stroke_r;
+                ps.stroke_g = cs.stroke_g;
+                ps.stroke_b = cs.stroke_b;
+                ps.stroke_transparency = cs.stroke_transparency;
             } else if (cit->second.class_name == "UIPadding") {
                 pit->second.pad_top = cit->second.pad_top;
                 pit->second.pad_bottom = cit->second.pad_bottom;
@@ -332,14 +489,6 @@ void Overlay::set_gui_parent(int child_id, int parent_id) {
             }
         }
     }
-
-    gui_dirty_.store(true, std::memory_order_release);
-    dirty_.store(true, std::memory_order_release);
-}
-
-int Overlay::gui_element_count() const {
-    std::lock_guard<std::mutex> lock(gui_mutex_);
-    return static_cast<int>(gui_elements_.size());
 }
 
 void Overlay::set_custom_render(RenderCallback cb, void* ud) {
@@ -360,6 +509,7 @@ void Overlay::setup_passthrough() {
 
 gboolean Overlay::tick_callback(gpointer data) {
     auto* self = static_cast<Overlay*>(data);
+    self->drain_gui_commands();
     if (!self->visible_.load(std::memory_order_acquire)) return G_SOURCE_CONTINUE;
 
     self->frame_count_++;
@@ -380,6 +530,12 @@ void Overlay::draw_func(GtkDrawingArea*, cairo_t* cr,
 }
 
 void Overlay::render(cairo_t* cr, int width, int height) {
+    static Histogram& frame_time = Metrics::instance().histogram(
+        "oss_overlay_frame_time_us", "Overlay render time per frame (microseconds)");
+    auto frame_start = std::chrono::steady_clock::now();
+
+    drain_gui_commands();
+
     cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
     cairo_set_source_rgba(cr, 0, 0, 0, 0);
     cairo_paint(cr);
@@ -414,39 +570,199 @@ void Overlay::render(cairo_t* cr, int width, int height) {
             case DrawingObject::Type::Triangle: render_triangle(cr, obj); break;
             case DrawingObject::Type::Quad:     render_quad(cr, obj); break;
             case DrawingObject::Type::Image:    render_image(cr, obj); break;
+            case DrawingObject::Type::LineList:   render_line_list(cr, obj); break;
+            case DrawingObject::Type::Polyline:   render_polyline(cr, obj); break;
+            case DrawingObject::Type::PointCloud: render_point_cloud(cr, obj); break;
+            case DrawingObject::Type::RectList:   render_rect_list(cr, obj); break;
         }
         cairo_restore(cr);
     }
+
+    frame_time.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - frame_start).count()));
 }
 
-void Overlay::render_gui(cairo_t* cr, int width, int height) {
-    std::vector<const GuiElement*> roots;
+cairo_surface_t* Overlay::render_offscreen(int width, int height) {
+    cairo_surface_t* surface =
+        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(surface);
+        return nullptr;
+    }
+    cairo_t* cr = cairo_create(surface);
+    render(cr, width, height);
+    cairo_destroy(cr);
+    cairo_surface_flush(surface);
+    return surface;
+}
+
+bool Overlay::write_png(const std::string& path, int width, int height) {
+    cairo_surface_t* surface = render_offscreen(width, height);
+    if (!surface) return false;
+    bool ok = cairo_surface_write_to_png(surface, path.c_str()) == CAIRO_STATUS_SUCCESS;
+    cairo_surface_destroy(surface);
+    return ok;
+}
+
+// ── Snapshot: drawing objects as JSON, for bench scenes and golden tests ──
+
+std::string Overlay::save_snapshot() const {
+    using nlohmann::json;
+    auto xy = [](double x, double y) { return json::array({x, y}); };
+    auto rgb = [](double r, double g, double b) { return json::array({r, g, b}); };
+
+    json objs = json::array();
     {
-        std::lock_guard<std::mutex> lock(gui_mutex_);
-
-        for (auto& [id, elem] : gui_elements_) {
-            if (elem.is_screen_gui && elem.enabled && elem.visible) {
-                float inset_top = elem.ignore_gui_inset ? 0.0f : 36.0f;
-                resolve_gui_layout(elem, 0, inset_top,
-                    static_cast<float>(width),
-                    static_cast<float>(height) - inset_top);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, o] : objects_) {
+            json j = {
+                {"type", static_cast<int>(o.type)}, {"visible", o.visible},
+                {"z_index", o.z_index},
+                {"pos", xy(o.pos_x, o.pos_y)}, {"from", xy(o.from_x, o.from_y)},
+                {"to", xy(o.to_x, o.to_y)}, {"size", xy(o.size_x, o.size_y)},
+                {"radius", o.radius}, {"thickness", o.thickness},
+                {"transparency", o.transparency}, {"rounding", o.rounding},
+                {"num_sides", o.num_sides}, {"filled", o.filled},
+                {"center", o.center}, {"outline", o.outline},
+                {"color", rgb(o.color_r, o.color_g, o.color_b)},
+                {"outline_color", rgb(o.outline_r, o.outline_g, o.outline_b)},
+                {"tri", json::array({o.pa_x, o.pa_y, o.pb_x, o.pb_y, o.pc_x, o.pc_y})},
+                {"quad", json::array({o.qa_x, o.qa_y, o.qb_x, o.qb_y,
+                                      o.qc_x, o.qc_y, o.qd_x, o.qd_y})},
+                {"text", o.text}, {"text_size", o.text_size}, {"font", o.font},
+                {"image_path", o.image_path},
+                {"image_size", xy(o.image_w, o.image_h)},
+                {"closed", o.closed},
+            };
+            if (o.points) j["points"] = *o.points;
+            objs.push_back(std::move(j));
+        }
+    }
+    json root = {{"width", screen_w_}, {"height", screen_h_}, {"objects", std::move(objs)}};
+    return root.dump();
+}
+
+// Every object is parsed before the overlay is touched, so a field with the
+// wrong JSON type fails the whole load instead of leaving half a scene
+bool Overlay::load_snapshot(const std::string& json_text) {
+    using nlohmann::json;
+    json root = json::parse(json_text, nullptr, false);
+    if (root.is_discarded() || !root.contains("objects") || !root["objects"].is_array())
+        return false;
+
+    auto rd2 = [](const json& j, const char* k, double& x, double& y) {
+        if (j.contains(k) && j[k].is_array() && j[k].size() >= 2) {
+            x = j[k][0].get<double>(); y = j[k][1].get<double>();
+        }
+    };
+    auto rd3 = [](const json& j, const char* k, double& r, double& g, double& b) {
+        if (j.contains(k) && j[k].is_array() && j[k].size() >= 3) {
+            r = j[k][0].get<double>(); g = j[k][1].get<double>(); b = j[k][2].get<double>();
+        }
+    };
+
+    int width = 0, height = 0;
+    std::vector<DrawingObject> parsed;
+    try {
+        width  = root.value("width", screen_w_);
+        height = root.value("height", screen_h_);
+        parsed.reserve(root["objects"].size());
+
+        for (const auto& j : root["objects"]) {
+            DrawingObject o;
+            o.type         = static_cast<DrawingObject::Type>(j.value("type", 0));
+            o.visible      = j.value("visible", o.visible);
+            o.z_index      = j.value("z_index", o.z_index);
+            rd2(j, "pos", o.pos_x, o.pos_y);
+            rd2(j, "from", o.from_x, o.from_y);
+            rd2(j, "to", o.to_x, o.to_y);
+            rd2(j, "size", o.size_x, o.size_y);
+            o.radius       = j.value("radius", o.radius);
+            o.thickness    = j.value("thickness", o.thickness);
+            o.transparency = j.value("transparency", o.transparency);
+            o.rounding     = j.value("rounding", o.rounding);
+            o.num_sides    = j.value("num_sides", o.num_sides);
+            o.filled       = j.value("filled", o.filled);
+            o.center       = j.value("center", o.center);
+            o.outline      = j.value("outline", o.outline);
+            rd3(j, "color", o.color_r, o.color_g, o.color_b);
+            rd3(j, "outline_color", o.outline_r, o.outline_g, o.outline_b);
+            if (j.contains("tri") && j["tri"].size() >= 6) {
+                const auto& t = j["tri"];
+                o.pa_x = t[0].get<double>(); o.pa_y = t[1].get<double>();
+                o.pb_x = t[2].get<double>(); o.pb_y = t[3].get<double>();
+                o.pc_x = t[4].get<double>(); o.pc_y = t[5].get<double>();
             }
+            if (j.contains("quad") && j["quad"].size() >= 8) {
+                const auto& q = j["quad"];
+                o.qa_x = q[0].get<double>(); o.qa_y = q[1].get<double>();
+                o.qb_x = q[2].get<double>(); o.qb_y = q[3].get<double>();
+                o.qc_x = q[4].get<double>(); o.qc_y = q[5].get<double>();
+                o.qd_x = q[6].get<double>(); o.qd_y = q[7].get<double>();
+            }
+            o.text         = j.value("text", o.text);
+            o.text_size    = j.value("text_size", o.text_size);
+            o.font         = j.value("font", o.font);
+            o.image_path   = j.value("image_path", std::string{});
+            rd2(j, "image_size", o.image_w, o.image_h);
+            o.closed       = j.value("closed", o.closed);
+            if (j.contains("points") && j["points"].is_array())
+                o.points = std::make_shared<const std::vector<float>>(
+                    j["points"].get<std::vector<float>>());
+            parsed.push_back(std::move(o));
         }
+    } catch (const json::exception&) {
+        return false;
+    }
 
-        for (const auto& [id, elem] : gui_elements_) {
-            if (elem.is_screen_gui && elem.enabled && elem.visible)
-                roots.push_back(&elem);
+    screen_w_ = width;
+    screen_h_ = height;
+    clear_objects();
+
+    for (auto& parsed_obj : parsed) {
+        cairo_surface_t* surface = nullptr;
+        if (!parsed_obj.image_path.empty()) {
+            surface = cairo_image_surface_create_from_png(parsed_obj.image_path.c_str());
+            if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+                cairo_surface_destroy(surface);
+                surface = nullptr;
+            }
         }
+        int id = create_object(parsed_obj.type);
+        update_object(id, [&](DrawingObject& o) {
+            parsed_obj.id            = o.id;
+            parsed_obj.image_surface = surface;
+            o = std::move(parsed_obj);
+        });
+    }
+    return true;
+}
 
-        std::sort(roots.begin(), roots.end(),
-            [](const GuiElement* a, const GuiElement* b) {
-                return a->display_order < b->display_order;
-            });
+void Overlay::render_gui(cairo_t* cr, int width, int height) {
+    std::vector<const GuiElement*> roots;
 
-        for (const auto* root : roots) {
-            render_gui_children(cr, *root);
+    for (auto& [id, elem] : gui_elements_) {
+        if (elem.is_screen_gui && elem.enabled && elem.visible) {
+            float inset_top = elem.ignore_gui_inset ? 0.0f : 36.0f;
+            resolve_gui_layout(elem, 0, inset_top,
+                static_cast<float>(width),
+                static_cast<float>(height) - inset_top);
         }
     }
+
+    for (const auto& [id, elem] : gui_elements_) {
+        if (elem.is_screen_gui && elem.enabled && elem.visible)
+            roots.push_back(&elem);
+    }
+
+    std::sort(roots.begin(), roots.end(),
+        [](const GuiElement* a, const GuiElement* b) {
+            return a->display_order < b->display_order;
+        });
+
+    for (const auto* root : roots) {
+        render_gui_children(cr, *root);
+    }
 }
 
 void Overlay::resolve_gui_layout(GuiElement& elem,
@@ -532,13 +848,15 @@ void Overlay::resolve_gui_layout(GuiElement& elem,
 void Overlay::render_gui_element(cairo_t* cr, const GuiElement& elem) {
     if (!elem.visible || !elem.is_gui_object) return;
 
-    float alpha_bg = 1.0f - elem.bg_transparency;
+    const GuiStyle& st = *elem.style;
+    const GuiImageStyle& img = *elem.image_style;
+    float alpha_bg = 1.0f - st.bg_transparency;
 
     cairo_save(cr);
 
     if (elem.clips_descendants) {
-        if (elem.corner_radius > 0) {
-            render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, elem.corner_radius);
+        if (st.corner_radius > 0) {
+            render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, st.corner_radius);
             cairo_clip(cr);
         } else {
             cairo_rectangle(cr, elem.x, elem.y, elem.w, elem.h);
@@ -555,9 +873,9 @@ void Overlay::render_gui_element(cairo_t* cr, const GuiElement& elem) {
     }
 
     if (alpha_bg > 0.001f) {
-        cairo_set_source_rgba(cr, elem.bg_r, elem.bg_g, elem.bg_b, alpha_bg);
-        if (elem.corner_radius > 0) {
-            render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, elem.corner_radius);
+        cairo_set_source_rgba(cr, st.bg_r, st.bg_g, st.bg_b, alpha_bg);
+        if (st.corner_radius > 0) {
+            render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, st.corner_radius);
             cairo_fill(cr);
         } else {
             cairo_rectangle(cr, elem.x, elem.y, elem.w, elem.h);
@@ -565,12 +883,12 @@ void Overlay::render_gui_element(cairo_t* cr, const GuiElement& elem) {
         }
     }
 
-    if (elem.border_size > 0) {
+    if (st.border_size > 0) {
         float ba = 1.0f;
-        cairo_set_source_rgba(cr, elem.border_r, elem.border_g, elem.border_b, ba);
-        cairo_set_line_width(cr, elem.border_size);
-        if (elem.corner_radius > 0) {
-            render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, elem.corner_radius);
+        cairo_set_source_rgba(cr, st.border_r, st.border_g, st.border_b, ba);
+        cairo_set_line_width(cr, st.border_size);
+        if (st.corner_radius > 0) {
+            render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, st.corner_radius);
             cairo_stroke(cr);
         } else {
             cairo_rectangle(cr, elem.x, elem.y, elem.w, elem.h);
@@ -578,13 +896,13 @@ void Overlay::render_gui_element(cairo_t* cr, const GuiElement& elem) {
         }
     }
 
-    if (elem.has_stroke && elem.stroke_thickness > 0) {
-        float sa = 1.0f - elem.stroke_transparency;
+    if (st.has_stroke && st.stroke_thickness > 0) {
+        float sa = 1.0f - st.stroke_transparency;
         if (sa > 0.001f) {
-            cairo_set_source_rgba(cr, elem.stroke_r, elem.stroke_g, elem.stroke_b, sa);
-            cairo_set_line_width(cr, elem.stroke_thickness);
-            if (elem.corner_radius > 0) {
-                render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, elem.corner_radius);
+            cairo_set_source_rgba(cr, st.stroke_r, st.stroke_g, st.stroke_b, sa);
+            cairo_set_line_width(cr, st.stroke_thickness);
+            if (st.corner_radius > 0) {
+                render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, st.corner_radius);
                 cairo_stroke(cr);
             } else {
                 cairo_rectangle(cr, elem.x, elem.y, elem.w, elem.h);
@@ -593,29 +911,29 @@ void Overlay::render_gui_element(cairo_t* cr, const GuiElement& elem) {
         }
     }
 
-    if (elem.is_image_class && elem.image_surface) {
-        float ia = 1.0f - elem.image_transparency;
+    if (elem.is_image_class && img.image_surface) {
+        float ia = 1.0f - img.image_transparency;
         if (ia > 0.001f) {
-            int iw = cairo_image_surface_get_width(elem.image_surface);
-            int ih = cairo_image_surface_get_height(elem.image_surface);
+            int iw = cairo_image_surface_get_width(img.image_surface);
+            int ih = cairo_image_surface_get_height(img.image_surface);
             if (iw > 0 && ih > 0) {
                 cairo_save(cr);
-                if (elem.corner_radius > 0) {
-                    render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, elem.corner_radius);
+                if (st.corner_radius > 0) {
+                    render_gui_rounded_rect(cr, elem.x, elem.y, elem.w, elem.h, st.corner_radius);
                     cairo_clip(cr);
                 }
                 double sx = elem.w / iw;
                 double sy = elem.h / ih;
                 cairo_translate(cr, elem.x, elem.y);
                 cairo_scale(cr, sx, sy);
-                cairo_set_source_surface(cr, elem.image_surface, 0, 0);
+                cairo_set_source_surface(cr, img.image_surface, 0, 0);
                 cairo_paint_with_alpha(cr, ia);
                 cairo_restore(cr);
             }
         }
     }
 
-    if (elem.is_text_class && !elem.text.empty()) {
+    if (elem.is_text_class && !elem.text_style->text.empty()) {
         render_gui_text(cr, elem);
     }
 
@@ -647,40 +965,41 @@ void Overlay::render_gui_children(cairo_t* cr, const GuiElement& elem) {
 }
 
 void Overlay::render_gui_text(cairo_t* cr, const GuiElement& elem) {
-    float ta = 1.0f - elem.text_transparency;
+    const GuiTextStyle& ts = *elem.text_style;
+    float ta = 1.0f - ts.text_transparency;
     if (ta <= 0.001f) return;
 
     cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
-    cairo_set_font_size(cr, elem.text_size);
+    cairo_set_font_size(cr, ts.text_size);
 
     cairo_text_extents_t ext;
-    cairo_text_extents(cr, elem.text.c_str(), &ext);
+    cairo_text_extents(cr, ts.text.c_str(), &ext);
 
     float tx = elem.x + elem.pad_left;
     float ty = elem.y + elem.pad_top;
     float content_w = elem.w - elem.pad_left - elem.pad_right;
     float content_h = elem.h - elem.pad_top - elem.pad_bottom;
 
-    switch (elem.text_x_alignment) {
+    switch (ts.text_x_alignment) {
         case 0: tx += 2; break;
         case 1: tx += (content_w - static_cast<float>(ext.width)) / 2.0f; break;
         case 2: tx += content_w - static_cast<float>(ext.width) - 2; break;
     }
 
-    switch (elem.text_y_alignment) {
-        case 0: ty += elem.text_size; break;
-        case 1: ty += (content_h + elem.text_size) / 2.0f - 2; break;
+    switch (ts.text_y_alignment) {
+        case 0: ty += ts.text_size; break;
+        case 1: ty += (content_h + ts.text_size) / 2.0f - 2; break;
         case 2: ty += content_h - 2; break;
     }
 
-    if (elem.text_stroke_transparency < 0.999f) {
-        float sa = 1.0f - elem.text_stroke_transparency;
-        cairo_set_source_rgba(cr, elem.text_stroke_r, elem.text_stroke_g, elem.text_stroke_b, sa);
+    if (ts.text_stroke_transparency < 0.999f) {
+        float sa = 1.0f - ts.text_stroke_transparency;
+        cairo_set_source_rgba(cr, ts.text_stroke_r, ts.text_stroke_g, ts.text_stroke_b, sa);
         for (int dx = -1; dx <= 1; dx++) {
             for (int dy = -1; dy <= 1; dy++) {
                 if (dx == 0 && dy == 0) continue;
                 cairo_move_to(cr, tx + dx, ty + dy);
-                cairo_show_text(cr, elem.text.c_str());
+                cairo_show_text(cr, ts.text.c_str());
             }
         }
     }
@@ -689,9 +1008,9 @@ void Overlay::render_gui_text(cairo_t* cr, const GuiElement& elem) {
     cairo_rectangle(cr, elem.x, elem.y, elem.w, elem.h);
     cairo_clip(cr);
 
-    cairo_set_source_rgba(cr, elem.text_r, elem.text_g, elem.text_b, ta);
+    cairo_set_source_rgba(cr, ts.text_r, ts.text_g, ts.text_b, ta);
     cairo_move_to(cr, tx, ty);
-    cairo_show_text(cr, elem.text.c_str());
+    cairo_show_text(cr, ts.text.c_str());
 
     cairo_restore(cr);
 }
@@ -866,4 +1185,70 @@ void Overlay::render_image(cairo_t* cr, const DrawingObject& obj) {
     cairo_restore(cr);
 }
 
+// ── Batch primitives: one cairo path per object ──
+
+void Overlay::render_line_list(cairo_t* cr, const DrawingObject& obj) {
+    if (!obj.points || obj.points->size() < 4) return;
+    double a = 1.0 - obj.transparency;
+    if (a <= 0) return;
+    const auto& p = *obj.points;
+    cairo_set_source_rgba(cr, obj.color_r, obj.color_g, obj.color_b, a);
+    cairo_set_line_width(cr, obj.thickness);
+    cairo_set_line_cap(cr, CAIRO_LINE_CAP_ROUND);
+    for (size_t i = 0; i + 3 < p.size(); i += 4) {
+        cairo_move_to(cr, p[i], p[i + 1]);
+        cairo_line_to(cr, p[i + 2], p[i + 3]);
+    }
+    cairo_stroke(cr);
+}
+
+void Overlay::render_polyline(cairo_t* cr, const DrawingObject& obj) {
+    if (!obj.points || obj.points->size() < 4) return;
+    double a = 1.0 - obj.transparency;
+    if (a <= 0) return;
+    const auto& p = *obj.points;
+    cairo_set_source_rgba(cr, obj.color_r, obj.color_g, obj.color_b, a);
+    cairo_move_to(cr, p[0], p[1]);
+    for (size_t i = 2; i + 1 < p.size(); i += 2)
+        cairo_line_to(cr, p[i], p[i + 1]);
+    if (obj.closed) cairo_close_path(cr);
+    if (obj.closed && obj.filled) {
+        cairo_fill(cr);
+    } else {
+        cairo_set_line_width(cr, obj.thickness);
+        cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
+        cairo_set_line_cap(cr, CAIRO_LINE_CAP_ROUND);
+        cairo_stroke(cr);
+    }
+}
+
+void Overlay::render_point_cloud(cairo_t* cr, const DrawingObject& obj) {
+    if (!obj.points || obj.points->size() < 2) return;
+    double a = 1.0 - obj.transparency;
+    if (a <= 0) return;
+    const auto& p = *obj.points;
+    double s = std::max(obj.thickness, 1.0);
+    double h = s / 2.0;
+    cairo_set_source_rgba(cr, obj.color_r, obj.color_g, obj.color_b, a);
+    for (size_t i = 0; i + 1 < p.size(); i += 2)
+        cairo_rectangle(cr, p[i] - h, p[i + 1] - h, s, s);
+    cairo_fill(cr);
+}
+
+void Overlay::render_rect_list(cairo_t* cr, const DrawingObject& obj) {
+    if (!obj.points || obj.points->size() < 4) return;
+    double a = 1.0 - obj.transparency;
+    if (a <= 0) return;
+    const auto& p = *obj.points;
+    cairo_set_source_rgba(cr, obj.color_r, obj.color_g, obj.color_b, a);
+    for (size_t i = 0; i + 3 < p.size(); i += 4)
+        cairo_rectangle(cr, p[i], p[i + 1], p[i + 2], p[i + 3]);
+    if (obj.filled) {
+        cairo_fill(cr);
+    } else {
+        cairo_set_line_width(cr, obj.thickness);
+        cairo_stroke(cr);
+    }
+}
+
 } // namespace oss
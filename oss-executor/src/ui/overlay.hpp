@@ -7,32 +7,60 @@
 #include <string>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include "drawing_object.hpp"
+#include "utils/spsc_queue.hpp"
 
 namespace oss {
 
-struct GuiElement {
-    int id = 0;
-    int parent_id = -1;
-    std::string class_name;
-    std::string name;
+// Copy-on-write holder for the rarely-written parts of a GuiElement. Copies
+// share one block until mut() is called on a shared one; untouched elements
+// all point at a single default instance, so creating one allocates nothing.
+// Only the render thread touches these, so the count needs no ordering.
+template<typename T>
+class CowBlock {
+public:
+    CowBlock() : p_(defaults()) {}
 
-    float x = 0, y = 0, w = 100, h = 100;
+    const T& operator*() const  { return *p_; }
+    const T* operator->() const { return p_.get(); }
 
-    float pos_x_scale = 0, pos_x_offset = 0;
-    float pos_y_scale = 0, pos_y_offset = 0;
-    float size_x_scale = 0, size_x_offset = 100;
-    float size_y_scale = 0, size_y_offset = 100;
+    T& mut() {
+        if (p_.use_count() > 1) p_ = std::make_shared<T>(*p_);
+        return *p_;
+    }
 
-    float anchor_x = 0, anchor_y = 0;
+    bool shared_with(const CowBlock& o) const { return p_ == o.p_; }
 
+private:
+    static const std::shared_ptr<T>& defaults() {
+        static const std::shared_ptr<T> d = std::make_shared<T>();
+        return d;
+    }
+
+    std::shared_ptr<T> p_;
+};
+
+struct GuiStyle {
     float bg_r = 1, bg_g = 1, bg_b = 1;
     float bg_transparency = 0;
     float border_r = 0.11f, border_g = 0.11f, border_b = 0.11f;
     int border_size = 0;
+    float corner_radius = 0;
 
+    bool has_stroke = false;
+    float stroke_thickness = 1;
+    float stroke_r = 0, stroke_g = 0, stroke_b = 0;
+    float stroke_transparency = 0;
+
+    bool has_gradient = false;
+    float gradient_rotation = 0;
+};
+
+struct GuiTextStyle {
     std::string text;
     float text_size = 14;
     float text_r = 0, text_g = 0, text_b = 0;
@@ -44,27 +72,48 @@ struct GuiElement {
     bool text_wrapped = false;
     bool text_scaled = false;
     bool rich_text = false;
+};
 
+// Holds its own reference on image_surface, so whichever copy goes last frees it
+struct GuiImageStyle {
     std::string image;
     float image_r = 1, image_g = 1, image_b = 1;
     float image_transparency = 0;
     cairo_surface_t* image_surface = nullptr;
 
+    GuiImageStyle() = default;
+    GuiImageStyle(const GuiImageStyle& o)
+        : image(o.image), image_r(o.image_r), image_g(o.image_g), image_b(o.image_b),
+          image_transparency(o.image_transparency), image_surface(o.image_surface) {
+        if (image_surface) cairo_surface_reference(image_surface);
+    }
+    GuiImageStyle& operator=(const GuiImageStyle&) = delete;
+    ~GuiImageStyle() { if (image_surface) cairo_surface_destroy(image_surface); }
+};
+
+// Layout and tree fields live inline since every frame reads and resolve_gui_layout
+// writes them; appearance sits in shared blocks so Clone is a cheap structural copy.
+struct GuiElement {
+    int id = 0;
+    int parent_id = -1;
+    std::string class_name;
+    std::string name;
+
+    float x = 0, y = 0, w = 100, h = 100;
+
+    float pos_x_scale = 0, pos_x_offset = 0;
+    float pos_y_scale = 0, pos_y_offset = 0;
+    float size_x_scale = 0, size_x_offset = 100;
+    float size_y_scale = 0, size_y_offset = 100;
+
+    float anchor_x = 0, anchor_y = 0;
+
     float rotation = 0;
-    float corner_radius = 0;
     bool clips_descendants = false;
     bool visible = true;
     int z_index = 1;
     int layout_order = 0;
 
-    bool has_stroke = false;
-    float stroke_thickness = 1;
-    float stroke_r = 0, stroke_g = 0, stroke_b = 0;
-    float stroke_transparency = 0;
-
-    bool has_gradient = false;
-    float gradient_rotation = 0;
-
     float pad_top = 0, pad_bottom = 0, pad_left = 0, pad_right = 0;
 
     float canvas_size_y = 0;
@@ -79,9 +128,34 @@ struct GuiElement {
     int display_order = 0;
     bool ignore_gui_inset = false;
 
+    CowBlock<GuiStyle>      style;
+    CowBlock<GuiTextStyle>  text_style;
+    CowBlock<GuiImageStyle> image_style;
+
     std::vector<int> children_ids;
 };
 
+// GUI mutations are queued by the script side and applied by the renderer at
+// frame start, so script threads never wait on render_gui.
+struct GuiCommand {
+    enum class Op : uint8_t { Create, Set, Update, SetParent, Remove, Clear, Clone, CloneTree };
+
+    Op  op  = Op::Set;
+    int id  = 0;
+    int arg = 0;                  // parent id (SetParent) / source id (Clone)
+
+    // Set: value decoded on the script side, applied by `set` on the renderer
+    void (*set)(GuiElement&, const GuiCommand&) = nullptr;
+    float f[4] = {0, 0, 0, 0};
+    int   i = 0;
+    bool  b = false;
+    std::string s;                // Create/Clone: class name; Set: string value
+    std::string s2;               // Create/Clone: instance name
+
+    std::function<void(GuiElement&)> fn;   // Update
+    std::vector<int> ids;         // CloneTree: (source, new) id pairs, parents first
+};
+
 class Overlay {
 public:
     using RenderCallback = void(*)(cairo_t*, int, int, void*);
@@ -114,27 +188,56 @@ public:
         }
     }
 
+    // Runs fn(find) under one lock acquisition, where find(id) returns the
+    // object or nullptr, and publishes a single dirty notification.
+    template<typename Func>
+    void update_objects(Func&& fn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn([this](int id) -> DrawingObject* {
+            auto it = objects_.find(id);
+            return it != objects_.end() ? &it->second : nullptr;
+        });
+        dirty_.store(true, std::memory_order_release);
+    }
+
+    // Script side: never blocks on rendering; producers only contend with
+    // each other.
     int  create_gui_element(const std::string& class_name, const std::string& name);
+    int  clone_gui_element(int src_id, const std::string& class_name, const std::string& name);
+    // Clones a whole subtree in one command. src_ids lists the root first and
+    // every parent before its children; returns the new ids in the same order.
+    std::vector<int> clone_gui_tree(const std::vector<int>& src_ids);
     void remove_gui_element(int id);
     void clear_gui_elements();
     void set_gui_parent(int child_id, int parent_id);
-    int  gui_element_count() const;
+    void push_gui_command(GuiCommand&& cmd);
+    int  gui_element_count() const { return gui_count_.load(std::memory_order_acquire); }
 
     template<typename Func>
     void update_gui_element(int id, Func&& fn) {
-        std::lock_guard<std::mutex> lock(gui_mutex_);
-        auto it = gui_elements_.find(id);
-        if (it != gui_elements_.end()) {
-            fn(it->second);
-            gui_dirty_.store(true, std::memory_order_release);
-            dirty_.store(true, std::memory_order_release);
-        }
+        GuiCommand cmd;
+        cmd.op = GuiCommand::Op::Update;
+        cmd.id = id;
+        cmd.fn = std::forward<Func>(fn);
+        push_gui_command(std::move(cmd));
     }
 
+    // Renderer side: applies everything queued so far.
+    void drain_gui_commands();
+
     void set_custom_render(RenderCallback cb, void* ud);
 
     int screen_width() const { return screen_w_; }
     int screen_height() const { return screen_h_; }
+    void set_screen_size(int w, int h) { screen_w_ = w; screen_h_ = h; }
+
+    // ── Offscreen (no GTK/display required) ──
+    void render(cairo_t* cr, int width, int height);
+    cairo_surface_t* render_offscreen(int width, int height);
+    bool write_png(const std::string& path, int width, int height);
+
+    std::string save_snapshot() const;
+    bool load_snapshot(const std::string& json_text);
 
 private:
     Overlay() = default;
@@ -149,8 +252,6 @@ private:
     static void draw_func(GtkDrawingArea* area, cairo_t* cr,
                           int width, int height, gpointer data);
 
-    void render(cairo_t* cr, int width, int height);
-
     void render_line(cairo_t* cr, const DrawingObject& obj);
     void render_text(cairo_t* cr, const DrawingObject& obj);
     void render_circle(cairo_t* cr, const DrawingObject& obj);
@@ -158,6 +259,10 @@ private:
     void render_triangle(cairo_t* cr, const DrawingObject& obj);
     void render_quad(cairo_t* cr, const DrawingObject& obj);
     void render_image(cairo_t* cr, const DrawingObject& obj);
+    void render_line_list(cairo_t* cr, const DrawingObject& obj);
+    void render_polyline(cairo_t* cr, const DrawingObject& obj);
+    void render_point_cloud(cairo_t* cr, const DrawingObject& obj);
+    void render_rect_list(cairo_t* cr, const DrawingObject& obj);
 
     void render_gui(cairo_t* cr, int width, int height);
     void resolve_gui_layout(GuiElement& elem, float parent_x, float parent_y,
@@ -167,11 +272,30 @@ private:
     void render_gui_text(cairo_t* cr, const GuiElement& elem);
     void render_gui_rounded_rect(cairo_t* cr, float x, float y, float w, float h, float r);
 
-    mutable std::mutex gui_mutex_;
+    void apply_gui_command(GuiCommand& cmd);
+    void apply_gui_create(int id, const std::string& class_name, const std::string& name);
+    void apply_gui_parent(int child_id, int parent_id);
+    void apply_gui_remove(int id);
+    void apply_gui_clear();
+    void apply_gui_clone_tree(const std::vector<int>& ids);
+
+    // Owned by the render thread; only touched through drain_gui_commands.
     std::unordered_map<int, GuiElement> gui_elements_;
-    int gui_next_id_ = 1;
+    std::atomic<int> gui_next_id_{1};
+    std::atomic<int> gui_count_{0};
     std::atomic<bool> gui_dirty_{false};
 
+    static constexpr size_t GUI_QUEUE_CAPACITY = 8192;
+    // Nothing drains in --headless mode, so the spill is bounded too; commands
+    // past it are dropped, counted and logged. In UI mode init() drains
+    // whatever queued up before the overlay existed.
+    static constexpr size_t GUI_SPILL_CAPACITY = 64 * 1024;
+    SpscQueue<GuiCommand, GUI_QUEUE_CAPACITY> gui_queue_;
+    std::mutex gui_spill_mutex_;            // only taken once the ring is full
+    std::vector<GuiCommand> gui_spill_;
+    std::atomic<bool> gui_spilled_{false};
+    std::mutex gui_push_mutex_;             // serializes producers only
+
     mutable std::mutex mutex_;
     std::map<int, DrawingObject> objects_;
     int next_id_ = 1;
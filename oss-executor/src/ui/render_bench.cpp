@@ -0,0 +1,185 @@
+#include "render_bench.hpp"
+#include "overlay.hpp"
+#include "core/lua_engine.hpp"
+#include "utils/logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace oss {
+
+static bool ends_with(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+// Counts pixels whose channels differ from the reference by more than 2/255.
+// Returns -1 if the reference can't be read or the sizes don't match.
+static long compare_png(cairo_surface_t* actual, const std::string& ref_path) {
+    cairo_surface_t* ref = cairo_image_surface_create_from_png(ref_path.c_str());
+    if (cairo_surface_status(ref) != CAIRO_STATUS_SUCCESS) {
+        cairo_surface_destroy(ref);
+        return -1;
+    }
+
+    int w = cairo_image_surface_get_width(actual);
+    int h = cairo_image_surface_get_height(actual);
+    if (cairo_image_surface_get_width(ref) != w ||
+        cairo_image_surface_get_height(ref) != h ||
+        cairo_image_surface_get_format(ref) != CAIRO_FORMAT_ARGB32) {
+        cairo_surface_destroy(ref);
+        return -1;
+    }
+
+    cairo_surface_flush(ref);
+    const unsigned char* a = cairo_image_surface_get_data(actual);
+    const unsigned char* b = cairo_image_surface_get_data(ref);
+    int sa = cairo_image_surface_get_stride(actual);
+    int sb = cairo_image_surface_get_stride(ref);
+
+    long diff = 0;
+    for (int y = 0; y < h; y++) {
+        const unsigned char* ra = a + static_cast<size_t>(y) * sa;
+        const unsigned char* rb = b + static_cast<size_t>(y) * sb;
+        for (int x = 0; x < w * 4; x += 4) {
+            for (int c = 0; c < 4; c++) {
+                if (std::abs(ra[x + c] - rb[x + c]) > 2) { ++diff; break; }
+            }
+        }
+    }
+    cairo_surface_destroy(ref);
+    return diff;
+}
+
+int run_render_bench(int argc, char** argv) {
+    std::string scene, png_out, compare_ref, snapshot_out;
+    int frames = 300;
+    int width = 1920, height = 1080;
+    long tolerance = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_val = i + 1 < argc;
+        if (arg == "--frames" && has_val)             frames = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--size" && has_val)          std::sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (arg == "--png" && has_val)           png_out = argv[++i];
+        else if (arg == "--compare" && has_val)       compare_ref = argv[++i];
+        else if (arg == "--tolerance" && has_val)     tolerance = std::atol(argv[++i]);
+        else if (arg == "--save-snapshot" && has_val) snapshot_out = argv[++i];
+        else if (scene.empty() && arg.rfind("--", 0) != 0) scene = arg;
+        else {
+            std::cerr << "render-bench: unknown argument " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    if (scene.empty() || width <= 0 || height <= 0) {
+        std::cerr << "usage: --render-bench <scene.lua|scene.json> [--frames N] [--size WxH]"
+                     " [--png out.png] [--compare ref.png] [--tolerance PIXELS]"
+                     " [--save-snapshot out.json]" << std::endl;
+        return 2;
+    }
+
+    auto& overlay = Overlay::instance();
+    overlay.set_screen_size(width, height);
+
+    bool lua_scene = !ends_with(scene, ".json");
+    if (lua_scene) {
+        auto& lua = LuaEngine::instance();
+        if (!lua.init()) {
+            std::cerr << "render-bench: Lua engine failed to initialize" << std::endl;
+            return 1;
+        }
+        lua.set_error_callback([](const LuaError& err) {
+            std::cerr << "render-bench: " << err.message << std::endl;
+        });
+        if (!lua.execute_file(scene)) return 1;
+    } else {
+        std::ifstream in(scene);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        if (!in.is_open() || !overlay.load_snapshot(ss.str())) {
+            std::cerr << "render-bench: cannot load snapshot " << scene << std::endl;
+            return 1;
+        }
+    }
+
+    if (!snapshot_out.empty()) {
+        std::ofstream out(snapshot_out);
+        out << overlay.save_snapshot();
+    }
+
+    cairo_surface_t* surface =
+        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    cairo_t* cr = cairo_create(surface);
+
+    std::vector<double> times;
+    times.reserve(frames);
+    for (int f = 0; f < frames; f++) {
+        if (lua_scene) LuaEngine::instance().tick();
+        auto t0 = std::chrono::steady_clock::now();
+        overlay.render(cr, width, height);
+        cairo_surface_flush(surface);
+        times.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - t0).count());
+    }
+    cairo_destroy(cr);
+
+    int rc = 0;
+    if (!png_out.empty() &&
+        cairo_surface_write_to_png(surface, png_out.c_str()) != CAIRO_STATUS_SUCCESS) {
+        std::cerr << "render-bench: failed to write " << png_out << std::endl;
+        rc = 1;
+    }
+
+    long diff = 0;
+    if (!compare_ref.empty()) {
+        diff = compare_png(surface, compare_ref);
+        if (diff < 0 || diff > tolerance) rc = 3;
+    }
+    cairo_surface_destroy(surface);
+
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (double t : times) total += t;
+
+    nlohmann::json report = {
+        {"scene", scene},
+        {"frames", frames},
+        {"width", width}, {"height", height},
+        {"objects", overlay.object_count()},
+        {"gui_elements", overlay.gui_element_count()},
+        {"mean_ms", total / static_cast<double>(times.size())},
+        {"p50_ms", percentile(sorted, 0.50)},
+        {"p90_ms", percentile(sorted, 0.90)},
+        {"p99_ms", percentile(sorted, 0.99)},
+        {"max_ms", sorted.back()},
+    };
+    if (!compare_ref.empty()) {
+        report["compare"] = compare_ref;
+        report["diff_pixels"] = diff;
+        report["passed"] = rc == 0;
+    }
+    std::cout << report.dump(2) << std::endl;
+
+    if (lua_scene) LuaEngine::instance().shutdown();
+    return rc;
+}
+
+} // namespace oss
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace oss {
+
+// Headless overlay renderer: loads a scene (Lua script or JSON snapshot),
+// renders N frames into an image surface and prints frame-time percentiles.
+//
+//   oss-executor --render-bench <scene.lua|scene.json> [--frames N]
+//                [--size WxH] [--png out.png] [--compare ref.png]
+//                [--tolerance PIXELS] [--save-snapshot out.json]
+int run_render_bench(int argc, char** argv);
+
+} // namespace oss
@@ -0,0 +1,168 @@
+#include "task_panel.hpp"
+#include "core/executor.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace oss {
+
+static GtkWidget* make_cell(const char* text, int width_chars, bool dim) {
+    GtkWidget* label = gtk_label_new(text);
+    gtk_label_set_width_chars(GTK_LABEL(label), width_chars);
+    gtk_label_set_xalign(GTK_LABEL(label), 1.0f);
+    if (dim) gtk_widget_add_css_class(label, "dim-label");
+    return label;
+}
+
+static std::string format_bytes(size_t bytes) {
+    char buf[32];
+    if (bytes >= 1024 * 1024)
+        std::snprintf(buf, sizeof(buf), "%.1f MB", bytes / (1024.0 * 1024.0));
+    else
+        std::snprintf(buf, sizeof(buf), "%.1f KB", bytes / 1024.0);
+    return buf;
+}
+
+TaskPanel::TaskPanel() {
+    container_ = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
+    gtk_widget_set_margin_start(container_, 4);
+    gtk_widget_set_margin_end(container_, 4);
+    gtk_widget_set_margin_top(container_, 4);
+
+    GtkWidget* header = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    gtk_widget_set_margin_start(header, 8);
+    gtk_widget_set_margin_end(header, 8);
+    GtkWidget* title = gtk_label_new("Tasks");
+    gtk_widget_add_css_class(title, "heading");
+    gtk_label_set_xalign(GTK_LABEL(title), 0);
+    gtk_widget_set_hexpand(title, TRUE);
+    gtk_box_append(GTK_BOX(header), title);
+    gtk_box_append(GTK_BOX(header), make_cell("CPU", 7, true));
+    gtk_box_append(GTK_BOX(header), make_cell("Memory", 10, true));
+    gtk_box_append(GTK_BOX(header), make_cell("Yields", 8, true));
+    gtk_box_append(GTK_BOX(header), make_cell("Timers", 7, true));
+    // Lines the columns up with the rows' Kill buttons
+    GtkWidget* spacer = gtk_button_new_with_label("Kill");
+    gtk_widget_set_opacity(spacer, 0);
+    gtk_widget_set_can_target(spacer, FALSE);
+    gtk_box_append(GTK_BOX(header), spacer);
+    gtk_box_append(GTK_BOX(container_), header);
+
+    GtkWidget* scroll = gtk_scrolled_window_new();
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroll),
+                                   GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    gtk_widget_set_vexpand(scroll, TRUE);
+
+    list_box_ = gtk_list_box_new();
+    gtk_list_box_set_selection_mode(GTK_LIST_BOX(list_box_), GTK_SELECTION_NONE);
+    gtk_widget_add_css_class(list_box_, "script-list");
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroll), list_box_);
+    gtk_box_append(GTK_BOX(container_), scroll);
+
+    status_label_ = gtk_label_new("No scripts running");
+    gtk_widget_add_css_class(status_label_, "dim-label");
+    gtk_box_append(GTK_BOX(container_), status_label_);
+}
+
+TaskPanel::Row TaskPanel::add_row(int script_id) {
+    Row r;
+    r.row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    gtk_widget_set_margin_start(r.row, 8);
+    gtk_widget_set_margin_end(r.row, 8);
+    gtk_widget_set_margin_top(r.row, 2);
+    gtk_widget_set_margin_bottom(r.row, 2);
+
+    r.name = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(r.name), 0);
+    gtk_label_set_ellipsize(GTK_LABEL(r.name), PANGO_ELLIPSIZE_END);
+    gtk_widget_set_hexpand(r.name, TRUE);
+    gtk_box_append(GTK_BOX(r.row), r.name);
+
+    r.cpu    = make_cell("", 7, false);
+    r.memory = make_cell("", 10, false);
+    r.yields = make_cell("", 8, false);
+    r.timers = make_cell("", 7, false);
+    gtk_box_append(GTK_BOX(r.row), r.cpu);
+    gtk_box_append(GTK_BOX(r.row), r.memory);
+    gtk_box_append(GTK_BOX(r.row), r.yields);
+    gtk_box_append(GTK_BOX(r.row), r.timers);
+
+    r.kill = gtk_button_new_with_label("Kill");
+    gtk_widget_add_css_class(r.kill, "btn-danger");
+    g_signal_connect(r.kill, "clicked", G_CALLBACK(+[](GtkButton*, gpointer data) {
+        Executor::instance().kill_script(GPOINTER_TO_INT(data));
+    }), GINT_TO_POINTER(script_id));
+    gtk_box_append(GTK_BOX(r.row), r.kill);
+
+    r.remove = gtk_button_new_with_label("Remove");
+    g_signal_connect(r.remove, "clicked", G_CALLBACK(+[](GtkButton*, gpointer data) {
+        Executor::instance().remove_script(GPOINTER_TO_INT(data));
+    }), GINT_TO_POINTER(script_id));
+    gtk_widget_set_visible(r.remove, FALSE);
+    gtk_box_append(GTK_BOX(r.row), r.remove);
+
+    gtk_list_box_append(GTK_LIST_BOX(list_box_), r.row);
+    return r;
+}
+
+void TaskPanel::refresh() {
+    auto usage = Executor::instance().script_usage();
+
+    // CPU% is this refresh's share of wall time since the previous one
+    gint64 now = g_get_monotonic_time();
+    double wall_ms = last_refresh_us_ > 0 && now > last_refresh_us_
+                         ? static_cast<double>(now - last_refresh_us_) / 1000.0 : 0.0;
+    last_refresh_us_ = now;
+
+    std::unordered_map<int, double> cpu_ms;
+    double total_cpu = 0;
+    size_t running = 0;
+    for (const auto& u : usage) {
+        if (!u.finished) ++running;
+        cpu_ms[u.id] = u.cpu_ms;
+
+        auto it = rows_.find(u.id);
+        if (it == rows_.end()) it = rows_.emplace(u.id, add_row(u.id)).first;
+        const Row& r = it->second;
+
+        std::string name = "#" + std::to_string(u.id) + "  " + u.name;
+        if (u.finished)    name += u.killed ? "  (killed)" : "  (finished)";
+        else if (u.killed) name += "  (killing)";
+        gtk_label_set_text(GTK_LABEL(r.name), name.c_str());
+        gtk_widget_set_tooltip_text(r.name, u.name.c_str());
+
+        auto prev = last_cpu_ms_.find(u.id);
+        double delta = prev != last_cpu_ms_.end() ? u.cpu_ms - prev->second : 0.0;
+        double pct   = wall_ms > 0 ? 100.0 * delta / wall_ms : 0.0;
+        total_cpu += pct;
+
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.1f%%", pct);
+        gtk_label_set_text(GTK_LABEL(r.cpu), buf);
+        gtk_label_set_text(GTK_LABEL(r.memory), format_bytes(u.memory).c_str());
+        gtk_label_set_text(GTK_LABEL(r.yields), std::to_string(u.yields).c_str());
+        gtk_label_set_text(GTK_LABEL(r.timers), std::to_string(u.pending_timers).c_str());
+        gtk_widget_set_sensitive(r.kill, !u.killed);
+        gtk_widget_set_visible(r.kill, !u.finished);
+        gtk_widget_set_visible(r.remove, u.finished);
+    }
+
+    for (auto it = rows_.begin(); it != rows_.end();) {
+        if (cpu_ms.count(it->first)) { ++it; continue; }
+        gtk_list_box_remove(GTK_LIST_BOX(list_box_),
+                            gtk_widget_get_parent(it->second.row));
+        it = rows_.erase(it);
+    }
+    last_cpu_ms_ = std::move(cpu_ms);
+
+    if (usage.empty()) {
+        gtk_label_set_text(GTK_LABEL(status_label_), "No scripts running");
+    } else {
+        char buf[96];
+        std::snprintf(buf, sizeof(buf), "%zu running · %zu finished · %.1f%% CPU",
+                      running, usage.size() - running, total_cpu);
+        gtk_label_set_text(GTK_LABEL(status_label_), buf);
+    }
+}
+
+} // namespace oss
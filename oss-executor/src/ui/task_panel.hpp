@@ -0,0 +1,44 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include <unordered_map>
+
+namespace oss {
+
+// Task manager: one row per script with its CPU share, memory, yields and
+// pending timers, plus a Kill button for just that script. Finished scripts
+// stay listed with a Remove button instead.
+class TaskPanel {
+public:
+    TaskPanel();
+
+    GtkWidget* widget() { return container_; }
+
+    // Polled from the app's status tick while the panel is shown
+    void refresh();
+
+private:
+    struct Row {
+        GtkWidget* row;
+        GtkWidget* name;
+        GtkWidget* cpu;
+        GtkWidget* memory;
+        GtkWidget* yields;
+        GtkWidget* timers;
+        GtkWidget* kill;
+        GtkWidget* remove;
+    };
+
+    Row add_row(int script_id);
+
+    GtkWidget* container_;
+    GtkWidget* list_box_;
+    GtkWidget* status_label_;
+
+    // Rows are reused across refreshes so the list doesn't flicker
+    std::unordered_map<int, Row>    rows_;
+    std::unordered_map<int, double> last_cpu_ms_;
+    gint64 last_refresh_us_ = 0;
+};
+
+} // namespace oss
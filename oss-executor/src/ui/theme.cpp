@@ -1,6 +1,8 @@
 #include "theme.hpp"
 #include "utils/logger.hpp"
 
+#include <iterator>
+
 namespace oss {
 
 std::string Theme::generate_css() const {
@@ -175,14 +177,23 @@ std::string Theme::generate_css() const {
 void ThemeManager::load_themes(const std::string& dir) {
     // Always have built-in themes
     themes_["midnight"] = Theme::midnight();
-    
+    dir_ = dir;
+    scanned_ = false;
+}
+
+void ThemeManager::scan_themes() const {
+    if (scanned_) return;
+    scanned_ = true;
+
     // Load custom themes from directory
-    if (std::filesystem::exists(dir)) {
-        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+    std::error_code ec;
+    if (!dir_.empty() && std::filesystem::exists(dir_, ec)) {
+        for (const auto& entry : std::filesystem::directory_iterator(dir_, ec)) {
             if (entry.path().extension() == ".json") {
                 try {
                     Theme t = Theme::load(entry.path().string());
                     themes_[t.name] = t;
+                    files_[entry.path().string()] = t.name;
                     LOG_INFO("Loaded theme: {}", t.name);
                 } catch (const std::exception& e) {
                     LOG_WARN("Failed to load theme {}: {}", 
@@ -194,15 +205,66 @@ void ThemeManager::load_themes(const std::string& dir) {
 }
 
 void ThemeManager::set_theme(const std::string& name) {
+    if (themes_.find(name) == themes_.end()) scan_themes();
     auto it = themes_.find(name);
     if (it != themes_.end()) {
-        current_ = it->second;
+        set_current(it->second, name);
     } else {
-        current_ = Theme::midnight();
+        set_current(Theme::midnight(), "midnight");
+    }
+}
+
+void ThemeManager::set_current(const Theme& theme, const std::string& name) {
+    current_ = theme;
+    current_name_ = name;
+    css_dirty_ = true;
+    css_generation_++;
+}
+
+const std::string& ThemeManager::current_css() {
+    if (css_dirty_) {
+        css_ = current_.generate_css();
+        css_dirty_ = false;
+    }
+    return css_;
+}
+
+bool ThemeManager::reload_file(const std::string& path) {
+    if (std::filesystem::path(path).extension() != ".json") return false;
+
+    // Theme::load falls back to Midnight on bad input; a half-saved file
+    // should leave the previous version in place instead
+    std::ifstream f(path);
+    std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (!json::accept(text)) {
+        LOG_WARN("Ignoring unparsable theme {}", path);
+        return false;
     }
+
+    Theme t = Theme::load(path);
+    auto old = files_.find(path);
+    if (old != files_.end() && old->second != t.name) themes_.erase(old->second);
+    files_[path] = t.name;
+    themes_[t.name] = t;
+    LOG_INFO("Reloaded theme: {}", t.name);
+
+    if (t.name != current_name_) return false;
+    set_current(t, t.name);
+    return true;
+}
+
+bool ThemeManager::remove_file(const std::string& path) {
+    auto it = files_.find(path);
+    if (it == files_.end()) return false;
+    // The theme in use stays applied until another is selected
+    if (it->second != current_name_) themes_.erase(it->second);
+    if (it->second == "midnight") themes_["midnight"] = Theme::midnight();
+    files_.erase(it);
+    return false;
 }
 
 std::vector<std::string> ThemeManager::available() const {
+    scan_themes();
     std::vector<std::string> names;
     for (const auto& [name, _] : themes_) {
         names.push_back(name);
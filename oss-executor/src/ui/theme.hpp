@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <nlohmann/json.hpp>
 #include <unordered_map>
@@ -205,16 +206,38 @@ public:
         return inst;
     }
     
+    // Only records the directory; it is scanned the first time a
+    // non-built-in theme is requested or the theme list is read.
     void load_themes(const std::string& dir);
     Theme& current() { return current_; }
     void set_theme(const std::string& name);
     std::vector<std::string> available() const;
 
+    // Hot reload of one file under the themes directory. Both return true
+    // only when the current theme changed and its CSS must be reapplied.
+    bool reload_file(const std::string& path);
+    bool remove_file(const std::string& path);
+
+    // CSS of the current theme, regenerated only after it changes;
+    // css_generation() bumps each time so callers can skip reapplying.
+    const std::string& current_css();
+    uint64_t css_generation() const { return css_generation_; }
+
 private:
     ThemeManager() : current_(Theme::midnight()) {}
+
+    void scan_themes() const;
+    void set_current(const Theme& theme, const std::string& name);
     
     Theme current_;
-    std::unordered_map<std::string, Theme> themes_;
+    std::string current_name_ = "midnight";
+    std::string css_;
+    bool css_dirty_ = true;
+    uint64_t css_generation_ = 1;
+    std::string dir_;
+    mutable bool scanned_ = false;
+    mutable std::unordered_map<std::string, Theme> themes_;
+    mutable std::unordered_map<std::string, std::string> files_;  // path -> theme name
 };
 
 } // namespace oss
\ No newline at end of file
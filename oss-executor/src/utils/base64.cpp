@@ -0,0 +1,363 @@
+#include "base64.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <immintrin.h>
+#  define OSS_BASE64_X86 1
+#  define OSS_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace oss {
+
+static constexpr char ENCODE_TABLE[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static constexpr uint8_t PAD     = 0xFE;
+static constexpr uint8_t SPACE   = 0xFD;
+static constexpr uint8_t INVALID = 0xFF;
+
+static constexpr std::array<uint8_t, 256> DECODE_TABLE = [] {
+    std::array<uint8_t, 256> t{};
+    for (auto& v : t) v = INVALID;
+    for (uint8_t i = 0; i < 64; i++) t[static_cast<uint8_t>(ENCODE_TABLE[i])] = i;
+    t['='] = PAD;
+    for (char c : {' ', '\t', '\r', '\n', '\f', '\v'}) t[static_cast<uint8_t>(c)] = SPACE;
+    return t;
+}();
+
+// ── Scalar ──
+
+static size_t encode_scalar(const uint8_t* in, size_t len, char* out) {
+    char* p = out;
+    size_t i = 0;
+    for (; i + 3 <= len; i += 3) {
+        uint32_t n = (uint32_t{in[i]} << 16) | (uint32_t{in[i + 1]} << 8) | in[i + 2];
+        p[0] = ENCODE_TABLE[(n >> 18) & 0x3F];
+        p[1] = ENCODE_TABLE[(n >> 12) & 0x3F];
+        p[2] = ENCODE_TABLE[(n >> 6) & 0x3F];
+        p[3] = ENCODE_TABLE[n & 0x3F];
+        p += 4;
+    }
+    if (len - i == 1) {
+        uint32_t n = uint32_t{in[i]} << 16;
+        p[0] = ENCODE_TABLE[(n >> 18) & 0x3F];
+        p[1] = ENCODE_TABLE[(n >> 12) & 0x3F];
+        p[2] = p[3] = '=';
+        p += 4;
+    } else if (len - i == 2) {
+        uint32_t n = (uint32_t{in[i]} << 16) | (uint32_t{in[i + 1]} << 8);
+        p[0] = ENCODE_TABLE[(n >> 18) & 0x3F];
+        p[1] = ENCODE_TABLE[(n >> 12) & 0x3F];
+        p[2] = ENCODE_TABLE[(n >> 6) & 0x3F];
+        p[3] = '=';
+        p += 4;
+    }
+    return static_cast<size_t>(p - out);
+}
+
+// ── SIMD kernels ──
+// Encode and decode follow Muła and Lemire, "Faster Base64 Encoding and
+// Decoding using AVX2 Instructions" (2018): bytes are regrouped into 6-bit
+// indices with a shuffle and two multiplies, and translated to and from
+// ASCII with nibble-indexed pshufb lookups. Each kernel consumes whole
+// blocks and stops at the first one containing anything outside the
+// alphabet, leaving it to the scalar path.
+
+#ifdef OSS_BASE64_X86
+
+OSS_TARGET("ssse3")
+static __m128i enc_reshuffle(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+OSS_TARGET("ssse3")
+static __m128i enc_translate(__m128i idx) {
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                        '/' - 63, 'A', 0, 0);
+    __m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+    r = _mm_or_si128(r, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, r), idx);
+}
+
+// 12 bytes in, 16 chars out; reads 16
+OSS_TARGET("ssse3")
+static size_t encode_ssse3(const uint8_t* in, size_t len, char* out) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 12, out += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), enc_translate(enc_reshuffle(v)));
+    }
+    return i;
+}
+
+OSS_TARGET("avx2")
+static __m256i enc_reshuffle(__m256i in) {
+    const __m128i s = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    in = _mm256_shuffle_epi8(in, _mm256_broadcastsi128_si256(s));
+    __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1, t3);
+}
+
+OSS_TARGET("avx2")
+static __m256i enc_translate(__m256i idx) {
+    const __m128i s = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                    '/' - 63, 'A', 0, 0);
+    __m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx);
+    r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(s), r), idx);
+}
+
+// 24 bytes in, 32 chars out; reads 28 (12 per lane, second lane loaded at +12)
+OSS_TARGET("avx2")
+static size_t encode_avx2(const uint8_t* in, size_t len, char* out) {
+    size_t i = 0;
+    for (; i + 28 <= len; i += 24, out += 32) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), enc_translate(enc_reshuffle(v)));
+    }
+    return i;
+}
+
+// Validates 16 chars and turns them into 6-bit values; false if any is not in the alphabet
+OSS_TARGET("ssse3")
+static bool dec_translate(__m128i& v) {
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                         0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2f);
+
+    __m128i hi_nib = _mm_and_si128(_mm_srli_epi32(v, 4), mask_2f);
+    __m128i lo_nib = _mm_and_si128(v, mask_2f);
+    __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nib);
+    __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nib);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0)
+        return false;
+    __m128i eq_2f = _mm_cmpeq_epi8(v, mask_2f);
+    v = _mm_add_epi8(v, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nib)));
+    return true;
+}
+
+OSS_TARGET("ssse3")
+static __m128i dec_pack(__m128i v) {
+    __m128i ab_bc = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    __m128i abc = _mm_madd_epi16(ab_bc, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(abc, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+// 16 chars in, 12 bytes out; writes 16, so it stops 32 chars short of the end
+OSS_TARGET("ssse3")
+static size_t decode_ssse3(const char* in, size_t len, uint8_t* out, size_t& produced) {
+    size_t i = 0;
+    produced = 0;
+    for (; i + 32 <= len; i += 16, produced += 12) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        if (!dec_translate(v)) break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + produced), dec_pack(v));
+    }
+    return i;
+}
+
+OSS_TARGET("avx2")
+static bool dec_translate(__m256i& v) {
+    const __m256i lut_lo = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+    const __m256i lut_hi = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+    const __m256i lut_roll = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+
+    __m256i hi_nib = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask_2f);
+    __m256i lo_nib = _mm256_and_si256(v, mask_2f);
+    __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nib);
+    __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nib);
+    if (!_mm256_testz_si256(lo, hi)) return false;
+    __m256i eq_2f = _mm256_cmpeq_epi8(v, mask_2f);
+    v = _mm256_add_epi8(v, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nib)));
+    return true;
+}
+
+OSS_TARGET("avx2")
+static __m256i dec_pack(__m256i v) {
+    __m256i ab_bc = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+    __m256i abc = _mm256_madd_epi16(ab_bc, _mm256_set1_epi32(0x00011000));
+    abc = _mm256_shuffle_epi8(abc, _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+    return _mm256_permutevar8x32_epi32(abc, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+}
+
+// 32 chars in, 24 bytes out; writes 32, so it stops 64 chars short of the end
+OSS_TARGET("avx2")
+static size_t decode_avx2(const char* in, size_t len, uint8_t* out, size_t& produced) {
+    size_t i = 0;
+    produced = 0;
+    for (; i + 64 <= len; i += 32, produced += 24) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        if (!dec_translate(v)) break;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + produced), dec_pack(v));
+    }
+    return i;
+}
+
+#endif // OSS_BASE64_X86
+
+// ── Dispatch ──
+
+static Base64::Kernel best_kernel() {
+#ifdef OSS_BASE64_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))  return Base64::Kernel::AVX2;
+    if (__builtin_cpu_supports("ssse3")) return Base64::Kernel::SSSE3;
+#endif
+    return Base64::Kernel::Scalar;
+}
+
+static std::atomic<Base64::Kernel>& active_kernel() {
+    static std::atomic<Base64::Kernel> kernel{best_kernel()};
+    return kernel;
+}
+
+Base64::Kernel Base64::kernel() {
+    return active_kernel().load(std::memory_order_relaxed);
+}
+
+const char* Base64::kernel_name(Kernel k) {
+    switch (k) {
+        case Kernel::Scalar: return "scalar";
+        case Kernel::SSSE3:  return "ssse3";
+        case Kernel::AVX2:   return "avx2";
+    }
+    return "scalar";
+}
+
+void Base64::set_kernel(Kernel k) {
+    active_kernel().store(std::min(k, best_kernel()), std::memory_order_relaxed);
+}
+
+// Returns input bytes consumed; `out` is advanced past what was written
+static size_t encode_bulk(Base64::Kernel k, const uint8_t* in, size_t len, char*& out) {
+    size_t done = 0;
+#ifdef OSS_BASE64_X86
+    if (k == Base64::Kernel::AVX2)  done = encode_avx2(in, len, out);
+    if (k >= Base64::Kernel::SSSE3) done += encode_ssse3(in + done, len - done, out + done / 3 * 4);
+#else
+    (void)k; (void)in; (void)len;
+#endif
+    out += done / 3 * 4;
+    return done;
+}
+
+static size_t decode_bulk(Base64::Kernel k, const char* in, size_t len, uint8_t* out, size_t& produced) {
+    produced = 0;
+#ifdef OSS_BASE64_X86
+    if (k == Base64::Kernel::AVX2)  return decode_avx2(in, len, out, produced);
+    if (k == Base64::Kernel::SSSE3) return decode_ssse3(in, len, out, produced);
+#else
+    (void)k; (void)in; (void)len; (void)out;
+#endif
+    return 0;
+}
+
+// ── Base64 ──
+
+size_t Base64::encode(ByteSpan in, char* out) {
+    char* p = out;
+    size_t done = encode_bulk(kernel(), in.data, in.size, p);
+    p += encode_scalar(in.data + done, in.size - done, p);
+    return static_cast<size_t>(p - out);
+}
+
+size_t Base64::decode(std::string_view in, uint8_t* out, Mode mode) {
+    const char* src = in.data();
+    const size_t n = in.size();
+    const bool strict = mode == Mode::Strict;
+    if (strict && n % 4 != 0) return npos;
+
+    const Kernel k = kernel();
+    size_t   i = 0, o = 0;
+    uint32_t quad = 0;
+    int      have = 0;   // sextets collected towards the current quad
+
+    while (i < n) {
+        if (have == 0 && k != Kernel::Scalar) {
+            size_t produced = 0;
+            i += decode_bulk(k, src + i, n - i, out + o, produced);
+            o += produced;
+            if (i >= n) break;
+        }
+
+        // Past whatever stopped the kernel (whitespace, padding, or the
+        // tail), then on to the next quad boundary so the kernel can resume
+        bool skipped = false;
+        while (i < n && (!skipped || have != 0)) {
+            uint8_t v = DECODE_TABLE[static_cast<uint8_t>(src[i])];
+            if (v < 64) {
+                quad = (quad << 6) | v;
+                if (++have == 4) {
+                    out[o++] = static_cast<uint8_t>(quad >> 16);
+                    out[o++] = static_cast<uint8_t>(quad >> 8);
+                    out[o++] = static_cast<uint8_t>(quad);
+                    quad = 0;
+                    have = 0;
+                }
+            } else if (strict) {
+                // Padding: one or two '=' closing the final quad, after at least two sextets
+                if (v != PAD || have < 2 || n - i != static_cast<size_t>(4 - have)) return npos;
+                for (size_t j = i; j < n; j++)
+                    if (src[j] != '=') return npos;
+                i = n;
+                break;
+            } else if (v == INVALID && mode != Mode::SkipInvalid) {
+                return npos;
+            } else {
+                skipped = true;
+            }
+            i++;
+        }
+    }
+
+    // Partial final quad: 2 sextets carry one byte, 3 carry two, 1 carries nothing
+    if (have == 1 && strict) return npos;
+    if (have >= 2) {
+        quad <<= 6 * (4 - have);
+        out[o++] = static_cast<uint8_t>(quad >> 16);
+        if (have == 3) out[o++] = static_cast<uint8_t>(quad >> 8);
+    }
+    return o;
+}
+
+std::string Base64::encode(ByteSpan in) {
+    std::string out(encoded_size(in.size), '\0');
+    encode(in, out.data());
+    return out;
+}
+
+std::vector<uint8_t> Base64::decode(std::string_view in, Mode mode) {
+    std::vector<uint8_t> out(decoded_size(in));
+    size_t len = decode(in, out.data(), mode);
+    if (len == npos) throw std::runtime_error("Invalid base64 input");
+    out.resize(len);
+    return out;
+}
+
+} // namespace oss
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "byte_span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oss {
+
+// Standard alphabet (RFC 4648 §4) codec. Bulk work runs in SSSE3 or AVX2
+// kernels picked once from CPUID; tails, and anything the kernels reject,
+// go through the scalar path, which decides validity.
+class Base64 {
+public:
+    enum class Mode {
+        Strict,      // length a multiple of 4, padding only at the end, nothing else
+        Lenient,     // whitespace and '=' ignored anywhere, padding optional
+        SkipInvalid  // as Lenient, and any other non-alphabet byte is skipped too
+    };
+
+    enum class Kernel { Scalar, SSSE3, AVX2 };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    static size_t encoded_size(size_t len) { return (len + 2) / 3 * 4; }
+    // Room decode() needs; exact unless the input has whitespace or stray padding
+    static size_t decoded_size(std::string_view in) {
+        size_t n = in.size();
+        for (int pad = 0; pad < 2 && n > 0 && in[n - 1] == '='; pad++) n--;
+        return n / 4 * 3 + (n % 4) * 3 / 4;
+    }
+
+    // Writes exactly encoded_size(in.size) chars and returns that count
+    static size_t encode(ByteSpan in, char* out);
+    // `out` needs decoded_size(in) bytes; returns bytes written, or npos if invalid
+    static size_t decode(std::string_view in, uint8_t* out, Mode mode = Mode::Strict);
+
+    static std::string encode(ByteSpan in);
+    // Throws std::runtime_error on invalid input
+    static std::vector<uint8_t> decode(std::string_view in, Mode mode = Mode::Strict);
+
+    static Kernel      kernel();
+    static const char* kernel_name(Kernel k);
+    // Forces a kernel (clamped to what the CPU supports); for benchmarks
+    static void        set_kernel(Kernel k);
+};
+
+} // namespace oss
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oss {
+
+// Borrowed, read-only view of input bytes. Converts implicitly from the
+// containers callers already hold, so nothing is copied on the way in.
+struct ByteSpan {
+    const uint8_t* data = nullptr;
+    size_t         size = 0;
+
+    ByteSpan() = default;
+    ByteSpan(const void* d, size_t n) : data(static_cast<const uint8_t*>(d)), size(n) {}
+    ByteSpan(std::string_view s) : ByteSpan(s.data(), s.size()) {}
+    ByteSpan(const std::string& s) : ByteSpan(s.data(), s.size()) {}
+    ByteSpan(const std::vector<uint8_t>& v) : ByteSpan(v.data(), v.size()) {}
+    ByteSpan(const char* s) : ByteSpan(s, std::strlen(s)) {}
+};
+
+} // namespace oss
@@ -2,9 +2,18 @@
 
 #include <nlohmann/json.hpp>
 #include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <cstdlib>
 
 namespace oss {
@@ -12,6 +21,21 @@ namespace oss {
 using json = nlohmann::json;
 
 class Config {
+    using Resolver = std::function<std::shared_ptr<const void>(const json&)>;
+    using Listener = std::function<void(const void*)>;
+
+    // One per key handle. Every distinct value a key has published stays in
+    // `history` for the life of the process, so `current` never dangles and
+    // readers need neither a lock nor a reference count. A value seen before
+    // is reused, so a key only grows with the number of different settings
+    // it has held.
+    struct KeySlot {
+        json::json_pointer       ptr;
+        Resolver                 resolve;
+        std::atomic<const void*> current{nullptr};
+        std::vector<std::pair<json, std::shared_ptr<const void>>> history;  // guarded by mutex_
+    };
+
 public:
     static Config& instance() {
         static Config inst;
@@ -21,30 +45,122 @@ public:
     Config(const Config&)            = delete;
     Config& operator=(const Config&) = delete;
 
+    // Unregisters its on_change listener when destroyed. Destruction waits
+    // for a notification in progress, so the listener never runs afterwards.
+    class Subscription {
+    public:
+        Subscription() = default;
+        ~Subscription() { reset(); }
+
+        Subscription(Subscription&& other) noexcept : id_(std::exchange(other.id_, 0)) {}
+        Subscription& operator=(Subscription&& other) noexcept {
+            if (this != &other) {
+                reset();
+                id_ = std::exchange(other.id_, 0);
+            }
+            return *this;
+        }
+        Subscription(const Subscription&)            = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        void reset() {
+            if (id_) Config::instance().remove_listener(std::exchange(id_, 0));
+        }
+
+    private:
+        friend class Config;
+        explicit Subscription(uint64_t id) : id_(id) {}
+        uint64_t id_ = 0;
+    };
+
+    // Precompiled key: the path is parsed once and the value converted only
+    // when it changes, so get() is an atomic pointer load and a read. Scalars
+    // come back by value; anything else by a reference that stays valid for
+    // the life of the process.
+    //   static const auto kAutoInject = Config::key<bool>("executor.auto_inject");
+    template<typename T>
+    class Key {
+    public:
+        using Value = std::conditional_t<std::is_scalar_v<T>, T, const T&>;
+
+        Value get() const {
+            return *static_cast<const T*>(slot_->current.load(std::memory_order_acquire));
+        }
+
+        // Runs cb with the new value whenever a load/set changes this key,
+        // until the returned Subscription is destroyed. Calls are serialized
+        // and the last one always carries the current value, though racing
+        // publishes may repeat it.
+        [[nodiscard]] Subscription on_change(std::function<void(const T&)> cb) const {
+            const KeySlot* slot = slot_;
+            return Config::instance().add_listener(slot, [cb = std::move(cb)](const void* v) {
+                cb(*static_cast<const T*>(v));
+            });
+        }
+
+    private:
+        friend class Config;
+        explicit Key(const KeySlot* slot) : slot_(slot) {}
+        const KeySlot* slot_;
+    };
+
+    template<typename T>
+    static Key<T> key(const std::string& path, const T& default_val = T{}) {
+        auto resolve = [path, default_val](const json& data) -> std::shared_ptr<const void> {
+            return std::make_shared<const T>(lookup<T>(data, path, default_val));
+        };
+        return Key<T>(instance().register_key(path, std::move(resolve)));
+    }
+
     bool load(const std::string& path) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
         path_ = path;
+        bool ok = true;
 
         try {
             if (!std::filesystem::exists(path)) {
                 data_ = get_defaults();
                 save_internal();
-                return true;
-            }
-
-            std::ifstream f(path);
-            if (!f.is_open()) return false;
-
-            data_ = json::parse(f, nullptr, true, true);
+            } else {
+                std::ifstream f(path);
+                if (!f.is_open()) return false;
 
-            auto defaults = get_defaults();
-            merge_defaults(data_, defaults);
+                data_ = json::parse(f, nullptr, true, true);
 
-            return true;
+                auto defaults = get_defaults();
+                merge_defaults(data_, defaults);
+            }
         } catch (const std::exception&) {
             data_ = get_defaults();
+            ok = false;
+        }
+        publish(lock);
+        return ok;
+    }
+
+    // Re-reads the last loaded file, e.g. after an external edit. Unlike
+    // load(), a parse failure (often a half-saved file) keeps the current
+    // values; an unchanged file publishes nothing and fires no listeners.
+    bool reload() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (path_.empty()) return false;
+        try {
+            std::ifstream f(path_);
+            if (!f.is_open()) return false;
+            json next = json::parse(f, nullptr, true, true);
+            merge_defaults(next, get_defaults());
+            if (next == data_) return true;
+            data_ = std::move(next);
+        } catch (const std::exception&) {
             return false;
         }
+        publish(lock);
+        return true;
+    }
+
+    std::string path() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return path_;
     }
 
     bool save() {
@@ -52,23 +168,20 @@ public:
         return save_internal();
     }
 
+    // Ad-hoc lookup under the config lock, parsing the path on every call.
+    // Prefer a Key for anything read more than once.
     template<typename T>
     T get(const std::string& key, const T& default_val = T{}) const {
         std::lock_guard<std::mutex> lock(mutex_);
-        try {
-            auto ptr = json::json_pointer("/" + replace_dots(key));
-            if (data_.contains(ptr)) {
-                return data_.at(ptr).get<T>();
-            }
-        } catch (...) {}
-        return default_val;
+        return lookup<T>(data_, key, default_val);
     }
 
     template<typename T>
     void set(const std::string& key, const T& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_lock<std::mutex> lock(mutex_);
         auto ptr = json::json_pointer("/" + replace_dots(key));
         data_[ptr] = value;
+        publish(lock);
     }
 
     json raw() const {
@@ -86,6 +199,13 @@ public:
     }
 
 private:
+    struct ListenerEntry {
+        uint64_t       id;
+        const KeySlot* slot;
+        Listener       cb;
+        bool           active = true;  // cleared under notify_mutex_
+    };
+
     Config() {
         auto home = home_dir();
         try {
@@ -99,7 +219,97 @@ private:
         }
     }
 
-    std::string replace_dots(const std::string& key) const {
+    template<typename T>
+    static T lookup(const json& data, const std::string& key, const T& default_val) {
+        try {
+            auto ptr = json::json_pointer("/" + replace_dots(key));
+            if (data.contains(ptr)) {
+                return data.at(ptr).get<T>();
+            }
+        } catch (...) {}
+        return default_val;
+    }
+
+    const KeySlot* register_key(const std::string& key, Resolver resolve) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto slot = std::make_unique<KeySlot>();
+        slot->ptr     = json::json_pointer("/" + replace_dots(key));
+        slot->resolve = std::move(resolve);
+        store_value(*slot, data_);
+        keys_.push_back(std::move(slot));
+        return keys_.back().get();
+    }
+
+    Subscription add_listener(const KeySlot* slot, Listener cb) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t id = next_listener_id_++;
+        listeners_.push_back(std::make_shared<ListenerEntry>(ListenerEntry{id, slot, std::move(cb)}));
+        return Subscription(id);
+    }
+
+    // Taking notify_mutex_ first waits out a notification in progress;
+    // recursive, so a listener may drop its own subscription
+    void remove_listener(uint64_t id) {
+        std::lock_guard<std::recursive_mutex> notify(notify_mutex_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = listeners_.begin(); it != listeners_.end(); ++it) {
+            if ((*it)->id != id) continue;
+            (*it)->active = false;
+            listeners_.erase(it);
+            return;
+        }
+    }
+
+    // Caller holds mutex_
+    static void store_value(KeySlot& slot, const json& data) {
+        const json* j = find(data, slot.ptr);
+        json raw = j ? *j : json();
+        auto it = std::find_if(slot.history.begin(), slot.history.end(),
+                               [&](const auto& h) { return h.first == raw; });
+        if (it == slot.history.end()) {
+            slot.history.emplace_back(std::move(raw), slot.resolve(data));
+            it = std::prev(slot.history.end());
+        }
+        slot.current.store(it->second.get(), std::memory_order_release);
+    }
+
+    static const json* find(const json& data, const json::json_pointer& ptr) {
+        try {
+            return data.contains(ptr) ? &data.at(ptr) : nullptr;
+        } catch (...) {
+            return nullptr;
+        }
+    }
+
+    // Re-resolves the keys whose JSON changed since the last publish, then
+    // fires their listeners. Listeners run after the lock is released, one
+    // publish at a time; racing publishes can get there in either order, so
+    // each hands out the key's current value rather than its own.
+    void publish(std::unique_lock<std::mutex>& lock) {
+        std::vector<const KeySlot*> changed;
+        for (auto& slot : keys_) {
+            const json* a = find(published_, slot->ptr);
+            const json* b = find(data_, slot->ptr);
+            if ((a == nullptr) == (b == nullptr) && (!a || *a == *b)) continue;
+            store_value(*slot, data_);
+            changed.push_back(slot.get());
+        }
+        published_ = data_;
+
+        std::vector<std::shared_ptr<ListenerEntry>> fire;
+        for (const auto& l : listeners_)
+            if (std::find(changed.begin(), changed.end(), l->slot) != changed.end())
+                fire.push_back(l);
+        lock.unlock();
+        if (fire.empty()) return;
+
+        // Recursive: a listener may itself set() a key
+        std::lock_guard<std::recursive_mutex> notify(notify_mutex_);
+        for (const auto& l : fire)
+            if (l->active) l->cb(l->slot->current.load(std::memory_order_acquire));
+    }
+
+    static std::string replace_dots(const std::string& key) {
         std::string result = key;
         for (auto& c : result) {
             if (c == '.') c = '/';
@@ -163,8 +373,14 @@ private:
     }
 
     json data_;
+    json published_;  // data_ as of the last publish
     std::string path_;
     mutable std::mutex mutex_;
+
+    std::recursive_mutex                         notify_mutex_;
+    std::vector<std::unique_ptr<KeySlot>>        keys_;
+    std::vector<std::shared_ptr<ListenerEntry>>  listeners_;
+    uint64_t                                     next_listener_id_ = 1;
 };
 
 } // namespace oss
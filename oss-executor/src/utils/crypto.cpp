@@ -1 +1,363 @@
-﻿#include "crypto.hpp"
\ No newline at end of file
+﻿#include "crypto.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace oss {
+
+// ── Context pools ──
+// Allocating and freeing an EVP context per call dominates small hashes, so
+// each thread keeps a few reset contexts around for the next Hasher/AesCipher.
+
+static constexpr size_t POOL_LIMIT = 8;
+
+namespace {
+
+template <typename Ctx, Ctx* (*New)(), void (*Free)(Ctx*)>
+struct ContextPool {
+    std::vector<Ctx*> free_list;
+
+    ~ContextPool() {
+        for (Ctx* c : free_list) Free(c);
+    }
+
+    Ctx* acquire() {
+        if (free_list.empty()) {
+            Ctx* c = New();
+            if (!c) throw std::runtime_error("Failed to allocate crypto context");
+            return c;
+        }
+        Ctx* c = free_list.back();
+        free_list.pop_back();
+        return c;
+    }
+
+    void release(Ctx* c, int (*reset)(Ctx*)) {
+        if (!c) return;
+        if (free_list.size() < POOL_LIMIT && reset(c) == 1) free_list.push_back(c);
+        else Free(c);
+    }
+};
+
+using MdPool     = ContextPool<EVP_MD_CTX, EVP_MD_CTX_new, EVP_MD_CTX_free>;
+using CipherPool = ContextPool<EVP_CIPHER_CTX, EVP_CIPHER_CTX_new, EVP_CIPHER_CTX_free>;
+
+thread_local MdPool     t_md_pool;
+thread_local CipherPool t_cipher_pool;
+
+// Returns a context to its pool if the constructor that acquired it throws;
+// the destructor that would otherwise release it never runs
+template <typename Pool, typename Ctx, int (*Reset)(Ctx*)>
+struct ConstructGuard {
+    Pool& pool;
+    Ctx*  ctx;
+
+    ~ConstructGuard() { pool.release(ctx, Reset); }
+    void dismiss() { ctx = nullptr; }
+};
+
+using MdGuard     = ConstructGuard<MdPool, EVP_MD_CTX, EVP_MD_CTX_reset>;
+using CipherGuard = ConstructGuard<CipherPool, EVP_CIPHER_CTX, EVP_CIPHER_CTX_reset>;
+
+} // namespace
+
+// OpenSSL 3 re-fetches the provider implementation on every init when handed
+// the legacy EVP_sha256()-style objects; fetching once keeps init cheap.
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+static const EVP_MD* fetch_md(const char* name) {
+    EVP_MD* md = EVP_MD_fetch(nullptr, name, nullptr);
+    if (!md) throw std::runtime_error(std::string("Digest unavailable: ") + name);
+    return md;
+}
+
+static const EVP_CIPHER* aes_256_cbc() {
+    static const EVP_CIPHER* cipher = EVP_CIPHER_fetch(nullptr, "AES-256-CBC", nullptr);
+    if (!cipher) throw std::runtime_error("AES-256-CBC unavailable");
+    return cipher;
+}
+#else
+static const EVP_CIPHER* aes_256_cbc() { return EVP_aes_256_cbc(); }
+#endif
+
+// ── Crypto ──
+
+HashAlgorithm Crypto::parse_algorithm(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "sha256" || lower == "sha-256") return HashAlgorithm::SHA256;
+    if (lower == "sha384" || lower == "sha-384") return HashAlgorithm::SHA384;
+    if (lower == "sha512" || lower == "sha-512") return HashAlgorithm::SHA512;
+    if (lower == "sha1"   || lower == "sha-1")   return HashAlgorithm::SHA1;
+    if (lower == "md5")                          return HashAlgorithm::MD5;
+    throw std::runtime_error("Unsupported hash algorithm: " + name);
+}
+
+const EVP_MD* Crypto::get_evp_md(HashAlgorithm algo) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    static const EVP_MD* sha256 = fetch_md("SHA256");
+    switch (algo) {
+        case HashAlgorithm::SHA256: return sha256;
+        case HashAlgorithm::SHA384: { static const EVP_MD* md = fetch_md("SHA384"); return md; }
+        case HashAlgorithm::SHA512: { static const EVP_MD* md = fetch_md("SHA512"); return md; }
+        case HashAlgorithm::SHA1:   { static const EVP_MD* md = fetch_md("SHA1");   return md; }
+        case HashAlgorithm::MD5:    { static const EVP_MD* md = fetch_md("MD5");    return md; }
+    }
+    return sha256;
+#else
+    switch (algo) {
+        case HashAlgorithm::SHA256: return EVP_sha256();
+        case HashAlgorithm::SHA384: return EVP_sha384();
+        case HashAlgorithm::SHA512: return EVP_sha512();
+        case HashAlgorithm::SHA1:   return EVP_sha1();
+        case HashAlgorithm::MD5:    return EVP_md5();
+    }
+    return EVP_sha256();
+#endif
+}
+
+std::string Crypto::hash(ByteSpan input, HashAlgorithm algo) {
+    return Hasher(algo).update(input).final_hex();
+}
+
+std::string Crypto::hmac(ByteSpan input, ByteSpan key, HashAlgorithm algo) {
+    return Hasher(algo, key).update(input).final_hex();
+}
+
+std::string Crypto::hash_file(const std::string& path, HashAlgorithm algo) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::runtime_error("Cannot open file: " + path);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    static constexpr size_t CHUNK = 1 << 20;
+    std::unique_ptr<uint8_t[]> buf(new uint8_t[CHUNK]);
+    Hasher hasher(algo);
+    for (;;) {
+        ssize_t n = ::read(fd, buf.get(), CHUNK);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ::close(fd);
+            throw std::runtime_error("Read failed: " + path);
+        }
+        if (n == 0) break;
+        hasher.update(ByteSpan(buf.get(), static_cast<size_t>(n)));
+    }
+    ::close(fd);
+    return hasher.final_hex();
+}
+
+std::vector<uint8_t> Crypto::encrypt_aes256(ByteSpan plaintext, ByteSpan key) {
+    uint8_t iv[AesCipher::BLOCK_SIZE];
+    if (RAND_bytes(iv, sizeof(iv)) != 1)
+        throw std::runtime_error("Failed to generate IV");
+
+    AesCipher cipher(AesCipher::Direction::Encrypt, key, ByteSpan(iv, sizeof(iv)));
+    std::vector<uint8_t> out(sizeof(iv) + plaintext.size + AesCipher::BLOCK_SIZE);
+    std::memcpy(out.data(), iv, sizeof(iv));
+    size_t total = sizeof(iv);
+    total += cipher.update(plaintext, out.data() + total);
+    total += cipher.final(out.data() + total);
+    out.resize(total);
+    return out;
+}
+
+std::vector<uint8_t> Crypto::decrypt_aes256(ByteSpan ciphertext, ByteSpan key) {
+    if (ciphertext.size < AesCipher::BLOCK_SIZE + 1)
+        throw std::runtime_error("Invalid ciphertext: too short");
+
+    ByteSpan iv(ciphertext.data, AesCipher::BLOCK_SIZE);
+    ByteSpan body(ciphertext.data + AesCipher::BLOCK_SIZE, ciphertext.size - AesCipher::BLOCK_SIZE);
+    AesCipher cipher(AesCipher::Direction::Decrypt, key, iv);
+    std::vector<uint8_t> out(body.size + AesCipher::BLOCK_SIZE);
+    size_t total = cipher.update(body, out.data());
+    total += cipher.final(out.data() + total);
+    out.resize(total);
+    return out;
+}
+
+// ── Hex ──
+
+static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+static const std::array<int8_t, 256> HEX_VALUES = [] {
+    std::array<int8_t, 256> t{};
+    t.fill(-1);
+    for (int i = 0; i < 10; i++) t['0' + i] = static_cast<int8_t>(i);
+    for (int i = 0; i < 6; i++) {
+        t['a' + i] = static_cast<int8_t>(10 + i);
+        t['A' + i] = static_cast<int8_t>(10 + i);
+    }
+    return t;
+}();
+
+std::string Crypto::bytes_to_hex(const unsigned char* data, size_t len) {
+    std::string out(len * 2, '\0');
+    char* p = out.data();
+    for (size_t i = 0; i < len; i++) {
+        *p++ = HEX_DIGITS[data[i] >> 4];
+        *p++ = HEX_DIGITS[data[i] & 0x0F];
+    }
+    return out;
+}
+
+std::vector<uint8_t> Crypto::hex_to_bytes(std::string_view hex) {
+    if (hex.size() % 2 != 0)
+        throw std::runtime_error("Invalid hex string: odd length");
+
+    std::vector<uint8_t> out(hex.size() / 2);
+    for (size_t i = 0; i < out.size(); i++) {
+        int hi = HEX_VALUES[static_cast<unsigned char>(hex[2 * i])];
+        int lo = HEX_VALUES[static_cast<unsigned char>(hex[2 * i + 1])];
+        if ((hi | lo) < 0) throw std::runtime_error("Invalid hex string: bad digit");
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return out;
+}
+
+// ── Hasher ──
+
+Hasher::Hasher(HashAlgorithm algo) : algo_(algo), ctx_(t_md_pool.acquire()) {
+    MdGuard guard{t_md_pool, ctx_};
+    reset();
+    guard.dismiss();
+}
+
+// HMAC is done by hand over the same digest context (RFC 2104): the EVP_PKEY
+// route costs a key object and a PKEY_CTX per message, which dwarfs the
+// two extra compressions for short inputs.
+Hasher::Hasher(HashAlgorithm algo, ByteSpan hmac_key) : algo_(algo), ctx_(t_md_pool.acquire()) {
+    MdGuard guard{t_md_pool, ctx_};
+    const EVP_MD* md = Crypto::get_evp_md(algo);
+    size_t block = static_cast<size_t>(EVP_MD_block_size(md));
+    ipad_.assign(block, 0);
+    if (hmac_key.size > block) {
+        unsigned int n = 0;
+        if (EVP_DigestInit_ex(ctx_, md, nullptr) != 1 ||
+            EVP_DigestUpdate(ctx_, hmac_key.data, hmac_key.size) != 1 ||
+            EVP_DigestFinal_ex(ctx_, ipad_.data(), &n) != 1)
+            throw std::runtime_error("Failed to hash HMAC key");
+    } else if (hmac_key.size) {
+        std::memcpy(ipad_.data(), hmac_key.data, hmac_key.size);
+    }
+    for (auto& b : ipad_) b ^= 0x36;
+    reset();
+    guard.dismiss();
+}
+
+Hasher::~Hasher() {
+    t_md_pool.release(ctx_, EVP_MD_CTX_reset);
+}
+
+Hasher::Hasher(Hasher&& other) noexcept
+    : algo_(other.algo_), ctx_(other.ctx_), ipad_(std::move(other.ipad_)) {
+    other.ctx_ = nullptr;
+}
+
+Hasher& Hasher::operator=(Hasher&& other) noexcept {
+    if (this != &other) {
+        std::swap(algo_, other.algo_);
+        std::swap(ctx_, other.ctx_);
+        std::swap(ipad_, other.ipad_);
+    }
+    return *this;
+}
+
+void Hasher::reset() {
+    if (EVP_DigestInit_ex(ctx_, Crypto::get_evp_md(algo_), nullptr) != 1)
+        throw std::runtime_error("Failed to init digest");
+    if (!ipad_.empty() && EVP_DigestUpdate(ctx_, ipad_.data(), ipad_.size()) != 1)
+        throw std::runtime_error("Failed to update digest");
+}
+
+Hasher& Hasher::update(ByteSpan data) {
+    if (!ctx_) throw std::runtime_error("Hasher used after move");
+    if (data.size && EVP_DigestUpdate(ctx_, data.data, data.size) != 1)
+        throw std::runtime_error("Failed to update digest");
+    return *this;
+}
+
+size_t Hasher::final(uint8_t* out) {
+    if (!ctx_) throw std::runtime_error("Hasher used after move");
+    unsigned int len = 0;
+    if (EVP_DigestFinal_ex(ctx_, out, &len) != 1)
+        throw std::runtime_error("Failed to finalize digest");
+
+    if (!ipad_.empty()) {
+        // Outer hash: (K ^ opad) || inner, with opad = ipad ^ (0x36 ^ 0x5c)
+        uint8_t opad[EVP_MAX_MD_SIZE * 2];
+        for (size_t i = 0; i < ipad_.size(); i++) opad[i] = ipad_[i] ^ (0x36 ^ 0x5c);
+        if (EVP_DigestInit_ex(ctx_, Crypto::get_evp_md(algo_), nullptr) != 1 ||
+            EVP_DigestUpdate(ctx_, opad, ipad_.size()) != 1 ||
+            EVP_DigestUpdate(ctx_, out, len) != 1 ||
+            EVP_DigestFinal_ex(ctx_, out, &len) != 1)
+            throw std::runtime_error("Failed to finalize HMAC");
+    }
+    reset();
+    return len;
+}
+
+std::string Hasher::final_hex() {
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    size_t len = final(digest);
+    return Crypto::bytes_to_hex(digest, len);
+}
+
+std::vector<uint8_t> Hasher::final_bytes() {
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    size_t len = final(digest);
+    return std::vector<uint8_t>(digest, digest + len);
+}
+
+size_t Hasher::digest_size() const {
+    return static_cast<size_t>(EVP_MD_size(Crypto::get_evp_md(algo_)));
+}
+
+// ── AesCipher ──
+
+AesCipher::AesCipher(Direction dir, ByteSpan key, ByteSpan iv) {
+    if (key.size != KEY_SIZE)
+        throw std::runtime_error("AES-256 requires a 32-byte key");
+    if (iv.size != BLOCK_SIZE)
+        throw std::runtime_error("AES-256-CBC requires a 16-byte IV");
+
+    ctx_ = t_cipher_pool.acquire();
+    CipherGuard guard{t_cipher_pool, ctx_};
+    if (EVP_CipherInit_ex(ctx_, aes_256_cbc(), nullptr, key.data, iv.data,
+                          dir == Direction::Encrypt ? 1 : 0) != 1)
+        throw std::runtime_error(dir == Direction::Encrypt ? "Failed to init encryption"
+                                                           : "Failed to init decryption");
+    guard.dismiss();
+}
+
+AesCipher::~AesCipher() {
+    t_cipher_pool.release(ctx_, EVP_CIPHER_CTX_reset);
+}
+
+size_t AesCipher::update(ByteSpan in, uint8_t* out) {
+    // EVP lengths are int; feed oversized inputs in block-aligned pieces
+    static constexpr size_t MAX_PIECE = (INT_MAX / 2) & ~(BLOCK_SIZE - 1);
+    size_t total = 0;
+    for (size_t off = 0; off < in.size;) {
+        size_t piece = std::min(in.size - off, MAX_PIECE);
+        int len = 0;
+        if (EVP_CipherUpdate(ctx_, out + total, &len, in.data + off, static_cast<int>(piece)) != 1)
+            throw std::runtime_error("Cipher update failed");
+        total += static_cast<size_t>(len);
+        off += piece;
+    }
+    return total;
+}
+
+size_t AesCipher::final(uint8_t* out) {
+    int len = 0;
+    if (EVP_CipherFinal_ex(ctx_, out, &len) != 1)
+        throw std::runtime_error("Cipher finalization failed (bad key or corrupted data)");
+    return static_cast<size_t>(len);
+}
+
+} // namespace oss
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#endif
+
+namespace oss {
+
+// Cheapest monotonic tick source for hot-path timing: the TSC on x86, the
+// virtual counter on aarch64, steady_clock nanoseconds elsewhere. Ticks only
+// mean something as differences; to_ns() converts them.
+class CycleClock {
+public:
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static double to_ns(uint64_t ticks) { return static_cast<double>(ticks) * ns_per_tick(); }
+
+private:
+    // The x86 rate is measured once against steady_clock over ~2ms
+    static double ns_per_tick() {
+        static const double rate = [] {
+#if defined(__x86_64__) || defined(__i386__)
+            using Clock = std::chrono::steady_clock;
+            auto     t0 = Clock::now();
+            uint64_t c0 = now();
+            while (Clock::now() - t0 < std::chrono::milliseconds(2)) {}
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+            uint64_t ticks = now() - c0;
+            return ticks ? ns / static_cast<double>(ticks) : 1.0;
+#elif defined(__aarch64__)
+            uint64_t freq;
+            asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+            return freq ? 1e9 / static_cast<double>(freq) : 1.0;
+#else
+            return 1.0;
+#endif
+        }();
+        return rate;
+    }
+};
+
+} // namespace oss
@@ -0,0 +1,204 @@
+#include "file_watcher.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <map>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace oss {
+
+static constexpr uint32_t WATCH_MASK =
+    IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF | IN_ONLYDIR;
+
+// After the first event, keep collecting until the directory has been quiet
+// this long (bounded by COALESCE_MAX_MS) so a save-all or git checkout is one batch
+static constexpr int COALESCE_QUIET_MS = 50;
+static constexpr int COALESCE_MAX_MS   = 500;
+
+// How often a deleted directory is checked for having come back
+static constexpr int REWATCH_MS = 1000;
+
+static thread_local bool t_watcher_thread = false;
+
+FileWatcher& FileWatcher::instance() {
+    static FileWatcher inst;
+    return inst;
+}
+
+bool FileWatcher::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_.load(std::memory_order_acquire)) return true;
+
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        LOG_WARN("inotify unavailable ({}); hot reload disabled", strerror(errno));
+        return false;
+    }
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        ::close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+
+    // Watches registered before start() get their descriptors now
+    for (auto& w : watches_)
+        w.wd = inotify_add_watch(inotify_fd_, w.dir.c_str(), WATCH_MASK);
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&FileWatcher::run, this);
+    LOG_INFO("File watcher started ({} directories)", watches_.size());
+    return true;
+}
+
+void FileWatcher::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+    uint64_t one = 1;
+    if (::write(wake_fd_, &one, sizeof(one)) < 0) {}
+    if (thread_.joinable()) thread_.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ::close(inotify_fd_);
+    ::close(wake_fd_);
+    inotify_fd_ = wake_fd_ = -1;
+    for (auto& w : watches_) w.wd = -1;
+}
+
+int FileWatcher::watch(const std::string& dir, Callback cb) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int wd = -1;
+    if (inotify_fd_ >= 0) {
+        wd = inotify_add_watch(inotify_fd_, dir.c_str(), WATCH_MASK);
+        if (wd < 0) {
+            LOG_WARN("Cannot watch {}: {}", dir, strerror(errno));
+            return -1;
+        }
+    }
+    int id = next_id_++;
+    watches_.push_back({id, wd, dir, std::move(cb)});
+    return id;
+}
+
+void FileWatcher::unwatch(int id) {
+    std::unique_lock<std::mutex> dispatch(dispatch_mutex_, std::defer_lock);
+    if (!t_watcher_thread) dispatch.lock();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(watches_.begin(), watches_.end(),
+                           [id](const Watch& w) { return w.id == id; });
+    if (it == watches_.end()) return;
+    int wd = it->wd;
+    watches_.erase(it);
+
+    // inotify hands out one descriptor per inode, so it may be shared
+    bool shared = std::any_of(watches_.begin(), watches_.end(),
+                              [wd](const Watch& w) { return w.wd == wd; });
+    if (wd >= 0 && !shared && inotify_fd_ >= 0) inotify_rm_watch(inotify_fd_, wd);
+}
+
+// Reads everything currently queued; false once the fd has nothing left
+bool FileWatcher::drain(std::vector<std::pair<int, FileEvent>>& out) {
+    alignas(struct inotify_event) char buf[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+    ssize_t n = ::read(inotify_fd_, buf, sizeof(buf));
+    if (n <= 0) return false;
+
+    for (char* p = buf; p < buf + n;) {
+        auto* ev = reinterpret_cast<struct inotify_event*>(p);
+        p += sizeof(struct inotify_event) + ev->len;
+
+        if (ev->mask & IN_Q_OVERFLOW) {
+            out.push_back({-1, FileEvent{{}, {}, FileChange::Rescan}});
+            continue;
+        }
+        // Re-added by run() once the directory is back
+        if (ev->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& w : watches_)
+                if (w.wd == ev->wd) w.wd = -1;
+            continue;
+        }
+        if (ev->len == 0 || (ev->mask & IN_ISDIR)) continue;
+
+        FileChange change = (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+                                ? FileChange::Removed : FileChange::Written;
+        out.push_back({ev->wd, FileEvent{{}, ev->name, change}});
+    }
+    return true;
+}
+
+void FileWatcher::run() {
+    t_watcher_thread = true;
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+
+    while (running_.load(std::memory_order_acquire)) {
+        int timeout = -1;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (std::any_of(watches_.begin(), watches_.end(),
+                            [](const Watch& w) { return w.wd < 0; }))
+                timeout = REWATCH_MS;
+        }
+        if (::poll(fds, 2, timeout) < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("File watcher poll failed: {}", strerror(errno));
+            break;
+        }
+        if (fds[1].revents & POLLIN) break;
+
+        std::vector<std::pair<int, FileEvent>> raw;
+        if (fds[0].revents & POLLIN) {
+            while (drain(raw)) {}
+            for (int waited = 0; waited < COALESCE_MAX_MS; waited += COALESCE_QUIET_MS) {
+                pollfd quiet = {inotify_fd_, POLLIN, 0};
+                if (::poll(&quiet, 1, COALESCE_QUIET_MS) <= 0) break;
+                while (drain(raw)) {}
+            }
+        }
+
+        // Last change per (descriptor, name) wins; an overflow means every
+        // watch may have missed something
+        bool overflow = false;
+        std::map<std::pair<int, std::string>, FileChange> latest;
+        for (auto& [wd, ev] : raw) {
+            if (ev.change == FileChange::Rescan) overflow = true;
+            else latest[{wd, ev.name}] = ev.change;
+        }
+        if (overflow) LOG_WARN("inotify queue overflowed; rescanning watched directories");
+
+        // Held across the callbacks so unwatch() can wait them out
+        std::lock_guard<std::mutex> dispatch(dispatch_mutex_);
+        std::vector<std::pair<Callback, std::vector<FileEvent>>> batches;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& w : watches_) {
+                std::vector<FileEvent> events;
+                if (w.wd < 0) {
+                    w.wd = inotify_add_watch(inotify_fd_, w.dir.c_str(), WATCH_MASK);
+                    if (w.wd < 0) continue;
+                    LOG_INFO("Watching {} again", w.dir);
+                    events.push_back({w.dir, {}, FileChange::Rescan});
+                } else if (overflow) {
+                    events.push_back({w.dir, {}, FileChange::Rescan});
+                } else {
+                    for (const auto& [key, change] : latest)
+                        if (key.first == w.wd) events.push_back({w.dir, key.second, change});
+                }
+                if (!events.empty()) batches.emplace_back(w.cb, std::move(events));
+            }
+        }
+        for (auto& [cb, events] : batches) {
+            try {
+                cb(events);
+            } catch (const std::exception& e) {
+                LOG_ERROR("File watch callback for {} threw: {}", events.front().dir, e.what());
+            }
+        }
+    }
+}
+
+} // namespace oss
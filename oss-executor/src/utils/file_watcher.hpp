@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace oss {
+
+// Rescan: events were lost (queue overflow) or the directory itself was
+// replaced, so anything in it may have changed; name is empty.
+enum class FileChange { Written, Removed, Rescan };
+
+struct FileEvent {
+    std::string dir;    // watched directory, as passed to watch()
+    std::string name;   // entry within it; empty for Rescan
+    FileChange  change;
+
+    std::string path() const { return dir + "/" + name; }
+};
+
+// One inotify instance and one thread for every watched directory. Files are
+// reported once they are closed after writing or moved into place, so
+// consumers never see a half-written file. Events arriving close together
+// are coalesced per name and delivered as one batch per watch, on the
+// watcher thread. A watched directory that is deleted is re-watched once it
+// exists again.
+class FileWatcher {
+public:
+    using Callback = std::function<void(const std::vector<FileEvent>&)>;
+
+    static FileWatcher& instance();
+
+    FileWatcher(const FileWatcher&)            = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool start();
+    void stop();
+    bool running() const { return running_.load(std::memory_order_acquire); }
+
+    // Non-recursive; returns a watch id, or -1 if the directory can't be watched
+    int  watch(const std::string& dir, Callback cb);
+    // Once this returns the callback is not running and never runs again.
+    // Called from inside a callback it can't wait, and doesn't.
+    void unwatch(int id);
+
+private:
+    FileWatcher() = default;
+    ~FileWatcher() { stop(); }
+
+    struct Watch {
+        int         id;
+        int         wd;
+        std::string dir;
+        Callback    cb;
+    };
+
+    void run();
+    bool drain(std::vector<std::pair<int, FileEvent>>& out);
+
+    int inotify_fd_ = -1;
+    int wake_fd_    = -1;
+    std::thread       thread_;
+    std::atomic<bool> running_{false};
+
+    std::mutex         mutex_;
+    std::mutex         dispatch_mutex_;  // held while callbacks run
+    std::vector<Watch> watches_;
+    int                next_id_ = 1;
+};
+
+} // namespace oss
@@ -1,16 +1,45 @@
 #include "logger.hpp"
+#include "config.hpp"
 
 #include <spdlog/spdlog.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 
 #include <filesystem>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
 #include <vector>
 #include <memory>
 
 namespace oss {
 
+static constexpr std::size_t LOG_QUEUE_SIZE = 8192;
+
+// Named channels are created on first use and never freed; call sites cache
+// the reference in a function-local static.
+static std::mutex& channels_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+static std::map<std::string, std::unique_ptr<LogChannel>>& channels() {
+    static std::map<std::string, std::unique_ptr<LogChannel>> m;
+    return m;
+}
+
+static std::set<std::string>& explicit_levels() {
+    static std::set<std::string> m;
+    return m;
+}
+
+static std::atomic<int>& default_level() {
+    static std::atomic<int> level{SPDLOG_LEVEL_DEBUG};
+    return level;
+}
+
 bool Logger::init(const std::string& log_dir) {
     if (initialized_) return true;
 
@@ -50,8 +79,13 @@ bool Logger::init(const std::string& log_dir) {
                   << log_file.string() << "': " << e.what() << "\n";
     }
 
-    auto logger = std::make_shared<spdlog::logger>("oss", sinks.begin(), sinks.end());
-    logger->set_level(spdlog::level::debug);
+    // Level gating happens in the channels before formatting; the logger
+    // itself passes everything through to the queue.
+    spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+    auto logger = std::make_shared<spdlog::async_logger>(
+        "oss", sinks.begin(), sinks.end(), spdlog::thread_pool(),
+        spdlog::async_overflow_policy::overrun_oldest);
+    logger->set_level(spdlog::level::trace);
     logger->flush_on(spdlog::level::warn);
 
     spdlog::set_default_logger(logger);
@@ -69,6 +103,9 @@ bool Logger::init(const std::string& log_dir) {
 void Logger::shutdown() {
     if (!initialized_) return;
 
+    if (size_t lost = dropped())
+        std::cerr << "[logger] " << lost << " messages dropped (queue full)\n";
+
     spdlog::default_logger()->flush();
     spdlog::drop("oss");
     spdlog::shutdown();
@@ -80,4 +117,53 @@ bool Logger::initialized() {
     return initialized_;
 }
 
+void Logger::apply_config() {
+    auto& config = Config::instance();
+    auto level = spdlog::level::from_str(config.get<std::string>("logging.level", "debug"));
+    set_level("", level);
+
+    auto subsystems = config.get<json>("logging.subsystems", json::object());
+    if (!subsystems.is_object()) return;
+    for (auto it = subsystems.begin(); it != subsystems.end(); ++it) {
+        if (it.value().is_string())
+            set_level(it.key(), spdlog::level::from_str(it.value().get<std::string>()));
+    }
+}
+
+LogChannel& Logger::channel(const std::string& subsystem) {
+    if (subsystem.empty()) return root_;
+    std::lock_guard<std::mutex> lock(channels_mutex());
+    auto& slot = channels()[subsystem];
+    if (!slot) {
+        slot = std::make_unique<LogChannel>();
+        slot->level.store(default_level().load());
+    }
+    return *slot;
+}
+
+// Setting the root level also moves every subsystem that has not been given
+// its own level, so "logging.level" acts as the default for all of them.
+void Logger::set_level(const std::string& subsystem, spdlog::level::level_enum lvl) {
+    int value = static_cast<int>(lvl);
+    if (!subsystem.empty()) {
+        LogChannel& ch = channel(subsystem);
+        std::lock_guard<std::mutex> lock(channels_mutex());
+        ch.level.store(value);
+        explicit_levels().insert(subsystem);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(channels_mutex());
+    root_.level.store(value);
+    default_level().store(value);
+    for (auto& [name, ch] : channels()) {
+        if (!explicit_levels().count(name)) ch->level.store(value);
+    }
+}
+
+size_t Logger::dropped() {
+    auto pool = spdlog::thread_pool();
+    return pool ? pool->overrun_counter() : 0;
+}
+
 }
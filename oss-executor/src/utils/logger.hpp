@@ -1,23 +1,119 @@
 #pragma once
 
 #include <spdlog/spdlog.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <string>
 
+// Compile-time floor, in spdlog level numbers (0 trace .. 6 off). Calls below
+// it expand to nothing, arguments included. Release builds drop debug.
+#ifndef OSS_LOG_LEVEL
+#  ifdef NDEBUG
+#    define OSS_LOG_LEVEL SPDLOG_LEVEL_INFO
+#  else
+#    define OSS_LOG_LEVEL SPDLOG_LEVEL_DEBUG
+#  endif
+#endif
+
 namespace oss {
 
+// Runtime level gate for one subsystem. Checked before any formatting, so a
+// disabled call costs one relaxed load.
+struct LogChannel {
+    std::atomic<int> level{SPDLOG_LEVEL_DEBUG};
+
+    bool enabled(spdlog::level::level_enum lvl) const {
+        return static_cast<int>(lvl) >= level.load(std::memory_order_relaxed);
+    }
+};
+
+// Per-call-site limiter: lets one message through per interval and counts
+// the rest so the next emitted line can report them.
+struct LogRateLimit {
+    std::atomic<int64_t>  next_ns{0};
+    std::atomic<uint32_t> suppressed{0};
+
+    // Returns the number suppressed since the last emit, or -1 to drop this one
+    int64_t admit(int64_t interval_ms) {
+        int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t next = next_ns.load(std::memory_order_relaxed);
+        if (now < next || !next_ns.compare_exchange_strong(next, now + interval_ms * 1000000)) {
+            suppressed.fetch_add(1, std::memory_order_relaxed);
+            return -1;
+        }
+        return suppressed.exchange(0, std::memory_order_relaxed);
+    }
+};
+
 class Logger {
 public:
+    // Async logger: a bounded queue drained by one background thread. When
+    // the queue is full the oldest pending message is overwritten, so callers
+    // never block on the sinks.
     static bool init(const std::string& log_dir = ".");
     static void shutdown();
     static bool initialized();
 
+    // Applies "logging.level" and "logging.subsystems" {name: level} from Config
+    static void apply_config();
+
+    // Channel for LOG_* ("") or LOG_SUB_* (named); references stay valid forever
+    static LogChannel& channel(const std::string& subsystem);
+    static LogChannel& root() { return root_; }
+    static void set_level(const std::string& subsystem, spdlog::level::level_enum lvl);
+
+    // Messages overwritten because the queue was full
+    static size_t dropped();
+
 private:
-    static inline bool initialized_ = false;
+    static inline bool       initialized_ = false;
+    static inline LogChannel root_;
 };
 
 }
 
-#define LOG_DEBUG(...) spdlog::debug(__VA_ARGS__)
-#define LOG_INFO(...)  spdlog::info(__VA_ARGS__)
-#define LOG_WARN(...)  spdlog::warn(__VA_ARGS__)
-#define LOG_ERROR(...) spdlog::error(__VA_ARGS__)
+#define OSS_LOG_EMIT(ch, lvl, ...) \
+    do { if ((ch).enabled(lvl)) spdlog::default_logger_raw()->log(lvl, __VA_ARGS__); } while (0)
+
+#define OSS_LOG_SUB(sub, lvl, msg, ...) \
+    do { \
+        static ::oss::LogChannel& oss_log_ch_ = ::oss::Logger::channel(sub); \
+        OSS_LOG_EMIT(oss_log_ch_, lvl, "[" sub "] " msg __VA_OPT__(,) __VA_ARGS__); \
+    } while (0)
+
+#define OSS_LOG_EVERY(ms, lvl, ...) \
+    do { \
+        if (!::oss::Logger::root().enabled(lvl)) break; \
+        static ::oss::LogRateLimit oss_log_rl_; \
+        int64_t oss_log_n_ = oss_log_rl_.admit(ms); \
+        if (oss_log_n_ < 0) break; \
+        spdlog::default_logger_raw()->log(lvl, __VA_ARGS__); \
+        if (oss_log_n_ > 0) \
+            spdlog::default_logger_raw()->log(lvl, "  ({} similar messages suppressed)", oss_log_n_); \
+    } while (0)
+
+#if OSS_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+#  define LOG_DEBUG(...)               OSS_LOG_EMIT(::oss::Logger::root(), spdlog::level::debug, __VA_ARGS__)
+#  define LOG_SUB_DEBUG(sub, ...)      OSS_LOG_SUB(sub, spdlog::level::debug, __VA_ARGS__)
+#  define LOG_DEBUG_EVERY(ms, ...)     OSS_LOG_EVERY(ms, spdlog::level::debug, __VA_ARGS__)
+#else
+#  define LOG_DEBUG(...)               ((void)0)
+#  define LOG_SUB_DEBUG(sub, ...)      ((void)0)
+#  define LOG_DEBUG_EVERY(ms, ...)     ((void)0)
+#endif
+
+#if OSS_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+#  define LOG_INFO(...)                OSS_LOG_EMIT(::oss::Logger::root(), spdlog::level::info, __VA_ARGS__)
+#  define LOG_SUB_INFO(sub, ...)       OSS_LOG_SUB(sub, spdlog::level::info, __VA_ARGS__)
+#else
+#  define LOG_INFO(...)                ((void)0)
+#  define LOG_SUB_INFO(sub, ...)       ((void)0)
+#endif
+
+#define LOG_WARN(...)                  OSS_LOG_EMIT(::oss::Logger::root(), spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR(...)                 OSS_LOG_EMIT(::oss::Logger::root(), spdlog::level::err, __VA_ARGS__)
+#define LOG_SUB_WARN(sub, ...)         OSS_LOG_SUB(sub, spdlog::level::warn, __VA_ARGS__)
+#define LOG_SUB_ERROR(sub, ...)        OSS_LOG_SUB(sub, spdlog::level::err, __VA_ARGS__)
+#define LOG_WARN_EVERY(ms, ...)        OSS_LOG_EVERY(ms, spdlog::level::warn, __VA_ARGS__)
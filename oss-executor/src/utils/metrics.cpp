@@ -0,0 +1,194 @@
+#include "metrics.hpp"
+#include "logger.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace oss {
+
+// ── Histogram ──
+
+size_t Histogram::bucket_index(uint64_t value) {
+    if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+    // Highest set bit picks the power of two; the next SUB_BITS bits pick
+    // the linear sub-bucket inside it.
+    size_t msb = 63 - static_cast<size_t>(__builtin_clzll(value));
+    size_t shift = msb - SUB_BITS;
+    size_t sub = static_cast<size_t>(value >> shift) & (SUB_BUCKETS - 1);
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::bucket_upper(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    size_t shift = index / SUB_BUCKETS - 1;
+    uint64_t sub = index % SUB_BUCKETS;
+    uint64_t base = (SUB_BUCKETS + sub) << shift;
+    return base + ((uint64_t{1} << shift) - 1);
+}
+
+uint64_t Histogram::percentile(double p) const {
+    uint64_t total = count();
+    if (total == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) return bucket_upper(i);
+    }
+    return bucket_upper(BUCKETS - 1);
+}
+
+std::vector<std::pair<uint64_t, uint64_t>> Histogram::cumulative_pow2() const {
+    std::vector<std::pair<uint64_t, uint64_t>> out;
+    uint64_t seen = 0;
+    size_t last_nonzero = 0;
+    for (size_t i = 0; i < BUCKETS; i++) {
+        if (buckets_[i].load(std::memory_order_relaxed)) last_nonzero = i;
+    }
+    for (size_t i = 0; i <= last_nonzero; i++) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        // A power-of-two range ends at its last sub-bucket
+        if (i % SUB_BUCKETS != SUB_BUCKETS - 1 && i != last_nonzero) continue;
+        out.emplace_back(bucket_upper(i), seen);
+    }
+    return out;
+}
+
+// ── Registry ──
+
+Metrics& Metrics::instance() {
+    static Metrics inst;
+    return inst;
+}
+
+Metrics::Entry* Metrics::find(const std::string& name) const {
+    for (auto& e : entries_) {
+        if (e->name == name) return e.get();
+    }
+    return nullptr;
+}
+
+Counter& Metrics::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Entry* e = find(name); e && e->counter) return *e->counter;
+    auto e = std::make_unique<Entry>();
+    e->name = name;
+    e->help = help;
+    e->kind = Kind::Counter;
+    e->counter = std::make_unique<Counter>();
+    Counter& ref = *e->counter;
+    entries_.push_back(std::move(e));
+    return ref;
+}
+
+Gauge& Metrics::gauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Entry* e = find(name); e && e->gauge) return *e->gauge;
+    auto e = std::make_unique<Entry>();
+    e->name = name;
+    e->help = help;
+    e->kind = Kind::Gauge;
+    e->gauge = std::make_unique<Gauge>();
+    Gauge& ref = *e->gauge;
+    entries_.push_back(std::move(e));
+    return ref;
+}
+
+Histogram& Metrics::histogram(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Entry* e = find(name); e && e->histogram) return *e->histogram;
+    auto e = std::make_unique<Entry>();
+    e->name = name;
+    e->help = help;
+    e->kind = Kind::Histogram;
+    e->histogram = std::make_unique<Histogram>();
+    Histogram& ref = *e->histogram;
+    entries_.push_back(std::move(e));
+    return ref;
+}
+
+void Metrics::gauge_fn(const std::string& name, const std::string& help,
+                       std::function<double()> fn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (Entry* e = find(name)) {
+        if (e->kind == Kind::GaugeFn) e->fn = std::move(fn);
+        return;
+    }
+    auto e = std::make_unique<Entry>();
+    e->name = name;
+    e->help = help;
+    e->kind = Kind::GaugeFn;
+    e->fn = std::move(fn);
+    entries_.push_back(std::move(e));
+}
+
+double Metrics::value(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* e = find(name);
+    if (!e) return 0.0;
+    switch (e->kind) {
+        case Kind::Counter:   return static_cast<double>(e->counter->value());
+        case Kind::Gauge:     return e->gauge->value();
+        case Kind::GaugeFn:   return e->fn ? e->fn() : 0.0;
+        case Kind::Histogram: return static_cast<double>(e->histogram->count());
+    }
+    return 0.0;
+}
+
+const Histogram* Metrics::find_histogram(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* e = find(name);
+    return e ? e->histogram.get() : nullptr;
+}
+
+std::string Metrics::prometheus_text() const {
+    std::ostringstream out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& e : entries_) {
+        out << "# HELP " << e->name << ' ' << e->help << '\n';
+        switch (e->kind) {
+            case Kind::Counter:
+                out << "# TYPE " << e->name << " counter\n"
+                    << e->name << ' ' << e->counter->value() << '\n';
+                break;
+            case Kind::Gauge:
+                out << "# TYPE " << e->name << " gauge\n"
+                    << e->name << ' ' << e->gauge->value() << '\n';
+                break;
+            case Kind::GaugeFn:
+                out << "# TYPE " << e->name << " gauge\n"
+                    << e->name << ' ' << (e->fn ? e->fn() : 0.0) << '\n';
+                break;
+            case Kind::Histogram: {
+                const Histogram& h = *e->histogram;
+                out << "# TYPE " << e->name << " histogram\n";
+                for (const auto& [le, cum] : h.cumulative_pow2())
+                    out << e->name << "_bucket{le=\"" << le << "\"} " << cum << '\n';
+                out << e->name << "_bucket{le=\"+Inf\"} " << h.count() << '\n'
+                    << e->name << "_sum " << h.sum() << '\n'
+                    << e->name << "_count " << h.count() << '\n';
+                break;
+            }
+        }
+    }
+    return out.str();
+}
+
+bool Metrics::write_textfile(const std::string& path) const {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        if (!f.is_open()) return false;
+        f << prometheus_text();
+        if (!f.good()) return false;
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        LOG_WARN("Metrics textfile rename to {} failed", path);
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace oss
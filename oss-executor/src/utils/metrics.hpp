@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace oss {
+
+// Monotonic count; increments are a single relaxed atomic add.
+class Counter {
+public:
+    void     add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+class Gauge {
+public:
+    void   set(double v) { value_.store(v, std::memory_order_relaxed); }
+    void   add(double d) {
+        double cur = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(cur, cur + d, std::memory_order_relaxed)) {}
+    }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+// Log-linear histogram over unsigned integers (HDR style): each power of two
+// is split into SUB_BUCKETS linear buckets, so any recorded value lands in a
+// bucket within 1/SUB_BUCKETS of it. Recording never locks.
+class Histogram {
+public:
+    static constexpr size_t SUB_BITS    = 3;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BITS;
+    static constexpr size_t BUCKETS     = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    void record(uint64_t value) {
+        buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum() const { return sum_.load(std::memory_order_relaxed); }
+    // Upper bound of the bucket holding the p-th quantile (0..1)
+    uint64_t percentile(double p) const;
+
+    // Cumulative counts at each power-of-two boundary, for exposition
+    std::vector<std::pair<uint64_t, uint64_t>> cumulative_pow2() const;
+
+    static size_t   bucket_index(uint64_t value);
+    static uint64_t bucket_upper(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+};
+
+// Process-wide registry. Registration returns a reference that stays valid
+// for the life of the process; look a metric up once and keep the reference
+// on the hot path. Registering an existing name returns the same metric.
+class Metrics {
+public:
+    static Metrics& instance();
+
+    Counter&   counter(const std::string& name, const std::string& help);
+    Gauge&     gauge(const std::string& name, const std::string& help);
+    Histogram& histogram(const std::string& name, const std::string& help);
+    // Gauge sampled at export time; fn runs on the exporting thread.
+    void       gauge_fn(const std::string& name, const std::string& help,
+                        std::function<double()> fn);
+
+    // Current value of a counter or gauge by name; 0 if unknown
+    double           value(const std::string& name) const;
+    const Histogram* find_histogram(const std::string& name) const;
+
+    // Prometheus text exposition format (0.0.4)
+    std::string prometheus_text() const;
+    // Atomic tmp + rename, for node_exporter's textfile collector
+    bool        write_textfile(const std::string& path) const;
+
+private:
+    Metrics() = default;
+
+    enum class Kind { Counter, Gauge, GaugeFn, Histogram };
+
+    struct Entry {
+        std::string name;
+        std::string help;
+        Kind        kind;
+        std::unique_ptr<Counter>   counter;
+        std::unique_ptr<Gauge>     gauge;
+        std::unique_ptr<Histogram> histogram;
+        std::function<double()>    fn;
+    };
+
+    Entry* find(const std::string& name) const;
+
+    mutable std::mutex                  mutex_;
+    std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+} // namespace oss
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace oss {
+
+// Bounded single-producer/single-consumer ring. try_push is only called from
+// the producer thread and drain only from the consumer thread; neither blocks.
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : slots_(std::make_unique<T[]>(Capacity)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    bool try_push(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ >= Capacity) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ >= Capacity) return false;
+        }
+        slots_[head & (Capacity - 1)] = std::move(value);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Hands every queued item to fn (as T&) in FIFO order; returns the count.
+    template<typename Func>
+    size_t drain(Func&& fn) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i) {
+            T& slot = slots_[i & (Capacity - 1)];
+            fn(slot);
+            slot = T{};
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) ==
+               tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t tail_cache_ = 0;  // producer-side copy of tail_
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+} // namespace oss
@@ -0,0 +1,86 @@
+#include "trace.hpp"
+#include "logger.hpp"
+
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace oss {
+
+static const Trace::Clock::time_point g_process_start = Trace::Clock::now();
+
+static uint32_t current_tid() {
+    return static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xffffffff);
+}
+
+Trace& Trace::instance() {
+    static Trace inst;
+    return inst;
+}
+
+void Trace::enable(const std::string& output_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    output_path_ = output_path;
+    events_.reserve(256);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+int64_t Trace::to_us(Clock::time_point t) const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - g_process_start).count();
+}
+
+void Trace::complete(const char* name, Clock::time_point start, Clock::time_point end) {
+    if (!enabled()) return;
+    Event e{name, 'X', to_us(start), to_us(end) - to_us(start), current_tid()};
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(std::move(e));
+}
+
+void Trace::mark(const char* name) {
+    if (!enabled()) return;
+    Event e{name, 'i', to_us(Clock::now()), 0, current_tid()};
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.push_back(std::move(e));
+}
+
+double Trace::since_start_ms() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - g_process_start).count();
+}
+
+std::string Trace::to_json() const {
+    nlohmann::json events = nlohmann::json::array();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& e : events_) {
+        nlohmann::json j = {
+            {"name", e.name}, {"cat", "startup"}, {"ph", std::string(1, e.phase)},
+            {"ts", e.ts_us}, {"pid", 1}, {"tid", e.tid},
+        };
+        if (e.phase == 'X') j["dur"] = e.dur_us;
+        else j["s"] = "g";
+        events.push_back(std::move(j));
+    }
+    nlohmann::json doc = {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+    if (tti_ms_ > 0) doc["otherData"] = {{"tti_ms", tti_ms_}};
+    return doc.dump();
+}
+
+bool Trace::dump() const {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        path = output_path_;
+    }
+    if (path.empty()) return false;
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_WARN("Cannot write startup trace to {}", path);
+        return false;
+    }
+    out << to_json();
+    LOG_INFO("Startup trace written to {}", path);
+    return true;
+}
+
+} // namespace oss
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace oss {
+
+// Named-span recorder for startup profiling. Recording is off (and a span
+// costs one clock read) until enable() is called; dump() writes Chrome
+// trace JSON that chrome://tracing and Perfetto can open.
+class Trace {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Trace& instance();
+
+    void enable(const std::string& output_path);
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void complete(const char* name, Clock::time_point start, Clock::time_point end);
+    void mark(const char* name);
+
+    // Milliseconds since process start (static initialization)
+    double since_start_ms() const;
+
+    std::string to_json() const;
+    bool dump() const;
+
+    // Time-to-interactive budget; 0 = no check
+    void   set_tti_budget_ms(double ms) { tti_budget_ms_ = ms; }
+    double tti_budget_ms() const { return tti_budget_ms_; }
+    void   set_tti_ms(double ms) { tti_ms_ = ms; }
+    double tti_ms() const { return tti_ms_; }
+
+private:
+    Trace() = default;
+
+    struct Event {
+        std::string name;
+        char        phase;   // 'X' complete, 'i' instant
+        int64_t     ts_us;
+        int64_t     dur_us;
+        uint32_t    tid;
+    };
+
+    int64_t to_us(Clock::time_point t) const;
+
+    std::atomic<bool>  enabled_{false};
+    std::string        output_path_;
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+    double             tti_budget_ms_ = 0;
+    double             tti_ms_ = 0;
+};
+
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name_(name), start_(Trace::Clock::now()) {}
+    ~TraceSpan() {
+        auto& t = Trace::instance();
+        if (t.enabled()) t.complete(name_, start_, Trace::Clock::now());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char*              name_;
+    Trace::Clock::time_point start_;
+};
+
+} // namespace oss
+
+#define OSS_TRACE_CAT_(a, b) a##b
+#define OSS_TRACE_CAT(a, b)  OSS_TRACE_CAT_(a, b)
+#define TRACE_SPAN(name) ::oss::TraceSpan OSS_TRACE_CAT(trace_span_, __LINE__)(name)